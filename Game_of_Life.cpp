@@ -7,7 +7,11 @@
  * @date March, 2020
  */
 
+#include <chrono>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <sstream>
 #include <string>
 
 // Uses cxxopts from https://github.com/jarro2783/cxxopts under the MIT license
@@ -15,7 +19,21 @@
 
 #include "grid.h"
 #include "world.h"
+#include "bits.h"
 #include "zoo.h"
+#include "pool.h"
+#include "batch.h"
+#include "sweep.h"
+#include "predecessor.h"
+#include "search.h"
+#include "collision.h"
+#include "metrics.h"
+#include "hashlife.h"
+#include "colour.h"
+#include "margolus.h"
+#include "agar.h"
+#include "snapshot.h"
+#include "archive.h"
 
 int main(int argc, char *argv[]) {
 
@@ -24,11 +42,34 @@ int main(int argc, char *argv[]) {
 
     // Declare the valid command line arguments and their types and default values.
     options.add_options()
-            ("f,file", "Load an ascii file from the provided path.",  cxxopts::value<std::string>())
+            ("f,file", "Load an ascii file, or a .pbm or .pgm image, from the provided path.",  cxxopts::value<std::string>())
             ("o,output", "Save an ascii file to the provided path.",  cxxopts::value<std::string>())
             ("s,steps","The number of steps to simulate the world.", cxxopts::value<int>()->default_value("10"))
             ("e,every","Print world to the console every N steps. 0 disables printing.", cxxopts::value<int>()->default_value("0"))
             ("t,toroidal", "Simulate the Game of Life on a torus.", cxxopts::value<bool>()->default_value("false"))
+            ("r,rule", "The B/S rule to simulate, e.g. B36/S23.", cxxopts::value<std::string>()->default_value("B3/S23"))
+            ("circuit", "Print the circuit of bitwise operations the rule compiles to, and exit.", cxxopts::value<bool>()->default_value("false"))
+            ("j,jit", "Compile a step kernel specialised to the rule, if a compiler is available.", cxxopts::value<bool>()->default_value("false"))
+            ("b,batch", "Run every job in a manifest of 'input output steps [bounded|toroidal]' lines.", cxxopts::value<std::string>())
+            ("threads", "The number of worker threads. 0 uses one per core.", cxxopts::value<int>()->default_value("0"))
+            ("sweep", "Classify the outcome of the loaded grid under every rule in the provided file, for at most --steps steps.", cxxopts::value<std::string>())
+            ("predecessor", "Search for a grid that steps into the loaded grid, saving it to --output if found.", cxxopts::value<bool>()->default_value("false"))
+            ("margin", "The number of extra cells on every side of a predecessor.", cxxopts::value<int>()->default_value("0"))
+            ("search", "Search for every still life or oscillator that fits in a WxH box, e.g. 4x4. Oscillator boxes are limited to 36 cells and 18 for the width times the period.", cxxopts::value<std::string>())
+            ("period", "The period of the oscillators to search for, at most 4. 1 searches for still lifes.", cxxopts::value<int>()->default_value("1"))
+            ("collisions", "Catalogue the outcomes of two glider collisions within --lanes lanes, for at most --steps steps after each collision.", cxxopts::value<bool>()->default_value("false"))
+            ("lanes", "The largest offset of the second glider from the first glider's path.", cxxopts::value<int>()->default_value("4"))
+            ("report", "Write the batch report, sweep table, or collision catalogue to the provided path instead of the console.", cxxopts::value<std::string>())
+            ("hashlife", "Simulate an unbounded plane with HashLife, printing the region of the loaded grid.", cxxopts::value<bool>()->default_value("false"))
+            ("cache", "Load HashLife results from the provided cache file if it is for the same rule, and save them back after simulating.", cxxopts::value<std::string>())
+            ("memory", "The most memory in MB the HashLife node table may use. 0 is unlimited.", cxxopts::value<int>()->default_value("0"))
+            ("colours", "Simulate a coloured variant, 2 colours for Immigration or 4 for QuadLife, colouring the loaded grid at random.", cxxopts::value<int>()->default_value("0"))
+            ("blocks", "Simulate a Margolus block rule instead, critters, bbm, tron, or 16 comma separated block states.", cxxopts::value<std::string>())
+            ("agar", "Simulate the loaded grid written over an agar, the plane tiled with the ascii tile from the provided path.", cxxopts::value<std::string>())
+            ("snapshot", "Write a binary snapshot of the world to PREFIX.STEP.bgol every --snapshot-every steps, bypassing the page cache.", cxxopts::value<std::string>())
+            ("snapshot-every", "The number of steps between snapshots.", cxxopts::value<int>()->default_value("100"))
+            ("archive", "Store the world as snapshot genSTEP of the tile archive in DIR every --snapshot-every steps, deduplicating the tiles shared between them.", cxxopts::value<std::string>())
+            ("metrics", "Serve Prometheus metrics on http://127.0.0.1:PORT/metrics while simulating or running a batch, counting the population every 64 steps. 0 disables.", cxxopts::value<int>()->default_value("0"))
             ("h,help", "Print usage.");
 
     // Actually parse the command line arguments
@@ -44,32 +85,399 @@ int main(int argc, char *argv[]) {
     const int  steps    = result["steps"].as<int>();
     const int  every    = result["every"].as<int>();
     const bool toroidal = result["toroidal"].as<bool>();
+    const bool jit      = result["jit"].as<bool>();
+
+    // Parse the rule to simulate
+    Rule rule;
+    try {
+        rule = Rule::parse(result["rule"].as<std::string>());
+    }
+    catch (const std::exception &ex) {
+        std::cerr << ex.what() << std::endl;
+        std::exit(-1);
+    }
+
+    // Print the compiled rule instead of simulating
+    if (result["circuit"].as<bool>()) {
+        std::cout << Bits::to_string(Bits::compile(rule));
+        return 0;
+    }
+
+    const int  threads  = result["threads"].as<int>();
+    const int  port     = result["metrics"].as<int>();
+
+    // Serve metrics from a thread of its own if a port was given, the simulation only stores to atomics
+    Metrics metrics;
+    std::unique_ptr<MetricsServer> server;
+    if (port > 0) {
+        try {
+            server.reset(new MetricsServer(metrics, port));
+        }
+        catch (const std::exception &ex) {
+            std::cerr << ex.what() << std::endl;
+            std::exit(-1);
+        }
+    }
+
+    // Run a whole manifest of jobs in parallel instead of a single simulation
+    if (result.count("batch")) {
+        try {
+            std::vector<Batch::Job> jobs = Batch::load_manifest(result["batch"].as<std::string>());
+            ThreadPool pool(threads);
+            metrics.watch(&pool);
+            if (jit && Jit::load_kernel(rule) == nullptr) {
+                std::cerr << "Could not compile a specialised kernel, using the generic step." << std::endl;
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            std::vector<Batch::Result> results = Batch::run(jobs, pool, rule, jit);
+            metrics.watch(nullptr);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            if (result.count("report")) {
+                std::ofstream report(result["report"].as<std::string>());
+                if (!report) {
+                    throw std::runtime_error("Unable to open the report file.");
+                }
+                Batch::write_report(report, results, seconds);
+            } else {
+                Batch::write_report(std::cout, results, seconds);
+            }
+            std::cout << "Ran " << results.size() << " jobs on " << pool.get_size() << " threads at "
+                      << (seconds > 0 ? results.size() / seconds : 0.0) << " jobs/second" << std::endl;
+        }
+        catch (const std::exception &ex) {
+            std::cerr << ex.what() << std::endl;
+            std::exit(-1);
+        }
+        return 0;
+    }
+
+    // Enumerate the still lifes or oscillators that fit in a box instead of a simulation
+    if (result.count("search")) {
+        try {
+            int width = 0, height = 0;
+            char separator = 0;
+            std::istringstream box(result["search"].as<std::string>());
+            if (!(box >> width >> separator >> height) || separator != 'x') {
+                throw std::runtime_error("The search box must be given as WxH, e.g. 4x4.");
+            }
+            const int period = result["period"].as<int>();
+            ThreadPool pool(threads);
+
+            auto start = std::chrono::steady_clock::now();
+            std::vector<Search::Found> found = Search::oscillators(width, height, period, pool, rule);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            for (const Search::Found &pattern : found) {
+                std::cout << pattern.pattern << std::endl;
+            }
+            std::cout << "Found " << found.size() << " patterns of period " << period << " on " << pool.get_size()
+                      << " threads in " << seconds << " seconds" << std::endl;
+        }
+        catch (const std::exception &ex) {
+            std::cerr << ex.what() << std::endl;
+            std::exit(-1);
+        }
+        return 0;
+    }
+
+    // Catalogue glider collisions instead of a simulation
+    if (result["collisions"].as<bool>()) {
+        try {
+            ThreadPool pool(threads);
+
+            auto start = std::chrono::steady_clock::now();
+            std::vector<Collision::Entry> entries = Collision::enumerate(pool, result["lanes"].as<int>(), steps, rule);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            if (result.count("report")) {
+                std::ofstream report(result["report"].as<std::string>());
+                if (!report) {
+                    throw std::runtime_error("Unable to open the report file.");
+                }
+                Collision::write_catalogue(report, entries);
+            } else {
+                Collision::write_catalogue(std::cout, entries);
+            }
+            std::cout << "Catalogued " << entries.size() << " outcomes on " << pool.get_size() << " threads in "
+                      << seconds << " seconds" << std::endl;
+        }
+        catch (const std::exception &ex) {
+            std::cerr << ex.what() << std::endl;
+            std::exit(-1);
+        }
+        return 0;
+    }
 
     // Start with an empty grid
     Grid grid;
 
-    // Attempt to read in and parse the input file as an ascii .gol file if a path was given
+    // Attempt to read in and parse the input file if a path was given, as an image if it is a .pbm or .pgm
+    // file and otherwise as an ascii .gol file
     if (result.count("file")) {
         try {
-            grid = Zoo::load_ascii(result["file"].as<std::string>());
+            const std::string path = result["file"].as<std::string>();
+            const std::string extension = path.size() > 4 ? path.substr(path.size() - 4) : "";
+            if (extension == ".pbm") {
+                grid = Zoo::load_pbm(path);
+            } else if (extension == ".pgm") {
+                grid = Zoo::load_pgm(path);
+            } else {
+                grid = Zoo::load_ascii(path);
+            }
+        }
+        catch (const std::exception &ex) {
+            std::cerr << ex.what() << std::endl;
+            std::exit(-1);
+        }
+    }
+
+    // Run the loaded grid under many rules instead of a single simulation
+    if (result.count("sweep")) {
+        try {
+            std::vector<Rule> rules = Sweep::load_rules(result["sweep"].as<std::string>());
+            ThreadPool pool(threads);
+
+            auto start = std::chrono::steady_clock::now();
+            std::vector<Sweep::Result> results = Sweep::run(grid, rules, pool, steps, toroidal);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            if (result.count("report")) {
+                std::ofstream report(result["report"].as<std::string>());
+                if (!report) {
+                    throw std::runtime_error("Unable to open the report file.");
+                }
+                Sweep::write_table(report, results);
+            } else {
+                Sweep::write_table(std::cout, results);
+            }
+            std::cout << "Swept " << results.size() << " rules on " << pool.get_size() << " threads in "
+                      << seconds << " seconds" << std::endl;
         }
         catch (const std::exception &ex) {
             std::cerr << ex.what() << std::endl;
             std::exit(-1);
         }
+        return 0;
+    }
+
+    // Search for a predecessor of the loaded grid instead of simulating it
+    if (result["predecessor"].as<bool>()) {
+        try {
+            ThreadPool pool(threads);
+            Predecessor::Result search = Predecessor::search(grid, pool, result["margin"].as<int>(), rule);
+
+            std::cout << "Searched " << search.nodes << " nodes on " << pool.get_size() << " threads" << std::endl;
+            if (!search.found) {
+                std::cout << "No predecessor exists within the bounds." << std::endl;
+                return 1;
+            }
+            std::cout << "Predecessor..." << std::endl << search.predecessor << std::endl;
+            if (result.count("output")) {
+                Zoo::save_ascii(result["output"].as<std::string>(), search.predecessor);
+            }
+        }
+        catch (const std::exception &ex) {
+            std::cerr << ex.what() << std::endl;
+            std::exit(-1);
+        }
+        return 0;
+    }
+
+    // Jump ahead on an unbounded plane with HashLife instead of stepping a bounded world
+    if (result["hashlife"].as<bool>()) {
+        const int memory = result["memory"].as<int>();
+        if (memory < 0) {
+            std::cerr << "The memory limit must be at least 0." << std::endl;
+            std::exit(-1);
+        }
+        try {
+            HashLife life(rule);
+            life.set_memory_limit((std::size_t) memory << 20);
+            if (result.count("cache") && !life.load_cache(result["cache"].as<std::string>())) {
+                std::cerr << "No cache for " << rule.to_string() << ", starting cold." << std::endl;
+            }
+            life.set_state(grid);
+            ThreadPool pool(threads);
+
+            auto start = std::chrono::steady_clock::now();
+            life.advance(steps, pool);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            Grid region = life.get_region(0, 0, grid.get_width(), grid.get_height());
+            std::cout << "Generation " << life.get_generation() << " | Alive " << life.get_alive_cells()
+                      << " | Nodes " << life.get_nodes() << " | Seconds " << seconds << std::endl;
+            HashLife::Statistics statistics = life.get_statistics();
+            std::cout << "Memory " << statistics.bytes << " bytes | Cache hits " << statistics.hits
+                      << " | Cache misses " << statistics.misses << " | Collections " << statistics.collections
+                      << " | Collected " << statistics.collected << " | GC seconds " << statistics.gc_seconds << std::endl
+                      << region << std::endl;
+            if (result.count("output")) {
+                Zoo::save_ascii(result["output"].as<std::string>(), region);
+            }
+            if (result.count("cache")) {
+                life.save_cache(result["cache"].as<std::string>());
+            }
+        }
+        catch (const std::exception &ex) {
+            std::cerr << ex.what() << std::endl;
+            std::exit(-1);
+        }
+        return 0;
+    }
+
+    // Simulate the loaded grid as a perturbation of a periodic background, only storing where they differ
+    if (result.count("agar")) {
+        try {
+            AgarWorld agar(Zoo::load_ascii(result["agar"].as<std::string>()), rule);
+            agar.merge(grid, 0, 0);
+            auto start = std::chrono::steady_clock::now();
+            agar.advance(steps);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            Grid region = agar.get_region(0, 0, grid.get_width(), grid.get_height());
+            std::cout << "Generation " << agar.get_generation() << " | Period " << agar.get_period()
+                      << " | Chunks " << agar.get_chunks() << " | Deviations " << agar.get_deviations()
+                      << " | Seconds " << seconds << std::endl << region << std::endl;
+            if (result.count("output")) {
+                Zoo::save_ascii(result["output"].as<std::string>(), region);
+            }
+        }
+        catch (const std::exception &ex) {
+            std::cerr << ex.what() << std::endl;
+            std::exit(-1);
+        }
+        return 0;
+    }
+
+    // Simulate a block cellular automaton, stepping alternating partitions of 2x2 blocks
+    if (result.count("blocks")) {
+        try {
+            BlockWorld blocks(grid, BlockRule::parse(result["blocks"].as<std::string>()));
+            std::cout << "Initial state..." << std::endl << blocks.get_state() << std::endl;
+            for (int step = 0; step < steps; step++) {
+                blocks.step(toroidal);
+                if ((every > 0) && (step % every == 0)) {
+                    std::cout << "Step " << (step + 1) << " of " << steps << std::endl
+                              << blocks.get_state() << std::endl;
+                }
+            }
+            std::cout << "Final state..." << std::endl << "Alive " << blocks.get_alive_cells() << std::endl
+                      << blocks.get_state() << std::endl;
+            if (result.count("output")) {
+                Zoo::save_ascii(result["output"].as<std::string>(), blocks.get_state());
+            }
+        }
+        catch (const std::exception &ex) {
+            std::cerr << ex.what() << std::endl;
+            std::exit(-1);
+        }
+        return 0;
+    }
+
+    // Simulate a coloured variant, alive cells move as in a world and births take their parents' colour
+    const int colours = result["colours"].as<int>();
+    if (colours > 0) {
+        try {
+            ColourWorld coloured(grid, colours, 0, rule);
+            std::cout << "Initial state..." << std::endl << coloured << std::endl;
+            for (int step = 0; step < steps; step++) {
+                coloured.step(toroidal);
+                if ((every > 0) && (step % every == 0)) {
+                    std::cout << "Step " << (step + 1) << " of " << steps << std::endl
+                              << coloured << std::endl;
+                }
+            }
+            std::cout << "Final state..." << std::endl << "Alive " << coloured.get_alive_cells();
+            for (int colour = 1; colour <= colours; colour++) {
+                std::cout << " | Colour " << colour << " " << coloured.get_population(colour);
+            }
+            std::cout << std::endl << coloured << std::endl;
+        }
+        catch (const std::exception &ex) {
+            std::cerr << ex.what() << std::endl;
+            std::exit(-1);
+        }
+        return 0;
     }
 
     // Construct a world from the parsed grid
     World world(grid);
+    world.set_rule(rule, jit);
+
+    if (jit && !world.is_specialised()) {
+        std::cerr << "Could not compile a specialised kernel, using the generic step." << std::endl;
+    }
 
     // Print the initial state of the grid
     std::cout << "Initial state..." << std::endl
               << "Alive " << world.get_alive_cells() << " | Dead " << world.get_dead_cells()  << std::endl
               << world.get_state() << std::endl;
 
+    // Write snapshots with a writer of their own, so the buffers and thread are reused from one to the next
+    std::unique_ptr<SnapshotWriter> snapshots;
+    const int snapshot_every = result["snapshot-every"].as<int>();
+    if (result.count("snapshot")) {
+        if (snapshot_every < 1) {
+            std::cerr << "The number of steps between snapshots must be at least 1." << std::endl;
+            std::exit(-1);
+        }
+        snapshots.reset(new SnapshotWriter());
+    }
+
+    // Store snapshots in a tile archive, so the tiles unchanged from one snapshot to the next are stored once
+    std::unique_ptr<TileArchive> archive;
+    if (result.count("archive")) {
+        if (snapshot_every < 1) {
+            std::cerr << "The number of steps between snapshots must be at least 1." << std::endl;
+            std::exit(-1);
+        }
+        try {
+            archive.reset(new TileArchive(result["archive"].as<std::string>()));
+        }
+        catch (const std::exception &ex) {
+            std::cerr << ex.what() << std::endl;
+            std::exit(-1);
+        }
+    }
+
     // Perform the requested number of update steps
     for (int step = 0; step < steps; step++) {
+        auto start = std::chrono::steady_clock::now();
         world.step(toroidal);
+        if (server) {
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            // Counting the population scans every cell, so only count it every 64 steps and on the last
+            if (step % 64 == 0 || step + 1 == steps) {
+                metrics.record_step(seconds, step + 1, world.get_alive_cells());
+            } else {
+                metrics.record_step(seconds, step + 1);
+            }
+        }
+
+        // Write a snapshot every N steps
+        if (snapshots && (step + 1) % snapshot_every == 0) {
+            try {
+                snapshots->write(result["snapshot"].as<std::string>() + "." + std::to_string(step + 1) + ".bgol",
+                                 world.get_view());
+            }
+            catch (const std::exception &ex) {
+                std::cerr << ex.what() << std::endl;
+                std::exit(-1);
+            }
+        }
+
+        // Archive a snapshot every N steps
+        if (archive && (step + 1) % snapshot_every == 0) {
+            try {
+                archive->put("gen" + std::to_string(step + 1), world.get_view());
+            }
+            catch (const std::exception &ex) {
+                std::cerr << ex.what() << std::endl;
+                std::exit(-1);
+            }
+        }
 
         // Print the state of the grid every N steps
         if ((every > 0) && (step % every == 0)) {
@@ -0,0 +1,334 @@
+/**
+ * Implements a class representing a Game of Life on an unbounded periodic background, an agar, storing only
+ * the regions that differ from it.
+ *      - An agar is a pattern that fills the plane by repeating a small tile, and is periodic in time.
+ *          - https://www.conwaylife.com/wiki/Agar
+ *          - The phases of the tile are found when the world is made, by stepping the tile on a torus of its
+ *            own size until it returns to where it started, which is exactly how it evolves tiled over the plane.
+ *
+ *      - The plane is cut into chunks of 64x64 cells, one word per row, keyed by their chunk coordinates.
+ *          - Only chunks that differ from the background at the current generation are stored, so memory
+ *            scales with the perturbed region and not the plane.
+ *          - The background word of any row of any chunk in any phase is precomputed from the tile, indexed
+ *            by the phase, the row modulo the tile height, and the first column modulo the tile width.
+ *
+ *      - Each step visits the stored chunks and the chunks around them, since a perturbation can spread one
+ *        cell per step into a neighbouring chunk.
+ *          - A chunk is stepped bit-parallel with the circuit compiled from the rule, reading its halo from
+ *            the neighbouring chunks, or from background words made on demand if they are not stored.
+ *          - A stepped chunk that matches the next phase of the background is dropped, so work also scales
+ *            with the perturbed region.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#include "agar.h"
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include <stdexcept>
+#include <unordered_set>
+#include "world.h"
+
+namespace {
+
+/**
+ * floor_div(a, b) and floor_mod(a, b)
+ *
+ * Private helpers to divide rounding down and take the remainder of that, for negative coordinates.
+ */
+long long floor_div(long long a, long long b) {
+	return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+long long floor_mod(long long a, long long b) {
+	return ((a % b) + b) % b;
+}
+
+/**
+ * same_cells(a, b)
+ *
+ * Private helper to check if two views of the same size hold the same cells.
+ */
+bool same_cells(GridView a, GridView b) {
+	for (int y = 0; y < a.get_height(); y++) {
+		for (int x = 0; x < a.get_width(); x++) {
+			if (a(x, y) != b(x, y)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+}
+
+/**
+ * AgarWorld::AgarWorld(tile, rule)
+ *
+ * Construct a plane filled with a periodic tile.
+ *
+ * @example
+ *
+ *      // Zebra stripes, alternating rows of alive and dead cells, are a still agar
+ *      Grid stripes(1, 2);
+ *      stripes(0, 0) = Cell::ALIVE;
+ *      AgarWorld world(stripes);
+ *
+ *      // Perturb it with a glider
+ *      world.merge(Zoo::glider(), 100, 100);
+ *
+ * @param tile
+ *      The tile repeated over the plane, from the origin.
+ *
+ * @param rule
+ *      Optional parameter. The rule to simulate. Defaults to B3/S23.
+ *
+ * @throws
+ *      Throws std::runtime_error if the tile is empty, or does not return to itself within MAX_PERIOD steps.
+ */
+AgarWorld::AgarWorld(GridView tile, const Rule &rule) :
+		rule(rule), circuit(Bits::compile(rule)), tile_width(tile.get_width()), tile_height(tile.get_height()) {
+	if (tile_width == 0 || tile_height == 0) {
+		throw std::runtime_error("An agar tile cannot be empty.");
+	}
+	World world{Grid(tile)};
+	world.set_rule(rule);
+	std::vector<Grid> phases(1, Grid(tile));
+	while (true) {
+		world.step(true);
+		if (same_cells(world.get_view(), phases[0])) {
+			break;
+		}
+		if ((int) phases.size() == MAX_PERIOD) {
+			throw std::runtime_error("The tile is not a periodic agar under " + rule.to_string() + ".");
+		}
+		phases.push_back(world.get_state());
+	}
+	period = phases.size();
+	background.resize((std::size_t) period * tile_height * tile_width);
+	for (int phase = 0; phase < period; phase++) {
+		for (int y = 0; y < tile_height; y++) {
+			for (int x = 0; x < tile_width; x++) {
+				Word word = 0;
+				for (int bit = 0; bit < CHUNK; bit++) {
+					word |= (Word) (phases[phase]((x + bit) % tile_width, y) == Cell::ALIVE) << bit;
+				}
+				background[((std::size_t) phase * tile_height + y) * tile_width + x] = word;
+			}
+		}
+	}
+}
+
+/**
+ * AgarWorld::key(cx, cy)
+ *
+ * Private helper to pack the coordinates of a chunk into a key.
+ */
+AgarWorld::Key AgarWorld::key(long long cx, long long cy) {
+	return (Key) (std::uint32_t) cx << 32 | (std::uint32_t) cy;
+}
+
+/**
+ * AgarWorld::background_word(cx, y, phase)
+ *
+ * Private method to make the background word of row y of the chunks in column cx.
+ */
+Word AgarWorld::background_word(long long cx, long long y, int phase) const {
+	return background[((std::size_t) phase * tile_height + floor_mod(y, tile_height)) * tile_width
+			+ floor_mod(cx * CHUNK, tile_width)];
+}
+
+/**
+ * AgarWorld::is_background(chunk, cx, cy, phase)
+ *
+ * Private method to check if a chunk matches the background.
+ */
+bool AgarWorld::is_background(const Chunk &chunk, long long cx, long long cy, int phase) const {
+	for (int r = 0; r < CHUNK; r++) {
+		if (chunk.rows[r] != background_word(cx, cy * CHUNK + r, phase)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * AgarWorld::chunk_at(cx, cy)
+ *
+ * Private method to get a stored chunk, storing a copy of the background if it is not stored yet.
+ */
+AgarWorld::Chunk& AgarWorld::chunk_at(long long cx, long long cy) {
+	auto found = chunks.find(key(cx, cy));
+	if (found != chunks.end()) {
+		return found->second;
+	}
+	Chunk &chunk = chunks[key(cx, cy)];
+	for (int r = 0; r < CHUNK; r++) {
+		chunk.rows[r] = background_word(cx, cy * CHUNK + r, generation % period);
+	}
+	return chunk;
+}
+
+/**
+ * AgarWorld::get_period()
+ *
+ * Gets the period of the background.
+ */
+int AgarWorld::get_period() const {
+	return period;
+}
+
+/**
+ * AgarWorld::get_rule()
+ *
+ * Gets the rule being simulated.
+ */
+const Rule& AgarWorld::get_rule() const {
+	return rule;
+}
+
+/**
+ * AgarWorld::get_generation()
+ *
+ * Gets the number of steps taken.
+ */
+unsigned long long AgarWorld::get_generation() const {
+	return generation;
+}
+
+/**
+ * AgarWorld::get_chunks()
+ *
+ * Gets the number of 64x64 chunks stored, those that differ from the background.
+ */
+std::size_t AgarWorld::get_chunks() const {
+	return chunks.size();
+}
+
+/**
+ * AgarWorld::get_deviations()
+ *
+ * Gets the number of cells that differ from the background.
+ */
+long long AgarWorld::get_deviations() const {
+	long long count = 0;
+	for (const std::pair<const Key, Chunk> &entry : chunks) {
+		const long long cx = (std::int32_t) (entry.first >> 32), cy = (std::int32_t) entry.first;
+		for (int r = 0; r < CHUNK; r++) {
+			count += __builtin_popcountll(
+					entry.second.rows[r] ^ background_word(cx, cy * CHUNK + r, generation % period));
+		}
+	}
+	return count;
+}
+
+/**
+ * AgarWorld::get(x, y)
+ *
+ * Gets a cell of the plane.
+ */
+Cell AgarWorld::get(long long x, long long y) const {
+	const long long cx = floor_div(x, CHUNK), cy = floor_div(y, CHUNK);
+	auto found = chunks.find(key(cx, cy));
+	const Word word = found != chunks.end() ?
+			found->second.rows[floor_mod(y, CHUNK)] : background_word(cx, y, generation % period);
+	return ((word >> floor_mod(x, CHUNK)) & 1) ? Cell::ALIVE : Cell::DEAD;
+}
+
+/**
+ * AgarWorld::set(x, y, cell)
+ *
+ * Sets a cell of the plane, perturbing the background.
+ */
+void AgarWorld::set(long long x, long long y, Cell cell) {
+	Word &word = chunk_at(floor_div(x, CHUNK), floor_div(y, CHUNK)).rows[floor_mod(y, CHUNK)];
+	const Word bit = 1ull << floor_mod(x, CHUNK);
+	word = cell == Cell::ALIVE ? word | bit : word & ~bit;
+}
+
+/**
+ * AgarWorld::merge(pattern, x, y)
+ *
+ * Write every cell of a pattern over the plane, alive and dead, with its top left corner at x, y.
+ */
+void AgarWorld::merge(GridView pattern, long long x, long long y) {
+	for (int j = 0; j < pattern.get_height(); j++) {
+		for (int i = 0; i < pattern.get_width(); i++) {
+			set(x + i, y + j, pattern(i, j));
+		}
+	}
+}
+
+/**
+ * AgarWorld::get_region(x, y, width, height)
+ *
+ * Get a rectangle of the plane as a grid, background and all.
+ */
+Grid AgarWorld::get_region(long long x, long long y, int width, int height) const {
+	Grid region(width, height);
+	for (int j = 0; j < height; j++) {
+		for (int i = 0; i < width; i++) {
+			region(i, j) = get(x + i, y + j);
+		}
+	}
+	return region;
+}
+
+/**
+ * AgarWorld::step()
+ *
+ * Take one step, visiting only the stored chunks and their neighbours.
+ */
+void AgarWorld::step() {
+	const int phase = generation % period, next_phase = (generation + 1) % period;
+	std::unordered_set<Key> visit;
+	for (const std::pair<const Key, Chunk> &entry : chunks) {
+		const long long cx = (std::int32_t) (entry.first >> 32), cy = (std::int32_t) entry.first;
+		for (int dy = -1; dy <= 1; dy++) {
+			for (int dx = -1; dx <= 1; dx++) {
+				visit.insert(key(cx + dx, cy + dy));
+			}
+		}
+	}
+	std::unordered_map<Key, Chunk> next_chunks;
+	for (Key visiting : visit) {
+		const long long cx = (std::int32_t) (visiting >> 32), cy = (std::int32_t) visiting;
+		const Chunk *around[3][3];
+		for (int dy = -1; dy <= 1; dy++) {
+			for (int dx = -1; dx <= 1; dx++) {
+				auto found = chunks.find(key(cx + dx, cy + dy));
+				around[dy + 1][dx + 1] = found != chunks.end() ? &found->second : nullptr;
+			}
+		}
+		//Read a word of row r, from -1 to 64, of this chunk or the chunk to its west or east.
+		auto word = [&](int dx, int r) {
+			const int dy = r < 0 ? -1 : r >= CHUNK ? 1 : 0;
+			const Chunk *chunk = around[dy + 1][dx + 1];
+			return chunk != nullptr ? chunk->rows[r - dy * CHUNK] : background_word(cx + dx, cy * CHUNK + r, phase);
+		};
+		Chunk next;
+		for (int r = 0; r < CHUNK; r++) {
+			const Word up = word(0, r - 1), row = word(0, r), down = word(0, r + 1);
+			const Bits::Sum sum = Bits::neighbour_sum(up << 1 | word(-1, r - 1) >> 63, up,
+					up >> 1 | word(1, r - 1) << 63, row << 1 | word(-1, r) >> 63, row >> 1 | word(1, r) << 63,
+					down << 1 | word(-1, r + 1) >> 63, down, down >> 1 | word(1, r + 1) << 63);
+			next.rows[r] = Bits::evaluate(circuit, row, sum);
+		}
+		if (!is_background(next, cx, cy, next_phase)) {
+			next_chunks[visiting] = next;
+		}
+	}
+	chunks.swap(next_chunks);
+	generation++;
+}
+
+/**
+ * AgarWorld::advance(steps)
+ *
+ * Advance multiple steps.
+ */
+void AgarWorld::advance(int steps) {
+	for (int i = 0; i < steps; i++) {
+		step();
+	}
+}
@@ -0,0 +1,64 @@
+/**
+ * Declares a class representing a Game of Life on an unbounded periodic background, an agar, storing only
+ * the regions that differ from it.
+ * Rich documentation for the api and behaviour the AgarWorld class can be found in agar.cpp.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the class.
+// #include ...
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "grid.h"
+#include "rule.h"
+#include "bits.h"
+
+/**
+ * Declare the structure of the AgarWorld class for simulating perturbations of a periodic agar.
+ *
+ * The plane is cut into chunks of 64x64 cells. Chunks that match the background are not stored, their
+ * words are made from the phases of the tile whenever they are read.
+ */
+class AgarWorld {
+public:
+	static const int CHUNK = 64;
+	//The longest period of a tile that is searched for.
+	static const int MAX_PERIOD = 4096;
+private:
+	/**
+	 * A Chunk is 64 rows of 64 cells, one word per row.
+	 */
+	struct Chunk {
+		Word rows[CHUNK];
+	};
+	typedef std::uint64_t Key;
+
+	Rule rule;
+	Bits::Circuit circuit;
+	int tile_width { }, tile_height { }, period { };
+	//The background word of 64 cells from column x in row y, indexed by phase, y mod height, and x mod width.
+	std::vector<Word> background;
+	std::unordered_map<Key, Chunk> chunks;
+	unsigned long long generation { };
+	static Key key(long long cx, long long cy);
+	Word background_word(long long cx, long long y, int phase) const;
+	bool is_background(const Chunk &chunk, long long cx, long long cy, int phase) const;
+	Chunk& chunk_at(long long cx, long long cy);
+public:
+	explicit AgarWorld(GridView tile, const Rule &rule = Rule());
+	int get_period() const;
+	const Rule& get_rule() const;
+	unsigned long long get_generation() const;
+	std::size_t get_chunks() const;
+	long long get_deviations() const;
+	Cell get(long long x, long long y) const;
+	void set(long long x, long long y, Cell cell);
+	void merge(GridView pattern, long long x, long long y);
+	Grid get_region(long long x, long long y, int width, int height) const;
+	void step();
+	void advance(int steps);
+};
@@ -0,0 +1,541 @@
+/**
+ * Implements a TileArchive class for storing many snapshots of grids as references to tiles in a shared,
+ * content-addressed, deduplicated store.
+ *      - An archive is a directory holding:
+ *          - tiles.dat, the store, every distinct tile as 64 little endian words, one per row, in slot order
+ *            from slot 1. Slot 0 is the empty tile, by far the most common, and is never stored.
+ *          - tiles.idx, the magic string "GOLTILE1", the number of slots stored, then the hash of each slot's
+ *            tile and the number of references to it from snapshots.
+ *          - NAME.snap for each snapshot, the magic string "GOLSNAP1", the width and height of the grid,
+ *            then the slot of each of its tiles in row major order.
+ *
+ *      - Storing a snapshot only writes the tiles that are not in the store already, so a new generation of a
+ *        run, or a run sharing empty space and debris with another, costs little more than its novel tiles.
+ *          - Tiles are looked up by a 64 bit hash of their cells, and compared cell for cell with the tile
+ *            stored, so colliding hashes can never merge different tiles.
+ *          - Replacing or removing a snapshot releases its references, and slots no longer referenced are
+ *            reused by later tiles.
+ *          - Compacting the archive moves every referenced tile down over the free slots, rewrites the
+ *            snapshots to match, and truncates the store. It is not atomic, so nothing else should be using
+ *            the archive while it runs.
+ *
+ *      - Snapshots and the index are written to a temporary file and renamed over the old one, so a failed
+ *        write leaves the previous version in place.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#include "archive.h"
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const int TileArchive::TILE;
+
+namespace {
+
+const char INDEX_MAGIC[8] = { 'G', 'O', 'L', 'T', 'I', 'L', 'E', '1' };
+const char SNAPSHOT_MAGIC[8] = { 'G', 'O', 'L', 'S', 'N', 'A', 'P', '1' };
+const std::string SNAPSHOT_SUFFIX = ".snap";
+
+/**
+ * check_name(name)
+ *
+ * Private helper to check a snapshot name is safe to use as a file name.
+ *
+ * @throws
+ *      Throws std::runtime_error if the name is empty, starts with a '.', or holds anything but letters,
+ *      digits, '.', '_' and '-'.
+ */
+void check_name(const std::string &name) {
+	bool valid = !name.empty() && name[0] != '.';
+	for (char c : name) {
+		valid = valid && (std::isalnum((unsigned char) c) || c == '.' || c == '_' || c == '-');
+	}
+	if (!valid) {
+		throw std::runtime_error("Snapshot names may only hold letters, digits, '.', '_' and '-', \"" + name
+				+ "\" is not valid.");
+	}
+}
+
+/**
+ * tiles_of(cells)
+ *
+ * Private helper to count the tiles across or down a grid of a number of cells.
+ */
+int tiles_of(int cells) {
+	return (cells + TileArchive::TILE - 1) / TileArchive::TILE;
+}
+
+}
+
+/**
+ * TileArchive::TileArchive(directory)
+ *
+ * Open the archive in a directory, creating the directory and an empty archive if there is none.
+ *
+ * @example
+ *
+ *      // Archive a snapshot of a run every 100 generations
+ *      TileArchive archive("runs/archive");
+ *      for (int step = 1; step <= 1000; step++) {
+ *          world.step();
+ *          if (step % 100 == 0) {
+ *              archive.put("run1." + std::to_string(step), world.get_view());
+ *          }
+ *      }
+ *
+ *      // Read one back
+ *      Grid grid = archive.get("run1.500");
+ *
+ * @param directory
+ *      The directory holding the archive.
+ *
+ * @throws
+ *      Throws std::runtime_error if the directory cannot be created or the archive in it is malformed.
+ */
+TileArchive::TileArchive(const std::string &directory) :
+		directory(directory), slots(1, Slot { 0, 0, 0 }) {
+	if (mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+		throw std::runtime_error("Unable to create the archive directory " + directory + ".");
+	}
+	std::ifstream index(path("tiles.idx"), std::ios::binary);
+	if (index) {
+		char magic[sizeof(INDEX_MAGIC)];
+		std::uint64_t count = 0;
+		index.read(magic, sizeof(magic));
+		index.read((char*) &count, sizeof(count));
+		if (!index || std::memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0) {
+			throw std::runtime_error("The file " + path("tiles.idx") + " is not a tile archive index.");
+		}
+		slots.resize(count + 1);
+		index.read((char*) (slots.data() + 1), count * sizeof(Slot));
+		if ((std::uint64_t) index.gcount() != count * sizeof(Slot)) {
+			throw std::runtime_error("The tile archive index " + path("tiles.idx") + " is truncated.");
+		}
+	}
+	for (std::uint32_t slot = 1; slot < slots.size(); slot++) {
+		if (slots[slot].references > 0) {
+			by_hash.insert(std::make_pair(slots[slot].hash, slot));
+		} else {
+			free_slots.push_back(slot);
+		}
+	}
+	open_store();
+	store.seekg(0, std::ios::end);
+	if ((std::uint64_t) store.tellg() < (slots.size() - 1) * sizeof(Tile)) {
+		throw std::runtime_error("The tile store " + path("tiles.dat") + " is truncated.");
+	}
+}
+
+/**
+ * TileArchive::path(file)
+ *
+ * Private helper to get the path of a file of the archive.
+ */
+std::string TileArchive::path(const std::string &file) const {
+	return directory + "/" + file;
+}
+
+/**
+ * TileArchive::open_store()
+ *
+ * Private method to open the tile store for reading and writing, creating it if there is none.
+ */
+void TileArchive::open_store() {
+	store.close();
+	store.clear();
+	store.open(path("tiles.dat"), std::ios::in | std::ios::out | std::ios::binary);
+	if (!store) {
+		std::ofstream(path("tiles.dat"), std::ios::binary);
+		store.clear();
+		store.open(path("tiles.dat"), std::ios::in | std::ios::out | std::ios::binary);
+	}
+	if (!store) {
+		throw std::runtime_error("Unable to open the tile store " + path("tiles.dat") + ".");
+	}
+}
+
+/**
+ * TileArchive::hash(tile)
+ *
+ * Private helper to hash the cells of a tile.
+ */
+std::uint64_t TileArchive::hash(const Tile &tile) {
+	std::uint64_t h = 0x9E3779B97F4A7C15ull;
+	for (Word row : tile.rows) {
+		h = (h ^ row) * 0xFF51AFD7ED558CCDull;
+		h ^= h >> 32;
+	}
+	return h;
+}
+
+/**
+ * TileArchive::read_tile(slot)
+ *
+ * Private method to read a tile from the store.
+ *
+ * @throws
+ *      Throws std::runtime_error if the tile cannot be read.
+ */
+TileArchive::Tile TileArchive::read_tile(std::uint32_t slot) const {
+	Tile tile;
+	store.seekg((std::uint64_t) (slot - 1) * sizeof(Tile));
+	if (!store.read((char*) &tile, sizeof(tile))) {
+		throw std::runtime_error("Unable to read tile " + std::to_string(slot) + " of the tile store.");
+	}
+	return tile;
+}
+
+/**
+ * TileArchive::write_tile(slot, tile)
+ *
+ * Private method to write a tile to the store.
+ *
+ * @throws
+ *      Throws std::runtime_error if the tile cannot be written.
+ */
+void TileArchive::write_tile(std::uint32_t slot, const Tile &tile) {
+	store.seekp((std::uint64_t) (slot - 1) * sizeof(Tile));
+	if (!store.write((const char*) &tile, sizeof(tile))) {
+		throw std::runtime_error("Unable to write tile " + std::to_string(slot) + " of the tile store.");
+	}
+}
+
+/**
+ * TileArchive::read_snapshot(name, width, height)
+ *
+ * Private method to read the tile slots of a snapshot, and its width and height.
+ *
+ * @throws
+ *      Throws std::runtime_error if there is no such snapshot, or it is malformed.
+ */
+std::vector<std::uint32_t> TileArchive::read_snapshot(const std::string &name, int &width, int &height) const {
+	check_name(name);
+	std::ifstream file(path(name + SNAPSHOT_SUFFIX), std::ios::binary);
+	if (!file) {
+		throw std::runtime_error("The archive holds no snapshot named " + name + ".");
+	}
+	char magic[sizeof(SNAPSHOT_MAGIC)];
+	std::int32_t size[2] = { };
+	file.read(magic, sizeof(magic));
+	file.read((char*) size, sizeof(size));
+	if (!file || std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0 || size[0] < 0 || size[1] < 0) {
+		throw std::runtime_error("The snapshot " + name + " is malformed.");
+	}
+	width = size[0];
+	height = size[1];
+	std::vector<std::uint32_t> ids((std::size_t) tiles_of(width) * tiles_of(height));
+	file.read((char*) ids.data(), ids.size() * sizeof(std::uint32_t));
+	if ((std::size_t) file.gcount() != ids.size() * sizeof(std::uint32_t)) {
+		throw std::runtime_error("The snapshot " + name + " is truncated.");
+	}
+	for (std::uint32_t id : ids) {
+		if (id >= slots.size()) {
+			throw std::runtime_error("The snapshot " + name + " refers to a tile that is not in the store.");
+		}
+	}
+	return ids;
+}
+
+/**
+ * TileArchive::write_snapshot(name, width, height, ids)
+ *
+ * Private method to write the tile slots of a snapshot, replacing any snapshot of the same name.
+ *
+ * @throws
+ *      Throws std::runtime_error if the snapshot cannot be written.
+ */
+void TileArchive::write_snapshot(const std::string &name, int width, int height,
+		const std::vector<std::uint32_t> &ids) const {
+	const std::string target = path(name + SNAPSHOT_SUFFIX), temporary = target + ".tmp";
+	{
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+		const std::int32_t size[2] = { width, height };
+		file.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+		file.write((const char*) size, sizeof(size));
+		file.write((const char*) ids.data(), ids.size() * sizeof(std::uint32_t));
+		if (!file.flush()) {
+			throw std::runtime_error("Unable to write the snapshot " + temporary + ".");
+		}
+	}
+	if (std::rename(temporary.c_str(), target.c_str()) != 0) {
+		std::remove(temporary.c_str());
+		throw std::runtime_error("Unable to replace the snapshot " + target + ".");
+	}
+}
+
+/**
+ * TileArchive::write_index()
+ *
+ * Private method to write the hash and references of every slot.
+ *
+ * @throws
+ *      Throws std::runtime_error if the index cannot be written.
+ */
+void TileArchive::write_index() const {
+	const std::string target = path("tiles.idx"), temporary = target + ".tmp";
+	{
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+		const std::uint64_t count = slots.size() - 1;
+		file.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+		file.write((const char*) &count, sizeof(count));
+		file.write((const char*) (slots.data() + 1), count * sizeof(Slot));
+		if (!file.flush()) {
+			throw std::runtime_error("Unable to write the tile archive index " + temporary + ".");
+		}
+	}
+	if (std::rename(temporary.c_str(), target.c_str()) != 0) {
+		std::remove(temporary.c_str());
+		throw std::runtime_error("Unable to replace the tile archive index " + target + ".");
+	}
+}
+
+/**
+ * TileArchive::release(ids)
+ *
+ * Private method to drop a reference to each tile of a snapshot, freeing the slots no longer referenced.
+ */
+void TileArchive::release(const std::vector<std::uint32_t> &ids) {
+	for (std::uint32_t id : ids) {
+		if (id == 0 || --slots[id].references > 0) {
+			continue;
+		}
+		auto range = by_hash.equal_range(slots[id].hash);
+		for (auto it = range.first; it != range.second; ++it) {
+			if (it->second == id) {
+				by_hash.erase(it);
+				break;
+			}
+		}
+		free_slots.push_back(id);
+	}
+}
+
+/**
+ * TileArchive::put(name, grid)
+ *
+ * Store a snapshot of a grid, replacing any snapshot of the same name.
+ *
+ * @param name
+ *      The name of the snapshot, letters, digits, '.', '_' and '-' only, not starting with a '.'.
+ *
+ * @param grid
+ *      The grid, or a view onto a region of a grid, to store.
+ *
+ * @return
+ *      Returns the number of tiles that were not already in the store and had to be written.
+ *
+ * @throws
+ *      Throws std::runtime_error if the name is not valid or the archive cannot be written.
+ */
+std::size_t TileArchive::put(const std::string &name, GridView grid) {
+	check_name(name);
+	const int width = grid.get_width(), height = grid.get_height(), across = tiles_of(width);
+	std::vector<std::uint32_t> ids((std::size_t) across * tiles_of(height), 0);
+	std::size_t novel = 0;
+	for (std::size_t t = 0; t < ids.size(); t++) {
+		const int x = (t % across) * TILE, y = (t / across) * TILE;
+		Tile tile = { };
+		Word any = 0;
+		for (int r = 0; r < TILE && y + r < height; r++) {
+			tile.rows[r] = Bits::pack_row(grid.row(y + r) + x, std::min(TILE, width - x));
+			any |= tile.rows[r];
+		}
+		if (any == 0) {
+			continue;
+		}
+		const std::uint64_t h = hash(tile);
+		std::uint32_t id = 0;
+		auto range = by_hash.equal_range(h);
+		for (auto it = range.first; it != range.second && id == 0; ++it) {
+			const Tile stored = read_tile(it->second);
+			if (std::memcmp(&stored, &tile, sizeof(Tile)) == 0) {
+				id = it->second;
+			}
+		}
+		if (id == 0) {
+			if (!free_slots.empty()) {
+				id = free_slots.back();
+				free_slots.pop_back();
+			} else {
+				id = slots.size();
+				slots.push_back(Slot { });
+			}
+			slots[id] = Slot { h, 0, 0 };
+			write_tile(id, tile);
+			by_hash.insert(std::make_pair(h, id));
+			novel++;
+		}
+		slots[id].references++;
+		ids[t] = id;
+	}
+	if (!store.flush()) {
+		throw std::runtime_error("Unable to write the tile store " + path("tiles.dat") + ".");
+	}
+	//Release the tiles of the snapshot replaced only once its replacement holds its own references.
+	std::vector<std::uint32_t> replaced;
+	if (contains(name)) {
+		int old_width, old_height;
+		replaced = read_snapshot(name, old_width, old_height);
+	}
+	write_snapshot(name, width, height, ids);
+	release(replaced);
+	write_index();
+	return novel;
+}
+
+/**
+ * TileArchive::get(name)
+ *
+ * Read a snapshot back as a grid.
+ *
+ * @throws
+ *      Throws std::runtime_error if there is no such snapshot, or it or the store is malformed.
+ */
+Grid TileArchive::get(const std::string &name) const {
+	int width, height;
+	const std::vector<std::uint32_t> ids = read_snapshot(name, width, height);
+	Grid grid(width, height);
+	const int across = tiles_of(width);
+	for (std::size_t t = 0; t < ids.size(); t++) {
+		if (ids[t] == 0) {
+			continue;
+		}
+		const int x = (t % across) * TILE, y = (t / across) * TILE;
+		const Tile tile = read_tile(ids[t]);
+		for (int r = 0; r < TILE && y + r < height; r++) {
+			Bits::unpack_row(tile.rows[r], grid.data() + (std::size_t) (y + r) * width + x, std::min(TILE, width - x));
+		}
+	}
+	return grid;
+}
+
+/**
+ * TileArchive::contains(name)
+ *
+ * Checks if the archive holds a snapshot of a name.
+ */
+bool TileArchive::contains(const std::string &name) const {
+	check_name(name);
+	return std::ifstream(path(name + SNAPSHOT_SUFFIX)).good();
+}
+
+/**
+ * TileArchive::list()
+ *
+ * Gets the names of every snapshot in the archive, in sorted order.
+ */
+std::vector<std::string> TileArchive::list() const {
+	std::vector<std::string> names;
+	DIR *listing = opendir(directory.c_str());
+	if (listing == nullptr) {
+		throw std::runtime_error("Unable to list the archive directory " + directory + ".");
+	}
+	while (dirent *entry = readdir(listing)) {
+		const std::string file = entry->d_name;
+		if (file.size() > SNAPSHOT_SUFFIX.size() && file[0] != '.'
+				&& file.compare(file.size() - SNAPSHOT_SUFFIX.size(), SNAPSHOT_SUFFIX.size(), SNAPSHOT_SUFFIX) == 0) {
+			names.push_back(file.substr(0, file.size() - SNAPSHOT_SUFFIX.size()));
+		}
+	}
+	closedir(listing);
+	std::sort(names.begin(), names.end());
+	return names;
+}
+
+/**
+ * TileArchive::remove(name)
+ *
+ * Remove a snapshot, releasing its tiles.
+ *
+ * @throws
+ *      Throws std::runtime_error if there is no such snapshot or it cannot be removed.
+ */
+void TileArchive::remove(const std::string &name) {
+	int width, height;
+	const std::vector<std::uint32_t> ids = read_snapshot(name, width, height);
+	if (std::remove(path(name + SNAPSHOT_SUFFIX).c_str()) != 0) {
+		throw std::runtime_error("Unable to remove the snapshot " + name + ".");
+	}
+	release(ids);
+	write_index();
+}
+
+/**
+ * TileArchive::compact()
+ *
+ * Reclaim the slots no longer referenced, moving every referenced tile down over them in order, rewriting
+ * the snapshots to match, and truncating the store.
+ *
+ * @return
+ *      Returns the number of slots reclaimed.
+ *
+ * @throws
+ *      Throws std::runtime_error if the archive cannot be rewritten.
+ */
+std::size_t TileArchive::compact() {
+	if (free_slots.empty()) {
+		return 0;
+	}
+	std::vector<std::uint32_t> remap(slots.size(), 0);
+	std::vector<Slot> kept(1, Slot { 0, 0, 0 });
+	for (std::uint32_t slot = 1; slot < slots.size(); slot++) {
+		if (slots[slot].references == 0) {
+			continue;
+		}
+		remap[slot] = kept.size();
+		if (remap[slot] != slot) {
+			write_tile(remap[slot], read_tile(slot));
+		}
+		kept.push_back(slots[slot]);
+	}
+	if (!store.flush()) {
+		throw std::runtime_error("Unable to write the tile store " + path("tiles.dat") + ".");
+	}
+	for (const std::string &name : list()) {
+		int width, height;
+		std::vector<std::uint32_t> ids = read_snapshot(name, width, height);
+		for (std::uint32_t &id : ids) {
+			id = remap[id];
+		}
+		write_snapshot(name, width, height, ids);
+	}
+	const std::size_t reclaimed = slots.size() - kept.size();
+	slots.swap(kept);
+	free_slots.clear();
+	by_hash.clear();
+	for (std::uint32_t slot = 1; slot < slots.size(); slot++) {
+		by_hash.insert(std::make_pair(slots[slot].hash, slot));
+	}
+	store.close();
+	if (truncate(path("tiles.dat").c_str(), (slots.size() - 1) * sizeof(Tile)) != 0) {
+		throw std::runtime_error("Unable to truncate the tile store " + path("tiles.dat") + ".");
+	}
+	open_store();
+	write_index();
+	return reclaimed;
+}
+
+/**
+ * TileArchive::get_statistics()
+ *
+ * Gets the number of snapshots, distinct tiles, and free slots, and the size of the store.
+ */
+TileArchive::Statistics TileArchive::get_statistics() const {
+	Statistics statistics;
+	statistics.snapshots = list().size();
+	statistics.free = free_slots.size();
+	statistics.tiles = slots.size() - 1 - free_slots.size();
+	statistics.bytes = (unsigned long long) (slots.size() - 1) * sizeof(Tile);
+	return statistics;
+}
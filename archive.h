@@ -0,0 +1,82 @@
+/**
+ * Declares a TileArchive class for storing many snapshots of grids as references to tiles in a shared,
+ * content-addressed, deduplicated store.
+ * Rich documentation for the api and behaviour the TileArchive class can be found in archive.cpp.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the class.
+// #include ...
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "grid.h"
+#include "bits.h"
+
+/**
+ * Declare the structure of the TileArchive class for keeping thousands of related snapshots cheaply.
+ *
+ * A snapshot is the id of each of its 64x64 tiles, and each distinct tile is stored once however many
+ * snapshots use it. Tiles are found by the hash of their cells and counted by the snapshots referencing them.
+ */
+class TileArchive {
+public:
+	static const int TILE = 64;
+
+	/**
+	 * Statistics about the archive.
+	 *      - tiles is the number of distinct tiles referenced, free the number of slots of the store no longer
+	 *        referenced, which are reused by later snapshots or reclaimed by TileArchive::compact.
+	 *      - bytes is the size of the tile store on disc.
+	 */
+	struct Statistics {
+		std::size_t snapshots { }, tiles { }, free { };
+		unsigned long long bytes { };
+	};
+private:
+	/**
+	 * A Tile is 64 rows of 64 cells, one word per row.
+	 */
+	struct Tile {
+		Word rows[TILE];
+	};
+	/**
+	 * A Slot of the store holds a tile, its hash, and the number of references to it from snapshots.
+	 */
+	struct Slot {
+		std::uint64_t hash;
+		std::uint32_t references;
+		std::uint32_t reserved;
+	};
+
+	std::string directory;
+	mutable std::fstream store;
+	//Slot 0 is the empty tile, which is never stored.
+	std::vector<Slot> slots;
+	std::unordered_multimap<std::uint64_t, std::uint32_t> by_hash;
+	std::vector<std::uint32_t> free_slots;
+
+	std::string path(const std::string &file) const;
+	void open_store();
+	static std::uint64_t hash(const Tile &tile);
+	Tile read_tile(std::uint32_t slot) const;
+	void write_tile(std::uint32_t slot, const Tile &tile);
+	std::vector<std::uint32_t> read_snapshot(const std::string &name, int &width, int &height) const;
+	void write_snapshot(const std::string &name, int width, int height, const std::vector<std::uint32_t> &ids) const;
+	void write_index() const;
+	void release(const std::vector<std::uint32_t> &ids);
+public:
+	explicit TileArchive(const std::string &directory);
+	std::size_t put(const std::string &name, GridView grid);
+	Grid get(const std::string &name) const;
+	bool contains(const std::string &name) const;
+	std::vector<std::string> list() const;
+	void remove(const std::string &name);
+	std::size_t compact();
+	Statistics get_statistics() const;
+};
@@ -0,0 +1,196 @@
+/**
+ * Implements a Batch namespace with methods for simulating many patterns in one process.
+ *      - A manifest lists one job per line, as whitespace separated fields:
+ *              input output steps [topology]
+ *          - topology is either "bounded" (the default) or "toroidal".
+ *          - Blank lines and lines starting with # are ignored.
+ *          - Paths ending in .bgol are read and written in the binary format, anything else as ascii.
+ *
+ *      - Jobs are run in parallel on a ThreadPool.
+ *          - Each worker keeps one World that is recycled with World::set_state for every job it runs,
+ *            so grid buffers are only allocated when a pattern is bigger than any seen before.
+ *          - A failing job is recorded in its Result and does not stop the rest of the batch.
+ *
+ *      - The report lists every job and ends with a summary including the throughput in jobs/second.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#include "batch.h"
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include "zoo.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+/**
+ * is_binary(path)
+ *
+ * Private helper to check if a path names a binary .bgol file.
+ */
+bool is_binary(const std::string &path) {
+	const std::string extension = ".bgol";
+	return path.size() >= extension.size()
+			&& path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+}
+
+/**
+ * Batch::load_manifest(path)
+ *
+ * Load and parse a manifest of jobs.
+ *
+ * @example
+ *
+ *      // A manifest file might contain
+ *      //      # input              output         steps  topology
+ *      //      patterns/glider.gol  out/glider.gol 100    toroidal
+ *      //      patterns/acorn.bgol  out/acorn.bgol 5206
+ *      std::vector<Batch::Job> jobs = Batch::load_manifest("jobs.txt");
+ *
+ * @param path
+ *      The std::string path to the manifest file.
+ *
+ * @return
+ *      Returns the jobs in the order they appear in the manifest.
+ *
+ * @throws
+ *      Throws std::runtime_error if the file cannot be opened or a line is malformed.
+ */
+std::vector<Batch::Job> Batch::load_manifest(std::string path) {
+	std::ifstream inFile(path);
+	if (!inFile) {
+		throw std::runtime_error("Unable to open the specified file.");
+	}
+	std::vector<Job> jobs;
+	std::string line;
+	for (int number = 1; std::getline(inFile, line); number++) {
+		std::istringstream fields(line);
+		Job job;
+		std::string topology = "bounded", extra;
+		if (!(fields >> job.input) || job.input[0] == '#') {
+			continue;
+		}
+		if (!(fields >> job.output >> job.steps) || job.steps < 0) {
+			throw std::runtime_error("Manifest line " + std::to_string(number) + " is not: input output steps [topology].");
+		}
+		fields >> topology;
+		if ((topology != "bounded" && topology != "toroidal") || (fields >> extra)) {
+			throw std::runtime_error("Manifest line " + std::to_string(number) + " has an unknown topology.");
+		}
+		job.toroidal = topology == "toroidal";
+		jobs.push_back(job);
+	}
+	return jobs;
+}
+
+/**
+ * Batch::run(jobs, pool, rule)
+ *
+ * Run every job on the workers of a pool and wait for them to finish.
+ *
+ * @example
+ *
+ *      ThreadPool pool;
+ *      std::vector<Batch::Result> results = Batch::run(Batch::load_manifest("jobs.txt"), pool);
+ *
+ * @param jobs
+ *      The jobs to run.
+ *
+ * @param pool
+ *      The pool to run the jobs on.
+ *
+ * @param rule
+ *      Optional parameter. The rule to simulate. Defaults to B3/S23.
+ *
+ * @param specialise
+ *      Optional parameter. If true every worker steps with a kernel specialised to the rule, as with
+ *      World::set_rule, if one can be compiled. Defaults to false.
+ *
+ * @return
+ *      Returns one result per job, in the same order as the jobs.
+ */
+std::vector<Batch::Result> Batch::run(const std::vector<Job> &jobs, ThreadPool &pool, const Rule &rule,
+		bool specialise) {
+	std::vector<Result> results(jobs.size());
+	//Each worker loads into its own grid and steps its own world, so neither is reallocated between jobs.
+	std::vector<World> worlds(pool.get_size());
+	std::vector<Grid> inputs(pool.get_size());
+	for (World &world : worlds) {
+		world.set_rule(rule, specialise);
+	}
+	for (std::size_t i = 0; i < jobs.size(); i++) {
+		pool.submit([&, i](int worker) {
+			const Job &job = jobs[i];
+			Result &result = results[i];
+			World &world = worlds[worker];
+			Grid &input = inputs[worker];
+			result.job = job;
+			auto start = std::chrono::steady_clock::now();
+			try {
+				if (is_binary(job.input)) {
+					Zoo::load_binary(job.input, input);
+				} else {
+					Zoo::load_ascii(job.input, input);
+				}
+				world.set_state(input);
+				world.advance(job.steps, job.toroidal);
+				if (is_binary(job.output)) {
+					Zoo::save_binary(job.output, world.get_view());
+				} else {
+					Zoo::save_ascii(job.output, world.get_view());
+				}
+				result.alive = world.get_alive_cells();
+				result.ok = true;
+			} catch (const std::exception &ex) {
+				result.error = ex.what();
+			}
+			result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		});
+	}
+	pool.wait();
+	return results;
+}
+
+/**
+ * Batch::write_report(stream, results, seconds)
+ *
+ * Write a tab separated line per job followed by a summary of the batch.
+ *
+ * @example
+ *
+ *      // Print the report to the console
+ *      Batch::write_report(std::cout, results, 1.5);
+ *
+ * @param stream
+ *      An ascii mode output stream such as std::cout.
+ *
+ * @param results
+ *      The results returned by Batch::run.
+ *
+ * @param seconds
+ *      The wall clock time the whole batch took, used for the throughput.
+ */
+void Batch::write_report(std::ostream &stream, const std::vector<Result> &results, double seconds) {
+	//The times are written fixed point, leave the stream formatted as it was given.
+	const std::ios_base::fmtflags flags = stream.flags();
+	const std::streamsize precision = stream.precision();
+	int failed = 0;
+	stream << "input\toutput\tsteps\ttopology\tstatus\talive\tms\n";
+	for (const Result &result : results) {
+		stream << result.job.input << '\t' << result.job.output << '\t' << result.job.steps << '\t'
+				<< (result.job.toroidal ? "toroidal" : "bounded") << '\t' << (result.ok ? "ok" : result.error) << '\t'
+				<< result.alive << '\t' << std::fixed << std::setprecision(3) << result.seconds * 1000.0 << '\n';
+		failed += !result.ok;
+	}
+	stream << "Jobs " << results.size() << " | Failed " << failed << " | Seconds " << std::setprecision(3) << seconds
+			<< " | Jobs/second " << std::setprecision(1) << (seconds > 0 ? results.size() / seconds : 0.0) << std::endl;
+	stream.flags(flags);
+	stream.precision(precision);
+}
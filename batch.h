@@ -0,0 +1,47 @@
+/**
+ * Declares a Batch namespace with methods for simulating many patterns in one process.
+ * Rich documentation for the api and behaviour the Batch namespace can be found in batch.cpp.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the namespace.
+// #include ...
+#include <iostream>
+#include <string>
+#include <vector>
+#include "world.h"
+#include "pool.h"
+
+/**
+ * Declare the interface of the Batch namespace for running a manifest of simulation jobs across cores.
+ */
+namespace Batch {
+
+/**
+ * A Job loads a pattern from input, advances it a number of steps, and saves it to output.
+ */
+struct Job {
+	std::string input, output;
+	int steps { };
+	bool toroidal { };
+};
+
+/**
+ * A Result records the outcome of a Job, with the error message if it failed.
+ */
+struct Result {
+	Job job;
+	bool ok { };
+	std::string error;
+	int alive { };
+	double seconds { };
+};
+
+std::vector<Job> load_manifest(std::string path);
+std::vector<Result> run(const std::vector<Job> &jobs, ThreadPool &pool, const Rule &rule = Rule(), bool specialise = false);
+void write_report(std::ostream &stream, const std::vector<Result> &results, double seconds);
+}
+;
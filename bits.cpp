@@ -0,0 +1,536 @@
+/**
+ * Implements a Bits namespace with methods for evaluating a Rule on 64 cells at once, packed one cell per bit.
+ *      - Neighbour counts are computed with a tree of bitwise full adders, giving the count of every cell
+ *        in a word as four bit planes without looking at cells one by one.
+ *      - A rule is applied to a Sum by matching the planes against each neighbour count the rule lists.
+ *
+ *      - Any rule can be compiled to a Circuit, a short straight line of bitwise operations on the alive cells
+ *        and the planes of their neighbour sum, which is evaluated by a tiny interpreter.
+ *          - A rule is a boolean function of 5 inputs, so it is held as a 32 bit truth table. Sums of 9 to 15
+ *            never occur and are don't cares.
+ *          - The circuit is synthesised by Shannon expansion, trying every input at every level and keeping
+ *            the smallest expansion, with the cases where a cofactor is constant, equal, or complementary
+ *            reduced to a single AND, OR, or XOR. Sub-functions are memoised, so compiling takes microseconds.
+ *          - Conway's B3/S23 compiles to 3 operations, against 2 matches of 4 planes by Bits::apply.
+ *
+ *      - A Plane packs a whole grid into rows of words, and gives the neighbour sum of any word of it,
+ *        carrying neighbours across words and wrapping them around the edges of a torus.
+ *
+ *      - Rows up to 64 cells wide can be stepped in a single call, which is what searches over small
+ *        patterns enumerate.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#include "bits.h"
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+
+namespace {
+
+typedef Bits::Circuit::Op Op;
+
+//The truth tables of the inputs, bit i of a truth table is the output when input k is bit k of i.
+const std::uint32_t INPUT_TABLES[Bits::Circuit::INPUTS] = { 0xaaaaaaaa, 0xcccccccc, 0xf0f0f0f0, 0xff00ff00,
+		0xffff0000 };
+
+/**
+ * A Fragment is a circuit for a sub-function, registers past the inputs are numbered from the fragment's first op.
+ */
+struct Fragment {
+	std::vector<Op> ops;
+	int output;
+};
+
+typedef std::map<std::pair<std::uint64_t, int>, Fragment> Memo;
+
+/**
+ * append(ops, fragment)
+ *
+ * Private helper to append a fragment to a list of ops, renumbering its registers.
+ *
+ * @return
+ *      Returns the register holding the output of the fragment.
+ */
+int append(std::vector<Op> &ops, const Fragment &fragment) {
+	const int base = ops.size();
+	for (Op op : fragment.ops) {
+		op.a = op.a < Bits::Circuit::INPUTS ? op.a : op.a + base;
+		op.b = op.b < Bits::Circuit::INPUTS ? op.b : op.b + base;
+		ops.push_back(op);
+	}
+	return fragment.output < Bits::Circuit::INPUTS ? fragment.output : fragment.output + base;
+}
+
+/**
+ * combine(code, a, b)
+ *
+ * Private helper to make the fragment computing a op b, where a and b are fragments.
+ */
+Fragment combine(Bits::Circuit::Code code, const Fragment &a, const Fragment &b) {
+	Fragment fragment;
+	Op op;
+	op.code = code;
+	op.a = append(fragment.ops, a);
+	op.b = append(fragment.ops, b);
+	fragment.ops.push_back(op);
+	fragment.output = Bits::Circuit::INPUTS + fragment.ops.size() - 1;
+	return fragment;
+}
+
+/**
+ * input(k)
+ *
+ * Private helper to make the fragment that is input k.
+ */
+Fragment input(int k) {
+	Fragment fragment;
+	fragment.output = k;
+	return fragment;
+}
+
+/**
+ * synthesise(table, care, inputs, memo)
+ *
+ * Private helper to find a small circuit matching a truth table on the bits set in care.
+ *
+ * @param inputs
+ *      The inputs the truth table may still depend on, bit k for input k.
+ */
+Fragment synthesise(std::uint32_t table, std::uint32_t care, int inputs, Memo &memo) {
+	table &= care;
+	const std::pair<std::uint64_t, int> key((std::uint64_t) table << 32 | care, inputs);
+	auto found = memo.find(key);
+	if (found != memo.end()) {
+		return found->second;
+	}
+	Fragment best;
+	if (table == 0 || table == care) {
+		Op op;
+		op.code = table == 0 ? Bits::Circuit::ZERO : Bits::Circuit::ONE;
+		op.a = op.b = 0;
+		best.ops.push_back(op);
+		best.output = Bits::Circuit::INPUTS;
+		return memo[key] = best;
+	}
+	bool searched = false;
+	auto consider = [&](const Fragment &candidate) {
+		if (!searched || candidate.ops.size() < best.ops.size()) {
+			best = candidate;
+			searched = true;
+		}
+	};
+	for (int k = 0; k < Bits::Circuit::INPUTS; k++) {
+		if ((inputs >> k) & 1) {
+			if (((table ^ INPUT_TABLES[k]) & care) == 0) {
+				return memo[key] = input(k);
+			}
+			if (((table ^ ~INPUT_TABLES[k]) & care) == 0) {
+				Fragment fragment = combine(Bits::Circuit::NOT, input(k), input(k));
+				consider(fragment);
+			}
+		}
+	}
+	for (int k = 0; k < Bits::Circuit::INPUTS; k++) {
+		if (!((inputs >> k) & 1)) {
+			continue;
+		}
+		//Split into the cofactors with input k clear and set, each copied over both halves of the table.
+		const std::uint32_t mask = INPUT_TABLES[k];
+		const int shift = 1 << k;
+		std::uint32_t t0 = table & ~mask, c0 = care & ~mask, t1 = table & mask, c1 = care & mask;
+		t0 |= t0 << shift;
+		c0 |= c0 << shift;
+		t1 |= t1 >> shift;
+		c1 |= c1 >> shift;
+		const std::uint32_t both = c0 & c1;
+		const int rest = inputs & ~(1 << k);
+		if (((t0 ^ t1) & both) == 0) {
+			consider(synthesise((t0 & c0) | (t1 & c1), c0 | c1, rest, memo));
+		}
+		if (((t0 ^ ~t1) & both) == 0) {
+			consider(combine(Bits::Circuit::XOR, input(k), synthesise((t0 & c0) | (~t1 & c1), c0 | c1, rest, memo)));
+		}
+		if ((t1 & c1) == 0) {
+			consider(combine(Bits::Circuit::AND_NOT, synthesise(t0, c0, rest, memo), input(k)));
+		}
+		if ((t0 & c0) == 0) {
+			consider(combine(Bits::Circuit::AND, input(k), synthesise(t1, c1, rest, memo)));
+		}
+		if ((~t1 & c1) == 0) {
+			consider(combine(Bits::Circuit::OR, input(k), synthesise(t0, c0, rest, memo)));
+		}
+		if ((~t0 & c0) == 0) {
+			consider(combine(Bits::Circuit::OR_NOT, input(k), synthesise(t1, c1, rest, memo)));
+		}
+		//Otherwise select between the cofactors, f0 ^ (k & (f0 ^ f1)).
+		const Fragment f0 = synthesise(t0, c0, rest, memo), f1 = synthesise(t1, c1, rest, memo);
+		Fragment mux;
+		const int r0 = append(mux.ops, f0), r1 = append(mux.ops, f1);
+		Op op;
+		op.code = Bits::Circuit::XOR;
+		op.a = r0;
+		op.b = r1;
+		mux.ops.push_back(op);
+		op.code = Bits::Circuit::AND;
+		op.a = k;
+		op.b = Bits::Circuit::INPUTS + mux.ops.size() - 1;
+		mux.ops.push_back(op);
+		op.code = Bits::Circuit::XOR;
+		op.a = r0;
+		op.b = Bits::Circuit::INPUTS + mux.ops.size() - 1;
+		mux.ops.push_back(op);
+		mux.output = Bits::Circuit::INPUTS + mux.ops.size() - 1;
+		consider(mux);
+	}
+	return memo[key] = best;
+}
+
+}
+
+/**
+ * Bits::neighbour_sum(up_left, up, up_right, left, right, down_left, down, down_right)
+ *
+ * Add eight neighbour words together bit by bit. Each word must already be shifted so that
+ * bit x holds the neighbour of the cell in column x.
+ *
+ * @return
+ *      Returns the neighbour count of every cell as bit planes, from 0 to 8.
+ */
+Bits::Sum Bits::neighbour_sum(Word up_left, Word up, Word up_right, Word left, Word right, Word down_left, Word down,
+		Word down_right) {
+	//Three full adders and a half adder reduce the eight inputs to three ones and four twos.
+	Word a0 = up_left ^ up ^ up_right, a1 = (up_left & up) | (up_right & (up_left ^ up));
+	Word b0 = left ^ right ^ down_left, b1 = (left & right) | (down_left & (left ^ right));
+	Word c0 = down ^ down_right, c1 = down & down_right;
+	//Add the ones.
+	Word ones = a0 ^ b0 ^ c0, ones_carry = (a0 & b0) | (c0 & (a0 ^ b0));
+	//Add the twos, carrying into fours and eights.
+	Word twos = a1 ^ b1 ^ c1, twos_carry = (a1 & b1) | (c1 & (a1 ^ b1));
+	Word twos_total = twos ^ ones_carry, fours = twos & ones_carry;
+	Sum sum;
+	sum.s0 = ones;
+	sum.s1 = twos_total;
+	sum.s2 = twos_carry ^ fours;
+	sum.s3 = twos_carry & fours;
+	return sum;
+}
+
+/**
+ * Bits::apply(rule, alive, sum)
+ *
+ * Compute the next state of 64 cells from their current state and neighbour counts.
+ *
+ * @param rule
+ *      The rule to apply.
+ *
+ * @param alive
+ *      The current state of the cells.
+ *
+ * @param sum
+ *      The neighbour counts of the cells.
+ *
+ * @return
+ *      Returns the next state of the cells.
+ */
+Word Bits::apply(const Rule &rule, Word alive, const Sum &sum) {
+	Word born = 0, survive = 0;
+	for (int n = 0; n <= 8; n++) {
+		if (!rule.is_born(n) && !rule.survives(n)) {
+			continue;
+		}
+		//Select the cells whose count is exactly n, plane by plane.
+		Word match = ((n & 1) ? sum.s0 : ~sum.s0) & ((n & 2) ? sum.s1 : ~sum.s1) & ((n & 4) ? sum.s2 : ~sum.s2)
+				& ((n & 8) ? sum.s3 : ~sum.s3);
+		if (rule.is_born(n)) {
+			born |= match;
+		}
+		if (rule.survives(n)) {
+			survive |= match;
+		}
+	}
+	return (alive & survive) | (~alive & born);
+}
+
+/**
+ * Bits::width_mask(width)
+ *
+ * Gets a word with the lowest width bits set.
+ */
+Word Bits::width_mask(int width) {
+	return width >= 64 ? ~0ull : (1ull << width) - 1;
+}
+
+/**
+ * Bits::next_row(rule, up, row, down, width)
+ *
+ * Step a single row of up to 64 cells, given the rows above and below it.
+ * Cells beyond the width are treated as dead, like the edges of a non-toroidal World.
+ *
+ * @example
+ *
+ *      // The middle of a vertical blinker stays alive, its neighbours are born
+ *      Word next = Bits::next_row(Rule(), 0b010, 0b010, 0b010, 3);    // 0b111
+ *
+ * @param rule
+ *      The rule to apply.
+ *
+ * @param up
+ *      The row above, 0 for the top row of a grid.
+ *
+ * @param row
+ *      The row to step.
+ *
+ * @param down
+ *      The row below, 0 for the bottom row of a grid.
+ *
+ * @param width
+ *      The number of cells in each row, at most 64.
+ *
+ * @return
+ *      Returns the next state of the row.
+ */
+Word Bits::next_row(const Rule &rule, Word up, Word row, Word down, int width) {
+	const Word mask = width_mask(width);
+	Sum sum = neighbour_sum(up << 1, up, up >> 1, row << 1, row >> 1, down << 1, down, down >> 1);
+	return apply(rule, row, sum) & mask;
+}
+
+/**
+ * Bits::pack_row(cells, width)
+ *
+ * Pack up to 64 cells into a word, cell x into bit x.
+ */
+Word Bits::pack_row(const Cell *cells, int width) {
+	Word row = 0;
+	for (int x = 0; x < width; x++) {
+		row |= (Word) (cells[x] == Cell::ALIVE) << x;
+	}
+	return row;
+}
+
+/**
+ * Bits::unpack_row(row, cells, width)
+ *
+ * Unpack up to 64 cells from a word, bit x into cell x.
+ */
+void Bits::unpack_row(Word row, Cell *cells, int width) {
+	for (int x = 0; x < width; x++) {
+		cells[x] = ((row >> x) & 1) ? Cell::ALIVE : Cell::DEAD;
+	}
+}
+
+/**
+ * Bits::compile(rule)
+ *
+ * Compile a rule to a short circuit of bitwise operations, to evaluate with Bits::evaluate.
+ *
+ * @example
+ *
+ *      // Step 64 cells of an arbitrary rule without matching every neighbour count
+ *      Bits::Circuit circuit = Bits::compile(Rule::parse("B36/S23"));
+ *      Word next = Bits::evaluate(circuit, alive, sum);
+ *
+ * @param rule
+ *      The rule to compile.
+ *
+ * @return
+ *      Returns the compiled circuit.
+ */
+Bits::Circuit Bits::compile(const Rule &rule) {
+	std::uint32_t table = 0, care = 0;
+	for (int i = 0; i < 32; i++) {
+		const int neighbours = i >> 1;
+		if (neighbours > 8) {
+			continue;
+		}
+		care |= 1u << i;
+		if ((i & 1) ? rule.survives(neighbours) : rule.is_born(neighbours)) {
+			table |= 1u << i;
+		}
+	}
+	Memo memo;
+	const Fragment fragment = synthesise(table, care, (1 << Circuit::INPUTS) - 1, memo);
+	if (Circuit::INPUTS + fragment.ops.size() > Circuit::MAX_REGISTERS) {
+		throw std::runtime_error("The circuit for " + rule.to_string() + " has too many operations.");
+	}
+	Circuit circuit;
+	circuit.ops = fragment.ops;
+	circuit.output = fragment.output;
+	return circuit;
+}
+
+/**
+ * Bits::evaluate(circuit, alive, sum)
+ *
+ * Compute the next state of 64 cells by running a compiled circuit, giving the same result as Bits::apply.
+ *
+ * @param circuit
+ *      The circuit compiled from the rule.
+ *
+ * @param alive
+ *      The current state of the cells.
+ *
+ * @param sum
+ *      The neighbour counts of the cells.
+ *
+ * @return
+ *      Returns the next state of the cells.
+ */
+Word Bits::evaluate(const Circuit &circuit, Word alive, const Sum &sum) {
+	Word registers[Circuit::MAX_REGISTERS];
+	registers[0] = alive;
+	registers[1] = sum.s0;
+	registers[2] = sum.s1;
+	registers[3] = sum.s2;
+	registers[4] = sum.s3;
+	Word *out = registers + Circuit::INPUTS;
+	for (const Circuit::Op &op : circuit.ops) {
+		const Word a = registers[op.a], b = registers[op.b];
+		switch (op.code) {
+		case Circuit::ZERO:
+			*out = 0;
+			break;
+		case Circuit::ONE:
+			*out = ~0ull;
+			break;
+		case Circuit::NOT:
+			*out = ~a;
+			break;
+		case Circuit::AND:
+			*out = a & b;
+			break;
+		case Circuit::OR:
+			*out = a | b;
+			break;
+		case Circuit::XOR:
+			*out = a ^ b;
+			break;
+		case Circuit::AND_NOT:
+			*out = a & ~b;
+			break;
+		case Circuit::OR_NOT:
+			*out = ~a | b;
+			break;
+		}
+		out++;
+	}
+	return registers[circuit.output];
+}
+
+/**
+ * Bits::to_string(circuit)
+ *
+ * Gets a circuit as one assignment per line, in C syntax, ending with the assignment of next.
+ *
+ * @example
+ *
+ *      // Print the circuit of Conway's Game of Life
+ *      std::cout << Bits::to_string(Bits::compile(Rule()));
+ */
+std::string Bits::to_string(const Circuit &circuit) {
+	auto name = [](int index) {
+		const char *inputs[Circuit::INPUTS] = { "alive", "s0", "s1", "s2", "s3" };
+		return index < Circuit::INPUTS ? std::string(inputs[index]) : "t" + std::to_string(index - Circuit::INPUTS);
+	};
+	std::string text;
+	for (std::size_t i = 0; i < circuit.ops.size(); i++) {
+		const Circuit::Op &op = circuit.ops[i];
+		const std::string a = name(op.a), b = name(op.b);
+		text += name(Circuit::INPUTS + i) + " = ";
+		switch (op.code) {
+		case Circuit::ZERO:
+			text += "0";
+			break;
+		case Circuit::ONE:
+			text += "~0";
+			break;
+		case Circuit::NOT:
+			text += "~" + a;
+			break;
+		case Circuit::AND:
+			text += a + " & " + b;
+			break;
+		case Circuit::OR:
+			text += a + " | " + b;
+			break;
+		case Circuit::XOR:
+			text += a + " ^ " + b;
+			break;
+		case Circuit::AND_NOT:
+			text += a + " & ~" + b;
+			break;
+		case Circuit::OR_NOT:
+			text += "~" + a + " | " + b;
+			break;
+		}
+		text += ";\n";
+	}
+	return text + "next = " + name(circuit.output) + ";\n";
+}
+
+/**
+ * Bits::Plane::Plane(width, height)
+ *
+ * Construct a plane of dead cells.
+ *
+ * @example
+ *
+ *      // Pack a grid, one row at a time
+ *      Bits::Plane plane(grid.get_width(), grid.get_height());
+ *      for (int y = 0; y < grid.get_height(); y++) {
+ *          for (int k = 0; k < plane.words; k++) {
+ *              plane.row(y)[k] = Bits::pack_row(grid.row(y) + k * 64, std::min(64, grid.get_width() - k * 64));
+ *          }
+ *      }
+ *
+ * @param width
+ *      The width of the plane in cells.
+ *
+ * @param height
+ *      The height of the plane in cells.
+ */
+Bits::Plane::Plane(int width, int height) :
+		width(width), height(height), words((width + 63) / 64), bits((std::size_t) words * (height + 1), 0) {
+}
+
+/**
+ * Bits::Plane::row(y)
+ *
+ * Gets the words of a row, row height is always dead.
+ */
+Word* Bits::Plane::row(int y) {
+	return bits.data() + (std::size_t) y * words;
+}
+const Word* Bits::Plane::row(int y) const {
+	return bits.data() + (std::size_t) y * words;
+}
+
+/**
+ * Bits::Plane::sum(y, k, toroidal)
+ *
+ * Gets the neighbour counts of the 64 cells in word k of row y.
+ *
+ * @param toroidal
+ *      If true then neighbours wrap around the edges of the plane, otherwise cells outside it are dead.
+ */
+Bits::Sum Bits::Plane::sum(int y, int k, bool toroidal) const {
+	const Word *middle = row(y);
+	const Word *up = y > 0 ? middle - words : row(toroidal ? height - 1 : height);
+	const Word *down = y + 1 < height ? middle + words : row(toroidal ? 0 : height);
+	const int last = (width - 1) % 64;
+	//Shift a word so bit x holds the neighbour to the west or east of cell x, carrying across words.
+	auto west = [&](const Word *cells) {
+		const Word carry = k > 0 ? cells[k - 1] >> 63 : toroidal ? (cells[words - 1] >> last) & 1 : 0;
+		return cells[k] << 1 | carry;
+	};
+	auto east = [&](const Word *cells) {
+		const Word carry = k + 1 < words ? cells[k + 1] << 63 : toroidal ? (cells[0] & 1) << last : 0;
+		return cells[k] >> 1 | carry;
+	};
+	return neighbour_sum(west(up), up[k], east(up), west(middle), east(middle), west(down), down[k], east(down));
+}
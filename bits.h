@@ -0,0 +1,80 @@
+/**
+ * Declares a Bits namespace with methods for evaluating a Rule on 64 cells at once, packed one cell per bit.
+ * Rich documentation for the api and behaviour the Bits namespace can be found in bits.cpp.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the namespace.
+// #include ...
+#include <string>
+#include <vector>
+#include "grid.h"
+#include "rule.h"
+
+/**
+ * A Word holds 64 cells packed one per bit, bit x is the cell in column x.
+ */
+typedef unsigned long long Word;
+
+/**
+ * Declare the interface of the Bits namespace for bit-parallel cellular automaton logic.
+ */
+namespace Bits {
+
+/**
+ * A Sum holds the neighbour counts of 64 cells bit-sliced into four planes, s0 being the lowest bit.
+ */
+struct Sum {
+	Word s0 { }, s1 { }, s2 { }, s3 { };
+};
+
+Sum neighbour_sum(Word up_left, Word up, Word up_right, Word left, Word right, Word down_left, Word down,
+		Word down_right);
+Word apply(const Rule &rule, Word alive, const Sum &sum);
+
+/**
+ * A Circuit is a rule compiled to a straight line of bitwise operations over registers.
+ *      - Registers 0 to 4 hold the inputs, the alive cells and the planes s0 to s3 of their neighbour sum.
+ *      - Operation i reads registers a and b and writes register INPUTS + i.
+ *      - The next state of the cells is left in register output, which may be an input if there are no operations.
+ */
+struct Circuit {
+	enum Code : unsigned char {
+		ZERO, ONE, NOT, AND, OR, XOR, AND_NOT, OR_NOT
+	};
+	struct Op {
+		Code code;
+		unsigned char a, b;
+	};
+	static const int INPUTS = 5;
+	static const int MAX_REGISTERS = 128;
+	std::vector<Op> ops;
+	int output { };
+};
+
+/**
+ * A Plane is a grid of cells packed one per bit, each row padded to whole words, with a row of dead cells
+ * after the last row. Bits past the width of a row must be kept clear.
+ */
+struct Plane {
+	int width { }, height { }, words { };
+	std::vector<Word> bits;
+	Plane() = default;
+	Plane(int width, int height);
+	Word* row(int y);
+	const Word* row(int y) const;
+	Sum sum(int y, int k, bool toroidal) const;
+};
+
+Circuit compile(const Rule &rule);
+Word evaluate(const Circuit &circuit, Word alive, const Sum &sum);
+std::string to_string(const Circuit &circuit);
+Word width_mask(int width);
+Word next_row(const Rule &rule, Word up, Word row, Word down, int width);
+Word pack_row(const Cell *cells, int width);
+void unpack_row(Word row, Cell *cells, int width);
+}
+;
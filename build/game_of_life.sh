@@ -1,5 +1,5 @@
 set -x
 cd "${0%/*}"
 rm ../bin/Game_of_Life 2> /dev/null
-g++ --std=c++11 -Wall ../Game_of_Life.cpp ../grid.cpp ../world.cpp ../zoo.cpp -o ../bin/Game_of_Life
+g++ --std=c++11 -Wall ../Game_of_Life.cpp ../grid.cpp ../world.cpp ../rule.cpp ../jit.cpp ../zoo.cpp ../gzip.cpp ../pool.cpp ../batch.cpp ../sweep.cpp ../bits.cpp ../predecessor.cpp ../pattern.cpp ../search.cpp ../collision.cpp ../metrics.cpp ../hashlife.cpp ../colour.cpp ../margolus.cpp ../agar.cpp ../snapshot.cpp ../archive.cpp -o ../bin/Game_of_Life -ldl -pthread
 ../bin/Game_of_Life --help
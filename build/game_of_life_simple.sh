@@ -1,5 +1,5 @@
 set -x
 cd "${0%/*}"
 rm ../bin/Game_of_Life_simple 2> /dev/null
-g++ --std=c++11 -Wall ../Game_of_Life_simple.cpp ../grid.cpp ../world.cpp ../zoo.cpp -o ../bin/Game_of_Life_simple
+g++ --std=c++11 -Wall ../Game_of_Life_simple.cpp ../grid.cpp ../world.cpp ../bits.cpp ../rule.cpp ../jit.cpp ../zoo.cpp ../gzip.cpp -o ../bin/Game_of_Life_simple -ldl
 ../bin/Game_of_Life_simple
@@ -1,5 +1,5 @@
 set -x
 cd "${0%/*}"
 rm ../bin/test_10 2> /dev/null
-g++ --std=c++11 -Wall ../tests/test_10.cpp ../grid.cpp ../world.cpp ../bin/catch.o -o ../bin/test_10
+g++ --std=c++11 -Wall ../tests/test_10.cpp ../grid.cpp ../world.cpp ../bits.cpp ../rule.cpp ../jit.cpp ../bin/catch.o -o ../bin/test_10 -ldl
 ../bin/test_10
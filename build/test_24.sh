@@ -0,0 +1,5 @@
+set -x
+cd "${0%/*}"
+rm ../bin/test_24 2> /dev/null
+g++ --std=c++11 -Wall ../tests/test_24.cpp ../grid.cpp ../zoo.cpp ../gzip.cpp ../bin/catch.o -o ../bin/test_24
+../bin/test_24
@@ -0,0 +1,5 @@
+set -x
+cd "${0%/*}"
+rm ../bin/test_26 2> /dev/null
+g++ --std=c++11 -Wall ../tests/test_26.cpp ../grid.cpp ../world.cpp ../bits.cpp ../rule.cpp ../jit.cpp ../pool.cpp ../sweep.cpp ../bin/catch.o -o ../bin/test_26 -ldl -pthread
+../bin/test_26
@@ -0,0 +1,5 @@
+set -x
+cd "${0%/*}"
+rm ../bin/test_27 2> /dev/null
+g++ --std=c++11 -Wall ../tests/test_27.cpp ../grid.cpp ../world.cpp ../rule.cpp ../jit.cpp ../pool.cpp ../bits.cpp ../predecessor.cpp ../bin/catch.o -o ../bin/test_27 -ldl -pthread
+../bin/test_27
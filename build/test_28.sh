@@ -0,0 +1,5 @@
+set -x
+cd "${0%/*}"
+rm ../bin/test_28 2> /dev/null
+g++ --std=c++11 -Wall ../tests/test_28.cpp ../grid.cpp ../world.cpp ../rule.cpp ../jit.cpp ../zoo.cpp ../gzip.cpp ../pool.cpp ../bits.cpp ../pattern.cpp ../search.cpp ../bin/catch.o -o ../bin/test_28 -ldl -pthread
+../bin/test_28
@@ -0,0 +1,5 @@
+set -x
+cd "${0%/*}"
+rm ../bin/test_31 2> /dev/null
+g++ --std=c++11 -Wall ../tests/test_31.cpp ../grid.cpp ../zoo.cpp ../gzip.cpp ../bin/catch.o -o ../bin/test_31
+../bin/test_31
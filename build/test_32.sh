@@ -0,0 +1,5 @@
+set -x
+cd "${0%/*}"
+rm ../bin/test_32 2> /dev/null
+g++ --std=c++11 -Wall ../tests/test_32.cpp ../pool.cpp ../metrics.cpp ../bin/catch.o -o ../bin/test_32 -pthread
+../bin/test_32
@@ -0,0 +1,5 @@
+set -x
+cd "${0%/*}"
+rm ../bin/test_33 2> /dev/null
+g++ --std=c++11 -Wall ../tests/test_33.cpp ../grid.cpp ../world.cpp ../bits.cpp ../rule.cpp ../jit.cpp ../zoo.cpp ../gzip.cpp ../pool.cpp ../hashlife.cpp ../bin/catch.o -o ../bin/test_33 -ldl -pthread
+../bin/test_33
@@ -0,0 +1,5 @@
+set -x
+cd "${0%/*}"
+rm ../bin/test_34 2> /dev/null
+g++ --std=c++11 -Wall ../tests/test_34.cpp ../grid.cpp ../world.cpp ../bits.cpp ../rule.cpp ../jit.cpp ../zoo.cpp ../gzip.cpp ../colour.cpp ../bin/catch.o -o ../bin/test_34 -ldl
+../bin/test_34
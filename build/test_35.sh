@@ -0,0 +1,5 @@
+set -x
+cd "${0%/*}"
+rm ../bin/test_35 2> /dev/null
+g++ --std=c++11 -Wall ../tests/test_35.cpp ../grid.cpp ../bits.cpp ../rule.cpp ../margolus.cpp ../bin/catch.o -o ../bin/test_35
+../bin/test_35
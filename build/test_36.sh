@@ -0,0 +1,5 @@
+set -x
+cd "${0%/*}"
+rm ../bin/test_36 2> /dev/null
+g++ --std=c++11 -Wall ../tests/test_36.cpp ../grid.cpp ../world.cpp ../bits.cpp ../rule.cpp ../jit.cpp ../agar.cpp ../bin/catch.o -o ../bin/test_36 -ldl
+../bin/test_36
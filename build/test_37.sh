@@ -0,0 +1,5 @@
+set -x
+cd "${0%/*}"
+rm ../bin/test_37 2> /dev/null
+g++ --std=c++11 -Wall ../tests/test_37.cpp ../grid.cpp ../zoo.cpp ../gzip.cpp ../snapshot.cpp ../bin/catch.o -o ../bin/test_37 -pthread
+../bin/test_37
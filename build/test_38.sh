@@ -0,0 +1,5 @@
+set -x
+cd "${0%/*}"
+rm ../bin/test_38 2> /dev/null
+g++ --std=c++11 -Wall ../tests/test_38.cpp ../grid.cpp ../bits.cpp ../rule.cpp ../archive.cpp ../bin/catch.o -o ../bin/test_38
+../bin/test_38
@@ -22,3 +22,19 @@ cd "${0%/*}"
 ../build/test_20.sh
 ../build/test_21.sh
 ../build/test_22.sh
+../build/test_23.sh
+../build/test_24.sh
+../build/test_25.sh
+../build/test_26.sh
+../build/test_27.sh
+../build/test_28.sh
+../build/test_29.sh
+../build/test_30.sh
+../build/test_31.sh
+../build/test_32.sh
+../build/test_33.sh
+../build/test_34.sh
+../build/test_35.sh
+../build/test_36.sh
+../build/test_37.sh
+../build/test_38.sh
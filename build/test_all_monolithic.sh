@@ -6,5 +6,6 @@ g++ --std=c++11 -Wall ../tests/test_1.cpp  ../tests/test_2.cpp  ../tests/test_3.
                       ../tests/test_9.cpp  ../tests/test_10.cpp ../tests/test_11.cpp ../tests/test_12.cpp \
                       ../tests/test_13.cpp ../tests/test_14.cpp ../tests/test_15.cpp ../tests/test_16.cpp \
                       ../tests/test_17.cpp ../tests/test_18.cpp ../tests/test_19.cpp ../tests/test_20.cpp \
-                      ../tests/test_21.cpp ../grid.cpp ../world.cpp ../zoo.cpp ../bin/catch.o -o ../bin/test_all_monolithic
+                      ../tests/test_21.cpp ../tests/test_23.cpp ../tests/test_24.cpp ../tests/test_25.cpp ../tests/test_26.cpp ../tests/test_27.cpp ../tests/test_28.cpp ../tests/test_29.cpp ../tests/test_30.cpp ../tests/test_31.cpp ../tests/test_32.cpp ../tests/test_33.cpp ../tests/test_34.cpp ../tests/test_35.cpp ../tests/test_36.cpp ../tests/test_37.cpp ../tests/test_38.cpp \
+                      ../grid.cpp ../world.cpp ../rule.cpp ../jit.cpp ../zoo.cpp ../gzip.cpp ../pool.cpp ../batch.cpp ../sweep.cpp ../bits.cpp ../predecessor.cpp ../pattern.cpp ../search.cpp ../collision.cpp ../metrics.cpp ../hashlife.cpp ../colour.cpp ../margolus.cpp ../agar.cpp ../snapshot.cpp ../archive.cpp ../bin/catch.o -o ../bin/test_all_monolithic -ldl -pthread
 ../bin/test_all_monolithic
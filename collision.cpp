@@ -0,0 +1,488 @@
+/**
+ * Implements a Collision namespace with methods for cataloguing the outcomes of collisions between two gliders.
+ *      - The first glider is Zoo::glider() heading down and right towards the middle of the board.
+ *      - Setups, glider phases, and glider removal all follow the rule being catalogued, which must have
+ *        Zoo::glider() as a glider, as HighLife does.
+ *      - The second glider is Zoo::glider() rotated by 1, 2, or 3 quarter turns, so it meets the first glider
+ *        side on or head on, heading towards the same point but offset from it by up to lanes cells in x and y,
+ *        and started up to 3 steps earlier so every timing within a glider's period is covered.
+ *
+ *      - Many setups are the same collision translated, rotated, reflected, or started earlier, so each setup is
+ *        simulated until the step before the gliders first interact and the canonical form of that state
+ *        identifies the collision. Setups that never interact are dropped.
+ *      - The rest of each distinct collision is simulated until its outcome is known, as in Sweep::classify.
+ *          - Gliders that reach the edge of the board are removed and counted, rather than crashing into it.
+ *          - If anything else reaches the edge the outcome is UNDECIDED.
+ *      - Collisions with the same outcome, canonical debris, and number of escaping gliders form one entry.
+ *
+ *      - The setups are distributed across the workers of a ThreadPool, each worker recycles the same worlds
+ *        for every setup it runs.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#include "collision.h"
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include "world.h"
+#include "zoo.h"
+#include "pattern.h"
+
+namespace {
+
+//The number of diagonal cells each glider starts from the point they head towards.
+const int APPROACH = 8;
+//The number of cells between the gliders' starting area and the edge, room for the debris to settle in.
+const int ROOM = 40;
+//The width of the border in which gliders are removed.
+const int BAND = 4;
+
+/**
+ * Private helper for the size of the square board used for the given number of lanes.
+ */
+int board_size(int lanes) {
+	return 2 * (APPROACH + lanes + 2 + ROOM);
+}
+
+/**
+ * Private helper to find the direction a glider moves in, one cell in x and y every 4 steps.
+ *
+ * @throws
+ *      Throws std::runtime_error if the glider does not move one cell diagonally every 4 steps in the rule.
+ */
+void heading(const Grid &glider, int &hx, int &hy, const Rule &rule) {
+	Grid board(9);
+	board.merge(glider, 3, 3);
+	World world(board);
+	world.set_rule(rule);
+	world.advance(4);
+	const Grid moved = world.get_state();
+	int x0 = 9, y0 = 9;
+	for (int y = 0; y < 9; y++) {
+		for (int x = 0; x < 9; x++) {
+			if (moved.get(x, y) == Cell::ALIVE) {
+				x0 = std::min(x0, x);
+				y0 = std::min(y0, y);
+			}
+		}
+	}
+	hx = x0 - 3;
+	hy = y0 - 3;
+	if (std::abs(hx) != 1 || std::abs(hy) != 1
+			|| Pattern::canonical_hash(moved.crop(x0, y0, x0 + 3, y0 + 3)) != Pattern::canonical_hash(glider)) {
+		throw std::runtime_error("Collisions need the glider to be a glider in " + rule.to_string() + ".");
+	}
+}
+
+/**
+ * Private helper for the canonical hashes of every phase of a glider in a rule.
+ */
+std::unordered_set<unsigned long long> glider_phases(const Rule &rule) {
+	std::unordered_set<unsigned long long> hashes;
+	Grid board(8);
+	board.merge(Zoo::glider(), 2, 2);
+	World world(board);
+	world.set_rule(rule);
+	for (int phase = 0; phase < 4; phase++) {
+		hashes.insert(Pattern::canonical_hash(world.get_view()));
+		world.step();
+	}
+	return hashes;
+}
+
+/**
+ * Private helper to place each glider of a setup on a board of its own.
+ */
+void place_apart(const Collision::Setup &setup, int lanes, const Rule &rule, Grid &first, Grid &second) {
+	const int size = board_size(lanes), centre = size / 2 - 1;
+	int hx, hy;
+	Grid glider = Zoo::glider().rotate(setup.orientation);
+	heading(glider, hx, hy, rule);
+
+	second = Grid(size);
+	second.merge(glider, centre - APPROACH * hx + setup.dx, centre - APPROACH * hy + setup.dy);
+	World world(second);
+	world.set_rule(rule);
+	world.advance(setup.delay);
+	second = world.get_state();
+
+	first = Grid(size);
+	first.merge(Zoo::glider(), centre - APPROACH, centre - APPROACH);
+}
+
+/**
+ * Private helper to remove the gliders that reached the edge of a world.
+ *
+ * @return
+ *      Returns the number of gliders removed, or -1 if something other than a glider reached the edge.
+ */
+int remove_gliders(World &world, const std::unordered_set<unsigned long long> &phases) {
+	Grid state = world.get_state();
+	const int size = state.get_width();
+	std::vector<char> visited(size * size, 0);
+	std::vector<int> component, stack;
+	int removed = 0;
+	for (int y = 0; y < size; y++) {
+		const bool edge_row = y < BAND || y >= size - BAND;
+		for (int x = 0; x < size; x++) {
+			if (!edge_row && x == BAND) {
+				x = size - BAND;
+			}
+			if (visited[y * size + x] || state.get(x, y) != Cell::ALIVE) {
+				continue;
+			}
+			//Flood fill the 8-connected component this cell belongs to.
+			component.clear();
+			stack.assign(1, y * size + x);
+			visited[y * size + x] = 1;
+			int x0 = x, y0 = y, x1 = x, y1 = y;
+			while (!stack.empty()) {
+				const int index = stack.back();
+				const int cx = index % size, cy = index / size;
+				stack.pop_back();
+				component.push_back(index);
+				x0 = std::min(x0, cx);
+				x1 = std::max(x1, cx);
+				y0 = std::min(y0, cy);
+				y1 = std::max(y1, cy);
+				for (int ny = std::max(cy - 1, 0); ny <= std::min(cy + 1, size - 1); ny++) {
+					for (int nx = std::max(cx - 1, 0); nx <= std::min(cx + 1, size - 1); nx++) {
+						if (!visited[ny * size + nx] && state.get(nx, ny) == Cell::ALIVE) {
+							visited[ny * size + nx] = 1;
+							stack.push_back(ny * size + nx);
+						}
+					}
+				}
+			}
+			if (!phases.count(Pattern::canonical_hash(state.crop(x0, y0, x1 + 1, y1 + 1)))) {
+				return -1;
+			}
+			for (int index : component) {
+				state.set(index % size, index / size, Cell::DEAD);
+			}
+			removed++;
+		}
+	}
+	if (removed > 0) {
+		world.set_state(state);
+	}
+	return removed;
+}
+
+/**
+ * Private helper for a strict order on setups, so the example of each entry does not depend on scheduling.
+ */
+bool earlier(const Collision::Setup &a, const Collision::Setup &b) {
+	return std::make_tuple(a.orientation, a.dy, a.dx, a.delay) < std::make_tuple(b.orientation, b.dy, b.dx, b.delay);
+}
+
+/**
+ * The worlds a worker recycles for every setup it runs.
+ */
+struct Worlds {
+	World both, first, second;
+};
+
+/**
+ * The outcome of one distinct collision, before collisions are grouped into entries.
+ */
+struct Simulated {
+	unsigned long long collision { };
+	Collision::Entry entry;
+};
+
+}
+
+/**
+ * Collision::setups(lanes)
+ *
+ * Generate every setup of the second glider within the given number of lanes of the first glider's path.
+ *
+ * @param lanes
+ *      The largest offset in x and y of the second glider from the point the first glider heads towards.
+ *
+ * @return
+ *      Returns 3 orientations, times (2 * lanes + 1) squared offsets, times 4 timings.
+ *
+ * @throws
+ *      Throws std::runtime_error if lanes is negative.
+ */
+std::vector<Collision::Setup> Collision::setups(int lanes) {
+	if (lanes < 0) {
+		throw std::runtime_error("The number of lanes must not be negative.");
+	}
+	std::vector<Setup> all;
+	for (int orientation = 1; orientation < 4; orientation++) {
+		for (int dy = -lanes; dy <= lanes; dy++) {
+			for (int dx = -lanes; dx <= lanes; dx++) {
+				for (int delay = 0; delay < 4; delay++) {
+					Setup setup;
+					setup.orientation = orientation;
+					setup.dx = dx;
+					setup.dy = dy;
+					setup.delay = delay;
+					all.push_back(setup);
+				}
+			}
+		}
+	}
+	return all;
+}
+
+/**
+ * Collision::place(setup, lanes, rule)
+ *
+ * Place both gliders of a setup on the board used for the given number of lanes.
+ *
+ * @example
+ *
+ *      // A head on collision of two gliders, two cells off centre
+ *      Collision::Setup setup;
+ *      setup.orientation = 2;
+ *      setup.dx = 2;
+ *      World world(Collision::place(setup, 4));
+ *
+ * @param setup
+ *      The setup to place.
+ *
+ * @param lanes
+ *      The number of lanes the board is sized for.
+ *
+ * @param rule
+ *      Optional parameter. The rule the second glider is started early in. Defaults to B3/S23.
+ *
+ * @return
+ *      Returns a new square grid holding both gliders.
+ *
+ * @throws
+ *      Throws std::runtime_error if Zoo::glider is not a glider in the rule.
+ */
+Grid Collision::place(const Setup &setup, int lanes, const Rule &rule) {
+	Grid first, second;
+	place_apart(setup, lanes, rule, first, second);
+	first.merge(second, 0, 0, true);
+	return first;
+}
+
+/**
+ * Collision::enumerate(pool, lanes, max_steps, rule)
+ *
+ * Simulate every distinct collision of two gliders within the given number of lanes and catalogue the outcomes.
+ *
+ * @example
+ *
+ *      // Catalogue every collision within 4 lanes
+ *      ThreadPool pool;
+ *      Collision::write_catalogue(std::cout, Collision::enumerate(pool, 4));
+ *
+ * @param pool
+ *      The pool to simulate on.
+ *
+ * @param lanes
+ *      Optional parameter. The largest offset of the second glider from the first glider's path. Defaults to 4.
+ *
+ * @param max_steps
+ *      Optional parameter. The number of steps after a collision at which its outcome is UNDECIDED. Defaults to 1000.
+ *
+ * @param rule
+ *      Optional parameter. The rule to simulate. Defaults to B3/S23.
+ *
+ * @return
+ *      Returns one entry per distinct outcome, the most common first.
+ *
+ * @throws
+ *      Throws std::runtime_error if lanes is negative, or Zoo::glider is not a glider in the rule.
+ */
+std::vector<Collision::Entry> Collision::enumerate(ThreadPool &pool, int lanes, int max_steps, const Rule &rule) {
+	const std::vector<Setup> all = setups(lanes);
+	//Check the glider is a glider in the rule here, rather than in every task. B/S rules are isotropic,
+	//so every rotation of it is one too.
+	int hx, hy;
+	heading(Zoo::glider(), hx, hy, rule);
+	const std::unordered_set<unsigned long long> phases = glider_phases(rule);
+	const int approach_steps = 4 * (APPROACH + 2 * lanes + 4);
+
+	std::mutex lock;
+	std::unordered_map<unsigned long long, Setup> examples;
+	std::vector<Simulated> simulated;
+
+	std::vector<Worlds> worlds(pool.get_size());
+	for (Worlds &scratch : worlds) {
+		scratch.both.set_rule(rule);
+		scratch.first.set_rule(rule);
+		scratch.second.set_rule(rule);
+	}
+	for (const Setup &setup : all) {
+		pool.submit([&, setup](int worker) {
+			Worlds &scratch = worlds[worker];
+			Grid first, second;
+			place_apart(setup, lanes, rule, first, second);
+			scratch.first.set_state(first);
+			scratch.second.set_state(second);
+			first.merge(second, 0, 0, true);
+			scratch.both.set_state(first);
+
+			//Step the gliders together and apart until the first step they interact at.
+			Grid before, apart;
+			int interaction = 0;
+			for (int step = 1; step <= approach_steps && interaction == 0; step++) {
+				before = scratch.both.get_state();
+				scratch.both.step();
+				scratch.first.step();
+				scratch.second.step();
+				apart = scratch.first.get_state();
+				apart.merge(scratch.second.get_view(), 0, 0, true);
+				if (GridView(apart).hash() != scratch.both.get_view().hash()) {
+					interaction = step;
+				}
+			}
+			//Gliders that never meet, or that start touching, are not a collision.
+			if (interaction <= 1) {
+				return;
+			}
+			const unsigned long long collision = Pattern::canonical_hash(before);
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				auto found = examples.find(collision);
+				if (found != examples.end()) {
+					if (earlier(setup, found->second)) {
+						found->second = setup;
+					}
+					return;
+				}
+				examples[collision] = setup;
+			}
+
+			//Simulate the collision until its debris repeats, removing gliders as they escape.
+			Simulated result;
+			result.collision = collision;
+			Collision::Entry &entry = result.entry;
+			World &world = scratch.both;
+			std::unordered_map<unsigned long long, int> seen;
+			for (int generation = 1; generation <= max_steps; generation++) {
+				world.step();
+				if (generation % 4 == 0) {
+					const int removed = remove_gliders(world, phases);
+					if (removed < 0) {
+						entry.generation = generation;
+						break;
+					}
+					if (removed > 0) {
+						entry.gliders += removed;
+						seen.clear();
+					}
+				}
+				if (world.get_alive_cells() == 0) {
+					entry.outcome = Sweep::DIES;
+					entry.generation = generation;
+					break;
+				}
+				auto repeat = seen.insert(std::make_pair(world.get_view().hash(), generation));
+				if (!repeat.second) {
+					entry.period = generation - repeat.first->second;
+					entry.outcome = entry.period == 1 ? Sweep::STABILISES : Sweep::OSCILLATES;
+					entry.generation = repeat.first->second;
+					break;
+				}
+				entry.generation = generation;
+			}
+
+			//Canonicalise the debris across every phase it oscillates through.
+			entry.debris = Pattern::canonical(world.get_view());
+			for (int phase = 1; phase < entry.period; phase++) {
+				world.step();
+				Grid candidate = Pattern::canonical(world.get_view());
+				if (Pattern::less(candidate, entry.debris)) {
+					entry.debris = candidate;
+				}
+			}
+			std::lock_guard<std::mutex> guard(lock);
+			simulated.push_back(result);
+		});
+	}
+	pool.wait();
+
+	//Group the distinct collisions by outcome.
+	std::map<std::tuple<int, int, unsigned long long>, Entry> grouped;
+	for (const Simulated &result : simulated) {
+		const Entry &entry = result.entry;
+		const Setup &example = examples[result.collision];
+		auto key = std::make_tuple(static_cast<int>(entry.outcome), entry.gliders, GridView(entry.debris).hash());
+		auto found = grouped.find(key);
+		if (found == grouped.end()) {
+			Entry &group = grouped[key];
+			group = entry;
+			group.setups = 1;
+			group.example = example;
+		} else {
+			Entry &group = found->second;
+			group.setups++;
+			group.generation = std::min(group.generation, entry.generation);
+			if (earlier(example, group.example)) {
+				group.example = example;
+			}
+		}
+	}
+	std::vector<Entry> entries;
+	for (const auto &group : grouped) {
+		entries.push_back(group.second);
+	}
+	std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+		if (a.setups != b.setups) {
+			return a.setups > b.setups;
+		}
+		if (a.gliders != b.gliders) {
+			return a.gliders < b.gliders;
+		}
+		return Pattern::less(a.debris, b.debris);
+	});
+	return entries;
+}
+
+/**
+ * Collision::write_catalogue(stream, entries)
+ *
+ * Write a tab separated line per entry, with the debris as rows of '#' and '.' separated by '/'.
+ *
+ * @example
+ *
+ *      // Prints lines like: stabilises	1	0	12	53	2 0 -1 3	##/##
+ *      Collision::write_catalogue(std::cout, entries);
+ *
+ * @param stream
+ *      An ascii mode output stream such as std::cout.
+ *
+ * @param entries
+ *      The entries returned by Collision::enumerate.
+ */
+void Collision::write_catalogue(std::ostream &stream, const std::vector<Entry> &entries) {
+	int collisions = 0;
+	stream << "outcome\tperiod\tgliders\tsetups\tgeneration\texample\tdebris\n";
+	for (const Entry &entry : entries) {
+		const Setup &example = entry.example;
+		stream << Sweep::outcome_name(entry.outcome) << '\t' << entry.period << '\t' << entry.gliders << '\t'
+				<< entry.setups << '\t' << entry.generation << '\t' << example.orientation << ' ' << example.dx << ' '
+				<< example.dy << ' ' << example.delay << '\t';
+		for (int y = 0; y < entry.debris.get_height(); y++) {
+			if (y > 0) {
+				stream << '/';
+			}
+			for (int x = 0; x < entry.debris.get_width(); x++) {
+				stream << (entry.debris.get(x, y) == Cell::ALIVE ? '#' : '.');
+			}
+		}
+		stream << '\n';
+		collisions += entry.setups;
+	}
+	stream << "Collisions " << collisions << " | Outcomes " << entries.size() << '\n';
+	stream.flush();
+}
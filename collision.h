@@ -0,0 +1,51 @@
+/**
+ * Declares a Collision namespace with methods for cataloguing the outcomes of collisions between two gliders.
+ * Rich documentation for the api and behaviour the Collision namespace can be found in collision.cpp.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the namespace.
+// #include ...
+#include <iostream>
+#include <vector>
+#include "grid.h"
+#include "rule.h"
+#include "pool.h"
+#include "sweep.h"
+
+/**
+ * Declare the interface of the Collision namespace for glider collision catalogues.
+ */
+namespace Collision {
+
+/**
+ * A Setup places a second glider, rotated by orientation quarter turns, offset by (dx, dy) from the
+ * point it would meet the first glider at, and started delay steps earlier than the first glider.
+ */
+struct Setup {
+	int orientation { }, dx { }, dy { }, delay { };
+};
+
+/**
+ * An Entry is one distinct outcome of a collision.
+ *      - debris is the canonical form of what is left once escaping gliders are removed.
+ *      - gliders is the number of gliders that escaped.
+ *      - setups is the number of distinct setups with this outcome, and example is the first of them.
+ *      - generation is the number of steps from the collision until the outcome was decided.
+ */
+struct Entry {
+	Grid debris;
+	Sweep::Outcome outcome { Sweep::UNDECIDED };
+	int period { }, gliders { }, setups { }, generation { };
+	Setup example;
+};
+
+std::vector<Setup> setups(int lanes);
+Grid place(const Setup &setup, int lanes, const Rule &rule = Rule());
+std::vector<Entry> enumerate(ThreadPool &pool, int lanes = 4, int max_steps = 1000, const Rule &rule = Rule());
+void write_catalogue(std::ostream &stream, const std::vector<Entry> &entries);
+}
+;
@@ -0,0 +1,373 @@
+/**
+ * Implements a class representing a coloured variant of a 2d cellular automaton, such as Immigration or QuadLife.
+ *      - Every alive cell has one of 2 colours, as in Immigration, or one of 4 colours, as in QuadLife.
+ *      - Whether a cell is alive follows the rule exactly as in a World, colours never change the shape of a pattern.
+ *      - A surviving cell keeps its colour.
+ *      - A cell that is born takes the majority colour of its alive neighbours, its parents.
+ *          - With 3 parents, as under B3, a colour held by 2 or 3 of them is the majority.
+ *          - In QuadLife, 3 parents of different colours give a child of the fourth colour.
+ *          - Under rules with other numbers of parents the lowest colour held by at least 2 parents wins,
+ *            then in QuadLife the lowest colour held by none of them, then colour 1.
+ *
+ *      - Cells are held as bit planes, 64 to a word.
+ *          - One plane holds the alive cells and steps with the circuit compiled from the rule by Bits::compile.
+ *          - The colours of alive cells are held in 1 or 2 further planes, one per bit of the colour - 1.
+ *          - Each step splits the alive plane into one plane per colour with bitwise logic, and counts the
+ *            neighbours of each colour bit-parallel with Bits::Plane::sum. Whether a colour holds a majority,
+ *            2 or more, is the OR of the upper planes of its count, and whether it is missing is the NOR
+ *            of them all, so births are coloured a word at a time without looking at cells one by one.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#include "colour.h"
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+/**
+ * ColourWorld::ColourWorld(width, height, colours, rule)
+ *
+ * Construct a world of dead cells.
+ *
+ * @example
+ *
+ *      // Make a 64x64 QuadLife world
+ *      ColourWorld world(64, 64, 4);
+ *
+ * @param width
+ *      The width of the world.
+ *
+ * @param height
+ *      The height of the world.
+ *
+ * @param colours
+ *      The number of colours, 2 for Immigration or 4 for QuadLife.
+ *
+ * @param rule
+ *      Optional parameter. The rule alive cells follow. Defaults to B3/S23.
+ *
+ * @throws
+ *      Throws std::runtime_error if the number of colours is not 2 or 4, or the size is negative.
+ */
+ColourWorld::ColourWorld(int width, int height, int colours, const Rule &rule) :
+		width(width), height(height), colours(colours), colour_bits(colours == 4 ? 2 : 1), rule(rule),
+		circuit(Bits::compile(rule)) {
+	if (colours != 2 && colours != 4) {
+		throw std::runtime_error("A coloured world must have 2 or 4 colours.");
+	}
+	if (width < 0 || height < 0) {
+		throw std::runtime_error("A coloured world cannot have a negative size.");
+	}
+	alive = Bits::Plane(width, height);
+	colour.assign(colour_bits, alive);
+}
+
+/**
+ * ColourWorld::ColourWorld(state, colours, seed, rule)
+ *
+ * Construct a world from the alive cells of a grid, giving each alive cell a random colour.
+ *
+ * @example
+ *
+ *      // Colour an R-pentomino at random for an Immigration demo
+ *      ColourWorld world(Zoo::r_pentomino(), 2, 42);
+ *
+ * @param state
+ *      The alive cells of the world.
+ *
+ * @param colours
+ *      The number of colours, 2 for Immigration or 4 for QuadLife.
+ *
+ * @param seed
+ *      Optional parameter. The seed of the random colours, so runs can be repeated. Defaults to 0.
+ *
+ * @param rule
+ *      Optional parameter. The rule alive cells follow. Defaults to B3/S23.
+ *
+ * @throws
+ *      Throws std::runtime_error if the number of colours is not 2 or 4.
+ */
+ColourWorld::ColourWorld(GridView state, int colours, unsigned int seed, const Rule &rule) :
+		ColourWorld(state.get_width(), state.get_height(), colours, rule) {
+	std::mt19937 random(seed);
+	std::uniform_int_distribution<int> pick(1, colours);
+	for (int y = 0; y < height; y++) {
+		for (int x = 0; x < width; x++) {
+			if (state.get(x, y) == Cell::ALIVE) {
+				set(x, y, pick(random));
+			}
+		}
+	}
+}
+
+/**
+ * ColourWorld::get_width()
+ *
+ * Gets the width of the world.
+ */
+int ColourWorld::get_width() const {
+	return width;
+}
+
+/**
+ * ColourWorld::get_height()
+ *
+ * Gets the height of the world.
+ */
+int ColourWorld::get_height() const {
+	return height;
+}
+
+/**
+ * ColourWorld::get_colours()
+ *
+ * Gets the number of colours, 2 or 4.
+ */
+int ColourWorld::get_colours() const {
+	return colours;
+}
+
+/**
+ * ColourWorld::get_rule()
+ *
+ * Gets the rule alive cells follow.
+ */
+const Rule& ColourWorld::get_rule() const {
+	return rule;
+}
+
+/**
+ * ColourWorld::get(x, y)
+ *
+ * Gets the colour of a cell.
+ *
+ * @return
+ *      Returns 0 for a dead cell, or the colour of an alive cell from 1.
+ *
+ * @throws
+ *      Throws std::runtime_error if the cell is outside the world.
+ */
+int ColourWorld::get(int x, int y) const {
+	if (x < 0 || x >= width || y < 0 || y >= height) {
+		throw std::runtime_error("The cell is outside the coloured world.");
+	}
+	const int k = x / 64, bit = x % 64;
+	if (!((alive.row(y)[k] >> bit) & 1)) {
+		return 0;
+	}
+	int cell_colour = 1;
+	for (int b = 0; b < colour_bits; b++) {
+		cell_colour += (int) ((colour[b].row(y)[k] >> bit) & 1) << b;
+	}
+	return cell_colour;
+}
+
+/**
+ * ColourWorld::set(x, y, cell_colour)
+ *
+ * Sets the colour of a cell.
+ *
+ * @example
+ *
+ *      // Make a blinker of 3 colours, whose children will take the 4th
+ *      ColourWorld world(5, 5, 4);
+ *      world.set(2, 1, 1);
+ *      world.set(2, 2, 2);
+ *      world.set(2, 3, 3);
+ *
+ * @param cell_colour
+ *      0 to kill the cell, or the colour of the alive cell from 1.
+ *
+ * @throws
+ *      Throws std::runtime_error if the cell is outside the world or the colour is out of range.
+ */
+void ColourWorld::set(int x, int y, int cell_colour) {
+	if (x < 0 || x >= width || y < 0 || y >= height) {
+		throw std::runtime_error("The cell is outside the coloured world.");
+	}
+	if (cell_colour < 0 || cell_colour > colours) {
+		throw std::runtime_error("The colour " + std::to_string(cell_colour) + " is out of range.");
+	}
+	const int k = x / 64;
+	const Word bit = 1ull << (x % 64);
+	//Dead cells are held with every colour bit clear.
+	const int bits = cell_colour > 0 ? cell_colour - 1 : 0;
+	alive.row(y)[k] = cell_colour > 0 ? alive.row(y)[k] | bit : alive.row(y)[k] & ~bit;
+	for (int b = 0; b < colour_bits; b++) {
+		colour[b].row(y)[k] = ((bits >> b) & 1) ? colour[b].row(y)[k] | bit : colour[b].row(y)[k] & ~bit;
+	}
+}
+
+/**
+ * ColourWorld::get_alive_cells()
+ *
+ * Gets the number of alive cells of any colour.
+ */
+int ColourWorld::get_alive_cells() const {
+	int count = 0;
+	for (Word word : alive.bits) {
+		count += __builtin_popcountll(word);
+	}
+	return count;
+}
+
+/**
+ * ColourWorld::get_population(cell_colour)
+ *
+ * Gets the number of alive cells of one colour.
+ *
+ * @param cell_colour
+ *      The colour, from 1.
+ */
+int ColourWorld::get_population(int cell_colour) const {
+	int count = 0;
+	for (std::size_t i = 0; i < alive.bits.size(); i++) {
+		Word match = alive.bits[i];
+		for (int b = 0; b < colour_bits; b++) {
+			match &= (((cell_colour - 1) >> b) & 1) ? colour[b].bits[i] : ~colour[b].bits[i];
+		}
+		count += __builtin_popcountll(match);
+	}
+	return count;
+}
+
+/**
+ * ColourWorld::get_state()
+ *
+ * Gets the alive cells of the world as a grid, without their colours.
+ */
+Grid ColourWorld::get_state() const {
+	Grid grid(width, height);
+	for (int y = 0; y < height; y++) {
+		for (int k = 0; k < alive.words; k++) {
+			Bits::unpack_row(alive.row(y)[k], grid.data() + y * width + k * 64, std::min(64, width - k * 64));
+		}
+	}
+	return grid;
+}
+
+/**
+ * ColourWorld::step(toroidal)
+ *
+ * Take one step, moving the alive cells by the rule and colouring every cell that is born.
+ *
+ * @param toroidal
+ *      Optional parameter. If true then the step will consider the world as a torus, where the left edge
+ *      wraps to the right edge and the top to the bottom. Defaults to false.
+ */
+void ColourWorld::step(bool toroidal) {
+	if (width == 0 || height == 0) {
+		return;
+	}
+	//Split the alive cells into one plane per colour.
+	std::vector<Bits::Plane> members(colours, alive);
+	for (std::size_t i = 0; i < alive.bits.size(); i++) {
+		for (int c = 0; c < colours; c++) {
+			for (int b = 0; b < colour_bits; b++) {
+				members[c].bits[i] &= ((c >> b) & 1) ? colour[b].bits[i] : ~colour[b].bits[i];
+			}
+		}
+	}
+	Bits::Plane next_alive(width, height);
+	std::vector<Bits::Plane> next_colour(colour_bits, next_alive);
+	const Word last_mask = Bits::width_mask(width - (alive.words - 1) * 64);
+	for (int y = 0; y < height; y++) {
+		for (int k = 0; k < alive.words; k++) {
+			const Word cells = alive.row(y)[k];
+			Word next = Bits::evaluate(circuit, cells, alive.sum(y, k, toroidal));
+			if (k + 1 == alive.words) {
+				next &= last_mask;
+			}
+			const Word born = next & ~cells;
+			//Colour the births, majorities first then missing colours, lower colours first.
+			Word majority[4], missing[4], decided = 0, chosen[4] = { };
+			for (int c = 0; c < colours; c++) {
+				const Bits::Sum count = born != 0 ? members[c].sum(y, k, toroidal) : Bits::Sum();
+				majority[c] = count.s1 | count.s2 | count.s3;
+				missing[c] = ~(count.s0 | count.s1 | count.s2 | count.s3);
+			}
+			for (int c = 0; c < colours; c++) {
+				chosen[c] = majority[c] & ~decided;
+				decided |= chosen[c];
+			}
+			if (colours == 4) {
+				for (int c = 0; c < colours; c++) {
+					chosen[c] |= missing[c] & ~decided;
+					decided |= chosen[c];
+				}
+			}
+			next_alive.row(y)[k] = next;
+			for (int b = 0; b < colour_bits; b++) {
+				Word bit = 0;
+				for (int c = 0; c < colours; c++) {
+					if ((c >> b) & 1) {
+						bit |= chosen[c];
+					}
+				}
+				next_colour[b].row(y)[k] = (colour[b].row(y)[k] & next & cells) | (bit & born);
+			}
+		}
+	}
+	alive = std::move(next_alive);
+	colour = std::move(next_colour);
+}
+
+/**
+ * ColourWorld::advance(steps, toroidal)
+ *
+ * Advance multiple steps.
+ *
+ * @param steps
+ *      The number of steps to advance the world forward.
+ *
+ * @param toroidal
+ *      Optional parameter. If true then the world is a torus. Defaults to false.
+ */
+void ColourWorld::advance(int steps, bool toroidal) {
+	for (int i = 0; i < steps; i++) {
+		step(toroidal);
+	}
+}
+
+/**
+ * operator<<(output_stream, world)
+ *
+ * Serializes a coloured world to an ascii output stream, like a Grid, with alive cells shown as the digit
+ * of their colour instead of # (hash) characters.
+ *
+ * @example
+ *
+ *      // A blinker of 3 colours in QuadLife
+ *
+ *      +-----+
+ *      |     |
+ *      |  1  |
+ *      |  2  |
+ *      |  3  |
+ *      |     |
+ *      +-----+
+ *
+ * @param os
+ *      An ascii mode output stream such as std::cout.
+ *
+ * @param world
+ *      A coloured world to be printed.
+ */
+std::ostream& operator<<(std::ostream &stream, const ColourWorld &obj) {
+	const std::string border = '+' + std::string(obj.width, '-') + "+\n";
+	stream << border;
+	for (int y = 0; y < obj.height; y++) {
+		stream << '|';
+		for (int x = 0; x < obj.width; x++) {
+			const int cell_colour = obj.get(x, y);
+			stream << (cell_colour > 0 ? (char) ('0' + cell_colour) : ' ');
+		}
+		stream << "|\n";
+	}
+	stream << border;
+	return stream;
+}
@@ -0,0 +1,46 @@
+/**
+ * Declares a class representing a coloured variant of a 2d cellular automaton, such as Immigration or QuadLife.
+ * Rich documentation for the api and behaviour the ColourWorld class can be found in colour.cpp.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the class.
+// #include ...
+#include <iostream>
+#include <vector>
+#include "grid.h"
+#include "rule.h"
+#include "bits.h"
+
+/**
+ * Declare the structure of the ColourWorld class for simulating Life where every alive cell has a colour.
+ *
+ * Cells are held as bit planes, one plane of alive cells and one plane per bit of the colour.
+ *      - The alive plane evolves exactly as a World with the same rule, with the compiled circuit.
+ *      - Colours are numbered from 1, 0 is a dead cell.
+ */
+class ColourWorld {
+	int width { }, height { }, colours { }, colour_bits { };
+	Rule rule;
+	Bits::Circuit circuit;
+	Bits::Plane alive;
+	std::vector<Bits::Plane> colour;
+public:
+	ColourWorld(int width, int height, int colours, const Rule &rule = Rule());
+	ColourWorld(GridView state, int colours, unsigned int seed = 0, const Rule &rule = Rule());
+	int get_width() const;
+	int get_height() const;
+	int get_colours() const;
+	const Rule& get_rule() const;
+	int get(int x, int y) const;
+	void set(int x, int y, int cell_colour);
+	int get_alive_cells() const;
+	int get_population(int cell_colour) const;
+	Grid get_state() const;
+	void step(bool toroidal = false);
+	void advance(int steps, bool toroidal = false);
+	friend std::ostream& operator<<(std::ostream &stream, const ColourWorld &obj);
+};
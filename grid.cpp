@@ -3,9 +3,15 @@
  *      - New cells are initialized to Cell::DEAD.
  *      - Grids can be resized while retaining their contents in the remaining area.
  *      - Grids can be rotated, cropped, and merged together.
+ *      - Grids can be shifted or rolled in place, moving whole rows with memmove.
+ *      - Grids can be scaled up by a whole factor, or down by reducing blocks of cells to one.
  *      - Grids can return counts of the alive and dead cells.
  *      - Grids can be serialized directly to an ascii std::ostream.
  *
+ *      - GridViews are read-only windows onto the cells of a Grid that never copy cells.
+ *          - Cropping a grid returns a view, and views can be merged, rotated, counted, and serialized
+ *            just like grids, so region based pipelines do not copy sub-grids.
+ *
  * You are encouraged to use STL container types as an underlying storage mechanism for the grid cells.
  *
  * @author 964379
@@ -15,6 +21,9 @@
 
 // Include the minimal number of headers needed to support your implementation.
 // #include ...
+#include <climits>
+#include <cstdlib>
+#include <cstring>
 
 /**
  * Grid::Grid()
@@ -88,6 +97,31 @@ Grid::Grid(int width, int height) :
 		theGrid(width * height, DEAD), num_columns(width), num_rows(height) {
 }
 
+/**
+ * Grid::Grid(view)
+ *
+ * Construct a grid holding a copy of the cells in a view.
+ * The constructor is not explicit so that views, such as those returned by Grid::crop,
+ * can be assigned straight into a Grid.
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      Grid y(4, 4);
+ *
+ *      // Copy the centre 2x2 of y into a new grid
+ *      Grid x = y.crop(1, 1, 3, 3);
+ *
+ * @param view
+ *      The view to copy the size and cells from.
+ */
+Grid::Grid(const GridView &view) :
+		Grid(view.get_width(), view.get_height()) {
+	for (int y = 0; y < num_rows; y++) {
+		std::copy(view.row(y), view.row(y) + num_columns, theGrid.begin() + y * num_columns);
+	}
+}
+
 /**
  * Grid::get_width()
  *
@@ -317,6 +351,34 @@ void Grid::resize(int width, int height) {
 	}
 }
 
+/**
+ * Grid::assign(view)
+ *
+ * Replace the size and contents of the grid with those of a view.
+ * Unlike constructing a new grid, the existing storage is reused whenever it is large enough,
+ * which lets long running callers recycle grids between unrelated patterns without reallocating.
+ *
+ * @example
+ *
+ *      // Make a scratch grid once
+ *      Grid scratch;
+ *
+ *      // Reuse it for every pattern
+ *      scratch.assign(Zoo::glider());
+ *      scratch.assign(Zoo::light_weight_spaceship());
+ *
+ * @param view
+ *      The cells to copy. The view must not look at this grid.
+ */
+void Grid::assign(GridView view) {
+	num_columns = view.get_width();
+	num_rows = view.get_height();
+	theGrid.resize(num_columns * num_rows);
+	for (int y = 0; y < num_rows; y++) {
+		std::copy(view.row(y), view.row(y) + num_columns, theGrid.begin() + y * num_columns);
+	}
+}
+
 /**
  * Grid::get_index(x, y)
  *
@@ -480,20 +542,61 @@ const Cell& Grid::operator()(int x, int y) const {
 	return theGrid.at(get_index(x, y));
 }
 
+/**
+ * Grid::data()
+ *
+ * Gets a pointer to the first cell of the grid for kernels that process whole rows at a time.
+ * Cells are stored contiguously in row major order, so the cell at x,y is at data()[y * get_width() + x].
+ * The pointer is invalidated by Grid::resize.
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      Grid grid(4, 4);
+ *
+ *      // Kill the whole second row
+ *      std::fill(grid.data() + 4, grid.data() + 8, Cell::DEAD);
+ *
+ * @return
+ *      A modifiable pointer to the cells of the grid.
+ */
+Cell* Grid::data() {
+	return theGrid.data();
+}
+
+/**
+ * Grid::data()
+ *
+ * Gets a read-only pointer to the first cell of the grid.
+ * The function should be callable from a constant context.
+ *
+ * @return
+ *      A read-only pointer to the cells of the grid.
+ */
+const Cell* Grid::data() const {
+	return theGrid.data();
+}
+
 /**
  * Grid::crop(x0, y0, x1, y1)
  *
- * Extract a sub-grid from a Grid.
- * The cropped grid spans the range [x0, x1) by [y0, y1) in the original grid.
+ * Extract a sub-grid from a Grid without copying any cells.
+ * The cropped view spans the range [x0, x1) by [y0, y1) in the original grid.
  * The function should be callable from a constant context.
  *
+ * The returned view looks at the cells of the original grid, so it must not outlive it
+ * and it is invalidated by Grid::resize. Assign it to a Grid to take a copy.
+ *
  * @example
  *
  *      // Make a grid
  *      Grid y(4, 4);
  *
  *      // Crop the centre 2x2 in y, trimming a 1 cell border off all sides
- *      Grid x = y.crop(x, 1, 1, 3, 3);
+ *      Grid x = y.crop(1, 1, 3, 3);
+ *
+ *      // Count the alive cells in the centre 2x2 without making a copy
+ *      int alive = y.crop(1, 1, 3, 3).get_alive_cells();
  *
  * @param x0
  *      Left coordinate of the crop window on x-axis.
@@ -508,38 +611,21 @@ const Cell& Grid::operator()(int x, int y) const {
  *      Bottom coordinate of the crop window on y-axis (1 greater than the largest index).
  *
  * @return
- *      A new grid of the cropped size containing the values extracted from the original grid.
+ *      A view of the cropped size onto the cells of the original grid.
  *
  * @throws
  *      std::exception or sub-class if x0,y0 or x1,y1 are not valid coordinates within the grid
  *      or if the crop window has a negative size.
  */
-Grid Grid::crop(int x0, int y0, int x1, int y1) const {
-	if (x1 < x0 || y1 < y0) {
-		throw std::runtime_error("The crop window has a negative size");
-	}
-	//Testing the coordinates to not be out of bounds.
-	//If they are an error will be thrown.
-	get_index(x0, y0);
-	get_index(x1 - 1, y1 - 1);
-
-	//Contruct a vector that takes only the cells inside the grid between the coordinates
-	//specified.
-	std::vector<Cell> temp;
-	for (int i = y0; i < y1; i++) {
-		temp.insert(temp.end(), theGrid.begin() + x0 + num_columns * i,
-				theGrid.begin() + num_columns * i + x1);
-	}
-	//Initializa a new grid that will take the size and grid required.
-	Grid subgrid(x1 - x0, y1 - y0);
-	subgrid.theGrid = temp;
-	return subgrid;
+GridView Grid::crop(int x0, int y0, int x1, int y1) const {
+	return GridView(*this).crop(x0, y0, x1, y1);
 }
 
 /**
  * Grid::merge(other, x0, y0, alive_only = false)
  *
  * Merge two grids together by overlaying the other on the current grid at the desired location.
+ * The other grid is taken as a view, so grids and cropped regions can be merged without copying them.
  * By default merging overwrites all cells within the merge reason to be the value from the other grid.
  *
  * Conditionally if alive_only = true perform the merge such that only alive cells are updated.
@@ -558,7 +644,7 @@ Grid Grid::crop(int x0, int y0, int x1, int y1) const {
  *      y.merge(x, 2, 2, true);
  *
  * @param other
- *      The other grid to merge into the current grid.
+ *      The other grid, or a view onto a region of a grid, to merge into the current grid.
  *
  * @param x0
  *      The x coordinate of where to place the top left corner of the other grid.
@@ -573,26 +659,182 @@ Grid Grid::crop(int x0, int y0, int x1, int y1) const {
  * @throws
  *      std::exception or sub-class if the other grid being placed does not fit within the bounds of the current grid.
  */
-void Grid::merge(Grid other, int x0, int y0, bool alive_only) {
-	//Directly set the cell at every position from the other grid in the current grid
-	//according to hte alive_only parameter.
-	if (!alive_only == true) {
-		for (int i = 0; i < other.num_rows; i++) {
-			for (int j = 0; j < other.num_columns; j++) {
-				set(j + x0, i + y0, other(j, i));
-			}
-		}
-	} else {
-		for (int i = 0; i < other.num_rows; i++) {
-			for (int j = 0; j < other.num_columns; j++) {
-				if (get(j + x0, i + y0) == Cell::DEAD) {
-					set(j + x0, i + y0, other(j, i));
+void Grid::merge(GridView other, int x0, int y0, bool alive_only) {
+	if (other.get_width() == 0 || other.get_height() == 0) {
+		return;
+	}
+	//Check both corners of the merge window up front so a failed merge leaves the grid untouched.
+	get_index(x0, y0);
+	get_index(x0 + other.get_width() - 1, y0 + other.get_height() - 1);
+
+	//A view onto this grid may overlap the merge window, in which case take a copy to read from.
+	Grid copy;
+	if (other.row(0) >= data() && other.row(0) < data() + theGrid.size()) {
+		copy = Grid(other);
+		other = copy;
+	}
+	//Copy whole rows, or only let the alive cells through if alive_only is set.
+	for (int i = 0; i < other.get_height(); i++) {
+		const Cell *source = other.row(i);
+		Cell *destination = data() + (y0 + i) * num_columns + x0;
+		if (!alive_only) {
+			std::copy(source, source + other.get_width(), destination);
+		} else {
+			for (int j = 0; j < other.get_width(); j++) {
+				if (destination[j] == Cell::DEAD) {
+					destination[j] = source[j];
 				}
 			}
 		}
 	}
 }
 
+/**
+ * Grid::upscale(factor)
+ *
+ * Create a copy of the grid scaled up by a whole factor, each cell becoming a factor x factor block.
+ * Behaves exactly like GridView::upscale.
+ *
+ * @example
+ *
+ *      // Make a metapixel seed where every cell of a glider is a 16x16 block
+ *      Grid seed = Zoo::glider().upscale(16);
+ *
+ * @param factor
+ *      The width and height of the block each cell becomes, at least 1.
+ *
+ * @return
+ *      Returns the scaled up grid.
+ *
+ * @throws
+ *      Throws std::runtime_error if the factor is less than 1, or the scaled grid would be too large.
+ */
+Grid Grid::upscale(int factor) const {
+	return GridView(*this).upscale(factor);
+}
+
+/**
+ * Grid::downscale(factor, mode = Reduce::ANY)
+ *
+ * Create a copy of the grid scaled down by a whole factor, each factor x factor block becoming one cell.
+ * Behaves exactly like GridView::downscale.
+ *
+ * @example
+ *
+ *      // Make an overview of a large world, a cell alive wherever most of its 8x8 block is
+ *      Grid overview = world.get_state().downscale(8, Reduce::MAJORITY);
+ *
+ * @param factor
+ *      The width and height of the blocks reduced to one cell, at least 1.
+ *
+ * @param mode
+ *      Optional parameter. Whether a block becomes alive if any, most, or all of its cells are alive.
+ *      Defaults to Reduce::ANY.
+ *
+ * @return
+ *      Returns the scaled down grid.
+ *
+ * @throws
+ *      Throws std::runtime_error if the factor is less than 1.
+ */
+Grid Grid::downscale(int factor, Reduce mode) const {
+	return GridView(*this).downscale(factor, mode);
+}
+
+/**
+ * Grid::shift(dx, dy)
+ *
+ * Move every cell of the grid in place by an offset, filling the cells uncovered with dead cells.
+ * Cells moved past the edges are lost, so shifting by the width or height or more clears the grid.
+ * Rows are moved with memmove, a single one for the vertical part of the shift.
+ *
+ * @example
+ *
+ *      // Re-centre a glider that has travelled 10 cells down and to the right
+ *      Grid grid = world.get_state();
+ *      grid.shift(-10, -10);
+ *
+ * @param dx
+ *      The number of columns to move the cells right, or left if negative.
+ *
+ * @param dy
+ *      The number of rows to move the cells down, or up if negative.
+ */
+void Grid::shift(int dx, int dy) {
+	if (std::abs((long long) dx) >= num_columns || std::abs((long long) dy) >= num_rows) {
+		std::fill(theGrid.begin(), theGrid.end(), Cell::DEAD);
+		return;
+	}
+	Cell *cells = data();
+	const std::size_t width = num_columns;
+	//Move the rows that stay as one block, then clear the rows uncovered.
+	if (dy > 0) {
+		std::memmove(cells + dy * width, cells, (num_rows - dy) * width);
+		std::fill(cells, cells + dy * width, Cell::DEAD);
+	} else if (dy < 0) {
+		std::memmove(cells, cells - dy * width, (num_rows + dy) * width);
+		std::fill(cells + (num_rows + dy) * width, cells + num_rows * width, Cell::DEAD);
+	}
+	if (dx == 0) {
+		return;
+	}
+	//Rows that were just cleared have nothing to move.
+	const int first = std::max(dy, 0), last = num_rows + std::min(dy, 0);
+	for (int y = first; y < last; y++) {
+		Cell *row = cells + y * width;
+		if (dx > 0) {
+			std::memmove(row + dx, row, width - dx);
+			std::fill(row, row + dx, Cell::DEAD);
+		} else {
+			std::memmove(row, row - dx, width + dx);
+			std::fill(row + width + dx, row + width, Cell::DEAD);
+		}
+	}
+}
+
+/**
+ * Grid::roll(dx, dy)
+ *
+ * Move every cell of the grid in place by an offset on a torus, so cells moved past an edge wrap around to the
+ * opposite edge. Any offset is valid, it is taken modulo the width and height.
+ *
+ * @example
+ *
+ *      // Make a 4x4 grid with an alive cell in the bottom right corner
+ *      Grid grid(4, 4);
+ *      grid(3, 3) = Cell::ALIVE;
+ *
+ *      // The cell wraps around to the top left corner
+ *      grid.roll(1, 1);
+ *
+ * @param dx
+ *      The number of columns to move the cells right, or left if negative.
+ *
+ * @param dy
+ *      The number of rows to move the cells down, or up if negative.
+ */
+void Grid::roll(int dx, int dy) {
+	if (num_columns == 0 || num_rows == 0) {
+		return;
+	}
+	dx = ((dx % num_columns) + num_columns) % num_columns;
+	dy = ((dy % num_rows) + num_rows) % num_rows;
+	//Rotating the whole vector by whole rows rolls it vertically, then each row is rotated through a buffer.
+	if (dy != 0) {
+		std::rotate(theGrid.begin(), theGrid.end() - dy * num_columns, theGrid.end());
+	}
+	if (dx == 0) {
+		return;
+	}
+	std::vector<Cell> wrapped(dx);
+	for (int y = 0; y < num_rows; y++) {
+		Cell *row = data() + y * num_columns;
+		std::memcpy(wrapped.data(), row + num_columns - dx, dx);
+		std::memmove(row + dx, row, num_columns - dx);
+		std::memcpy(row, wrapped.data(), dx);
+	}
+}
+
 /**
  * Grid::rotate(rotation)
  *
@@ -616,40 +858,7 @@ void Grid::merge(Grid other, int x0, int y0, bool alive_only) {
  *      Returns a copy of the grid that has been rotated.
  */
 Grid Grid::rotate(int rotation) const {
-	//Calculate if the grid needs to be rotated 1,2 or 3 times and in which direction
-	//, for greater than 3,-3 degrees.
-	int times = rotation % 4;
-	//Depending how many times needs to be rotated and the direction set the cells
-	//in a temporary grid according to the rotated current grid.
-	if (times == 1 || times == -3) {
-		Grid temp(num_rows, num_columns);
-		for (int i = 0; i < num_columns; i++) {
-			for (int j = 0; j < num_rows; j++) {
-				temp.set(num_rows - 1 - j, i, get(i, j));
-			}
-		}
-		return temp;
-	} else if (times == 2 || times == -2) {
-		Grid temp(num_columns, num_rows);
-		for (int i = 0; i < num_columns; i++) {
-			for (int j = 0; j < num_rows; j++) {
-				temp.set(num_columns - 1 - i, num_rows - j - 1, get(i, j));
-			}
-		}
-		return temp;
-	} else if (times == 3 || times == -1) {
-		Grid temp(num_rows, num_columns);
-		for (int i = 0; i < num_columns; i++) {
-			for (int j = 0; j < num_rows; j++) {
-				temp.set(j, num_columns - 1 - i, get(i, j));
-			}
-		}
-		return temp;
-	}
-	//If the grid hasn't been modified then return a copy of it.
-	Grid temp(num_columns, num_rows);
-	temp.theGrid = theGrid;
-	return temp;
+	return GridView(*this).rotate(rotation);
 }
 
 /**
@@ -688,22 +897,399 @@ Grid Grid::rotate(int rotation) const {
  *      Returns a reference to the output stream to enable operator chaining.
  */
 std::ostream& operator<<(std::ostream &stream, const Grid &obj) {
-	stream << '+';
-	for (int i = 0; i < obj.get_width(); i++) {
-		stream << '-';
+	return stream << GridView(obj);
+}
+
+/**
+ * GridView::GridView()
+ *
+ * Construct an empty view of size 0x0 that does not look at any grid.
+ */
+GridView::GridView() {
+}
+
+/**
+ * GridView::GridView(grid)
+ *
+ * Construct a view of the whole of a grid.
+ * The constructor is not explicit so that a Grid can be passed wherever a GridView is expected.
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      Grid grid(4, 4);
+ *
+ *      // Look at the whole grid
+ *      GridView view = grid;
+ *
+ * @param grid
+ *      The grid to look at. The view must not outlive it.
+ */
+GridView::GridView(const Grid &grid) :
+		GridView(grid.data(), grid.get_width(), 0, grid.get_width(), grid.get_height()) {
+}
+
+/**
+ * GridView::GridView(cells, stride, offset, width, height)
+ *
+ * Construct a view onto an arbitrary row major array of cells.
+ *
+ * @param cells
+ *      Pointer to the first cell of the underlying array.
+ *
+ * @param stride
+ *      The number of cells between the start of consecutive rows in the underlying array.
+ *
+ * @param offset
+ *      The index of the top left cell of the view in the underlying array.
+ *
+ * @param width
+ *      The width of the view.
+ *
+ * @param height
+ *      The height of the view.
+ */
+GridView::GridView(const Cell *cells, int stride, int offset, int width, int height) :
+		origin(cells + offset), stride(stride), num_columns(width), num_rows(height) {
+}
+
+/**
+ * GridView::get_width()
+ *
+ * Gets the width of the view.
+ */
+int GridView::get_width() const {
+	return num_columns;
+}
+
+/**
+ * GridView::get_height()
+ *
+ * Gets the height of the view.
+ */
+int GridView::get_height() const {
+	return num_rows;
+}
+
+/**
+ * GridView::get_stride()
+ *
+ * Gets the number of cells between the start of consecutive rows in the underlying grid.
+ */
+int GridView::get_stride() const {
+	return stride;
+}
+
+/**
+ * GridView::get_total_cells()
+ *
+ * Gets the total number of cells in the view.
+ */
+int GridView::get_total_cells() const {
+	return num_columns * num_rows;
+}
+
+/**
+ * GridView::get_alive_cells()
+ *
+ * Counts how many cells in the view are alive, without copying them.
+ *
+ * @example
+ *
+ *      // Count the alive cells in the upper left 8x8 region of a grid
+ *      int alive = grid.crop(0, 0, 8, 8).get_alive_cells();
+ *
+ * @return
+ *      The number of alive cells.
+ */
+int GridView::get_alive_cells() const {
+	int count = 0;
+	for (int y = 0; y < num_rows; y++) {
+		count += (int) std::count(row(y), row(y) + num_columns, Cell::ALIVE);
+	}
+	return count;
+}
+
+/**
+ * GridView::get_dead_cells()
+ *
+ * Counts how many cells in the view are dead, without copying them.
+ *
+ * @return
+ *      The number of dead cells.
+ */
+int GridView::get_dead_cells() const {
+	return get_total_cells() - get_alive_cells();
+}
+
+/**
+ * GridView::get_index(x, y)
+ *
+ * Private helper function to determine the offset of a 2d coordinate from the top left cell of the view.
+ *
+ * @throws
+ *      std::runtime_error if x,y is not a valid coordinate within the view.
+ */
+int GridView::get_index(int x, int y) const {
+	if (x >= num_columns || x < 0 || y >= num_rows || y < 0) {
+		throw std::runtime_error(
+				"Coordinates are out of the grid size, not valid");
 	}
-	stream << "+\n";
+	return y * stride + x;
+}
+
+/**
+ * GridView::get(x, y)
+ *
+ * Returns the value of the cell at the desired coordinate within the view.
+ *
+ * @throws
+ *      std::runtime_error if x,y is not a valid coordinate within the view.
+ */
+Cell GridView::get(int x, int y) const {
+	return this->operator ()(x, y);
+}
+
+/**
+ * GridView::operator()(x, y)
+ *
+ * Gets a read-only reference to the cell at the desired coordinate within the view.
+ *
+ * @throws
+ *      std::runtime_error if x,y is not a valid coordinate within the view.
+ */
+const Cell& GridView::operator()(int x, int y) const {
+	return origin[get_index(x, y)];
+}
+
+/**
+ * GridView::row(y)
+ *
+ * Gets a pointer to the first cell of a row of the view. The width of the view cells that follow
+ * are contiguous, which lets callers process whole rows at a time. The row is not bounds checked.
+ *
+ * @param y
+ *      The row of the view.
+ *
+ * @return
+ *      A read-only pointer to the leftmost cell of the row.
+ */
+const Cell* GridView::row(int y) const {
+	return origin + y * stride;
+}
+
+/**
+ * GridView::crop(x0, y0, x1, y1)
+ *
+ * Narrow the view to the range [x0, x1) by [y0, y1), without copying any cells.
+ * Behaves exactly like Grid::crop, with coordinates relative to this view.
+ *
+ * @return
+ *      A view onto the cropped region of the same underlying grid.
+ *
+ * @throws
+ *      std::exception or sub-class if x0,y0 or x1,y1 are not valid coordinates within the view
+ *      or if the crop window has a negative size.
+ */
+GridView GridView::crop(int x0, int y0, int x1, int y1) const {
+	if (x1 < x0 || y1 < y0) {
+		throw std::runtime_error("The crop window has a negative size");
+	}
+	//Testing the coordinates to not be out of bounds.
+	//If they are an error will be thrown.
+	get_index(x0, y0);
+	get_index(x1 - 1, y1 - 1);
+	return GridView(origin, stride, get_index(x0, y0), x1 - x0, y1 - y0);
+}
+
+/**
+ * GridView::rotate(rotation)
+ *
+ * Create a grid holding the cells of the view rotated by a multiple of 90 degrees.
+ * Behaves exactly like Grid::rotate.
+ *
+ * @param rotation
+ *      An positive or negative integer to rotate by in 90 intervals.
+ *
+ * @return
+ *      Returns a new grid containing the rotated cells.
+ */
+Grid GridView::rotate(int rotation) const {
+	//Calculate if the grid needs to be rotated 1,2 or 3 times and in which direction
+	//, for greater than 3,-3 degrees.
+	int times = ((rotation % 4) + 4) % 4;
+	Grid temp = (times % 2 == 1) ? Grid(num_rows, num_columns) : Grid(num_columns, num_rows);
+	Cell *cells = temp.data();
+	const int width = temp.get_width();
+	//Walk the source row by row and scatter each cell to its rotated position.
+	for (int j = 0; j < num_rows; j++) {
+		const Cell *source = row(j);
+		for (int i = 0; i < num_columns; i++) {
+			if (times == 1) {
+				cells[i * width + (num_rows - 1 - j)] = source[i];
+			} else if (times == 2) {
+				cells[(num_rows - 1 - j) * width + (num_columns - 1 - i)] = source[i];
+			} else if (times == 3) {
+				cells[(num_columns - 1 - i) * width + j] = source[i];
+			} else {
+				cells[j * width + i] = source[i];
+			}
+		}
+	}
+	return temp;
+}
+
+/**
+ * GridView::upscale(factor)
+ *
+ * Create a grid holding the cells of the view scaled up by a whole factor.
+ * Each source row is expanded once, run by run, then copied into the other factor - 1 rows of its blocks.
+ *
+ * @param factor
+ *      The width and height of the block each cell becomes, at least 1.
+ *
+ * @return
+ *      Returns a new grid containing the scaled up cells.
+ *
+ * @throws
+ *      Throws std::runtime_error if the factor is less than 1, or the scaled grid would be too large.
+ */
+Grid GridView::upscale(int factor) const {
+	if (factor < 1) {
+		throw std::runtime_error("The scale factor must be at least 1.");
+	}
+	if ((long long) num_columns * factor > INT_MAX || (long long) num_rows * factor > INT_MAX
+			|| (long long) num_columns * factor * num_rows * factor > INT_MAX) {
+		throw std::runtime_error("The scaled grid would be too large.");
+	}
+	Grid temp(num_columns * factor, num_rows * factor);
+	//An empty view has no rows to copy, and its empty rows would have no storage to copy from.
+	if (num_columns == 0 || num_rows == 0) {
+		return temp;
+	}
+	const std::size_t width = temp.get_width();
+	for (int j = 0; j < num_rows; j++) {
+		const Cell *source = row(j);
+		Cell *destination = temp.data() + j * factor * width;
+		for (int i = 0; i < num_columns; i++) {
+			std::memset(destination + i * factor, source[i], factor);
+		}
+		for (int k = 1; k < factor; k++) {
+			std::memcpy(destination + k * width, destination, width);
+		}
+	}
+	return temp;
+}
+
+/**
+ * GridView::downscale(factor, mode = Reduce::ANY)
+ *
+ * Create a grid holding the cells of the view scaled down by a whole factor.
+ *      - The scaled grid is the size of the view divided by the factor, rounded up, so blocks on the right and
+ *        bottom edges may be partial and are reduced over the cells they do have.
+ *      - Alive cells are counted block by block a row at a time into one counter per block, with no branches,
+ *        then every counter is reduced once its rows are done.
+ *
+ * @param factor
+ *      The width and height of the blocks reduced to one cell, at least 1.
+ *
+ * @param mode
+ *      Optional parameter. Whether a block becomes alive if any, most, or all of its cells are alive.
+ *      Defaults to Reduce::ANY.
+ *
+ * @return
+ *      Returns a new grid containing the scaled down cells.
+ *
+ * @throws
+ *      Throws std::runtime_error if the factor is less than 1.
+ */
+Grid GridView::downscale(int factor, Reduce mode) const {
+	if (factor < 1) {
+		throw std::runtime_error("The scale factor must be at least 1.");
+	}
+	const int width = (num_columns + factor - 1) / factor, height = (num_rows + factor - 1) / factor;
+	Grid temp(width, height);
+	static_assert(Cell::ALIVE % 2 == 1 && Cell::DEAD % 2 == 0, "Alive cells are counted by their lowest bit.");
+	std::vector<int> counts(width);
+	for (int y = 0; y < height; y++) {
+		std::fill(counts.begin(), counts.end(), 0);
+		const int rows = std::min(factor, num_rows - y * factor);
+		for (int j = 0; j < rows; j++) {
+			const Cell *source = row(y * factor + j);
+			for (int x = 0; x < width; x++) {
+				const Cell *block = source + x * factor, *end = source + std::min((x + 1) * factor, num_columns);
+				int count = 0;
+				for (; block < end; block++) {
+					count += *block & 1;
+				}
+				counts[x] += count;
+			}
+		}
+		Cell *destination = temp.data() + y * width;
+		for (int x = 0; x < width; x++) {
+			const int cells = rows * std::min(factor, num_columns - x * factor);
+			const bool alive = mode == Reduce::ANY ? counts[x] > 0 :
+								mode == Reduce::MAJORITY ? counts[x] * 2 > cells : counts[x] == cells;
+			destination[x] = alive ? Cell::ALIVE : Cell::DEAD;
+		}
+	}
+	return temp;
+}
+
+/**
+ * GridView::hash()
+ *
+ * Compute a 64 bit FNV-1a hash of the size and cells of the view.
+ * Equal views always hash equally, wherever their cells are stored, so hashes can be used
+ * to detect repeated states or duplicate patterns. Different views collide with negligible probability.
+ *
+ * @example
+ *
+ *      // A cropped region hashes the same as a copy of it
+ *      bool same = grid.crop(0, 0, 3, 3).hash() == Grid(grid.crop(0, 0, 3, 3)).hash();
+ *
+ * @return
+ *      Returns the hash.
+ */
+unsigned long long GridView::hash() const {
+	unsigned long long h = 14695981039346656037ull;
+	auto mix = [&h](unsigned long long value) {
+		h = (h ^ value) * 1099511628211ull;
+	};
+	mix((unsigned int) num_columns);
+	mix((unsigned int) num_rows);
+	for (int y = 0; y < num_rows; y++) {
+		const Cell *cells = row(y);
+		for (int x = 0; x < num_columns; x++) {
+			mix((unsigned char) cells[x]);
+		}
+	}
+	return h;
+}
+
+/**
+ * operator<<(output_stream, view)
+ *
+ * Serializes a view to an ascii output stream, in the same bordered format as a Grid.
+ * Rows are written whole, since cells are stored as their ascii characters.
+ *
+ * @param os
+ *      An ascii mode output stream such as std::cout.
+ *
+ * @param view
+ *      A view onto the cells to be printed.
+ *
+ * @return
+ *      Returns a reference to the output stream to enable operator chaining.
+ */
+std::ostream& operator<<(std::ostream &stream, const GridView &obj) {
+	const std::string border = '+' + std::string(obj.get_width(), '-') + "+\n";
+	stream << border;
 	for (int i = 0; i < obj.get_height(); i++) {
 		stream << '|';
-		for (int j = 0; j < obj.get_width(); j++) {
-			stream << (char) obj.get(j, i);
-		}
+		stream.write(reinterpret_cast<const char*>(obj.row(i)), obj.get_width());
 		stream << "|\n";
 	}
-	stream << '+';
-	for (int i = 0; i < obj.get_width(); i++) {
-		stream << '-';
-	}
-	stream << "+\n";
+	stream << border;
 	return stream;
 }
@@ -25,6 +25,49 @@ enum Cell : char {
 	DEAD = ' ', ALIVE = '#'
 };
 
+/**
+ * A Reduce says how a block of cells is reduced to a single cell when downscaling, alive if any, most, or all
+ * of the cells in the block are alive.
+ */
+enum class Reduce {
+	ANY, MAJORITY, ALL
+};
+
+class Grid;
+
+/**
+ * Declare the structure of the GridView class for a read-only window onto the cells of a Grid.
+ *
+ * A GridView does not own its cells, it is a pointer to the first cell of the window, the stride
+ * between rows of the underlying grid, and the width and height of the window.
+ *      - Views are cheap to copy and never copy cells.
+ *      - Views are invalidated when the grid they look at is resized or destroyed.
+ */
+class GridView {
+	const Cell *origin { };
+	int stride { }, num_columns { }, num_rows { };
+	int get_index(int x, int y) const;
+public:
+	GridView();
+	GridView(const Grid &grid);
+	GridView(const Cell *cells, int stride, int offset, int width, int height);
+	int get_width() const;
+	int get_height() const;
+	int get_stride() const;
+	int get_total_cells() const;
+	int get_alive_cells() const;
+	int get_dead_cells() const;
+	Cell get(int x, int y) const;
+	const Cell& operator()(int x, int y) const;
+	const Cell* row(int y) const;
+	GridView crop(int x0, int y0, int x1, int y1) const;
+	Grid rotate(int rotation) const;
+	Grid upscale(int factor) const;
+	Grid downscale(int factor, Reduce mode = Reduce::ANY) const;
+	unsigned long long hash() const;
+	friend std::ostream& operator<<(std::ostream &stream, const GridView &obj);
+};
+
 /**
  * Declare the structure of the Grid class for representing a 2d grid of cells.
  */
@@ -40,6 +83,7 @@ public:
 	~Grid();
 	explicit Grid(int square_size);
 	Grid(int width, int height);
+	Grid(const GridView &view);
 	int get_width() const;
 	int get_height() const;
 	int get_total_cells() const;
@@ -47,13 +91,20 @@ public:
 	int get_dead_cells() const;
 	void resize(int square_size);
 	void resize(int width, int height);
+	void assign(GridView view);
 	Cell get(int x, int y) const;
 	void set(int x, int y, Cell cell);
 	Cell& operator()(int x, int y);
 	const Cell& operator()(int x, int y) const;
-	Grid crop(int x0, int y0, int x1, int y1) const;
-	void merge(Grid other, int x0, int y0, bool alive_only = false);
+	Cell* data();
+	const Cell* data() const;
+	GridView crop(int x0, int y0, int x1, int y1) const;
+	void merge(GridView other, int x0, int y0, bool alive_only = false);
+	void shift(int dx, int dy);
+	void roll(int dx, int dy);
 	Grid rotate(int rotation) const;
+	Grid upscale(int factor) const;
+	Grid downscale(int factor, Reduce mode = Reduce::ANY) const;
 	friend std::ostream& operator<<(std::ostream &stream, const Grid &obj);
 };
 
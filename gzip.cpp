@@ -0,0 +1,717 @@
+/**
+ * Implements a Gzip namespace with stream buffers that inflate and deflate gzip streams on the fly.
+ *      - Gzip streams are a header, DEFLATE compressed data, and a trailer holding the CRC-32 and size
+ *        of the uncompressed data.
+ *          - https://tools.ietf.org/html/rfc1952
+ *          - https://tools.ietf.org/html/rfc1951
+ *
+ *      - Inflating is built in, so no library is needed, and streams, so files never need a temporary copy.
+ *          - Every block type is decoded, stored, fixed Huffman, and dynamic Huffman, and concatenated members
+ *            are read one after another as gzip itself does.
+ *          - Output is decoded into a 64KB window a block at a time and read straight from there, then the
+ *            last 32KB, the furthest a match can reach back, is slid to the front to make room for more.
+ *          - Huffman codes of up to 10 bits are decoded with one table lookup, longer codes a bit at a time.
+ *          - The CRC-32 and size are checked against the trailer.
+ *
+ *      - Deflating is built in too, compressing each 64KB written as a block of fixed Huffman codes.
+ *          - Matches are found greedily with hash chains over 3 byte prefixes, which suits the long runs
+ *            and repeated rows of a grid of cells far better than a general purpose compressor needs to.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#include "gzip.h"
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+//The furthest back a match can reach, and the most input deflated as one block.
+const std::size_t WINDOW = 1 << 15;
+const std::size_t BLOCK = 1 << 16;
+const int HASH_BITS = 15;
+const int MAX_CHAIN = 32;
+const int MIN_MATCH = 3, MAX_MATCH = 258;
+
+const int LENGTH_BASE[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115,
+		131, 163, 195, 227, 258 };
+const int LENGTH_EXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+const int DISTANCE_BASE[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025,
+		1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+const int DISTANCE_EXTRA[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12,
+		13, 13 };
+//The order the lengths of the code length code are stored in.
+const int CODE_LENGTH_ORDER[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+/**
+ * A CrcTable holds the CRC-32 of every byte, for the polynomial gzip uses.
+ */
+struct CrcTable {
+	std::uint32_t entries[256];
+	CrcTable() {
+		for (std::uint32_t n = 0; n < 256; n++) {
+			std::uint32_t c = n;
+			for (int k = 0; k < 8; k++) {
+				c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+			}
+			entries[n] = c;
+		}
+	}
+};
+
+/**
+ * update_crc(crc, bytes, count)
+ *
+ * Private helper to continue a CRC-32 over more bytes.
+ */
+std::uint32_t update_crc(std::uint32_t crc, const char *bytes, std::size_t count) {
+	static const CrcTable table;
+	std::uint32_t c = crc ^ 0xFFFFFFFFu;
+	for (std::size_t i = 0; i < count; i++) {
+		c = table.entries[(c ^ (unsigned char) bytes[i]) & 0xFF] ^ (c >> 8);
+	}
+	return c ^ 0xFFFFFFFFu;
+}
+
+/**
+ * reverse(code, length)
+ *
+ * Private helper to reverse the lowest length bits of a code, as Huffman codes are packed most significant bit first.
+ */
+int reverse(int code, int length) {
+	int reversed = 0;
+	for (int i = 0; i < length; i++) {
+		reversed = (reversed << 1) | ((code >> i) & 1);
+	}
+	return reversed;
+}
+
+}
+
+/**
+ * Gzip::is_gzip(source)
+ *
+ * Check if a seekable stream starts with the gzip magic number, leaving it where it was.
+ *
+ * @example
+ *
+ *      // Read a file whether or not it is compressed
+ *      std::ifstream file("path/to/file.gol.gz", std::ifstream::binary);
+ *      if (Gzip::is_gzip(file)) {
+ *          Gzip::InflateStream inflated(file);
+ *          ...
+ *      }
+ *
+ * @param source
+ *      The stream to check.
+ *
+ * @return
+ *      Returns true if the next two bytes are 0x1f 0x8b.
+ */
+bool Gzip::is_gzip(std::istream &source) {
+	const std::istream::pos_type start = source.tellg();
+	unsigned char magic[2] = { };
+	source.read(reinterpret_cast<char*>(magic), 2);
+	const bool gzip = source.gcount() == 2 && magic[0] == 0x1F && magic[1] == 0x8B;
+	source.clear();
+	source.seekg(start);
+	return gzip;
+}
+
+/**
+ * InflateBuffer::InflateBuffer(source)
+ *
+ * Construct a buffer decoding the gzip stream read from source, which must outlive it.
+ */
+Gzip::InflateBuffer::InflateBuffer(std::istream &source) :
+		source(source), window(2 * WINDOW) {
+	setg(window.data(), window.data(), window.data());
+}
+
+/**
+ * InflateBuffer::fill()
+ *
+ * Private method to move one more byte of input into the bit buffer.
+ *
+ * @return
+ *      Returns false if the input has ended.
+ */
+bool Gzip::InflateBuffer::fill() {
+	if (input_position == input_length) {
+		source.read(input, sizeof(input));
+		input_length = source.gcount();
+		input_position = 0;
+		if (input_length == 0) {
+			return false;
+		}
+	}
+	bit_buffer |= (std::uint64_t) (unsigned char) input[input_position++] << bit_count;
+	bit_count += 8;
+	return true;
+}
+
+/**
+ * InflateBuffer::bits(count)
+ *
+ * Private method to take up to 32 bits from the input, least significant bit first.
+ *
+ * @throws
+ *      Throws std::runtime_error if the input ends first.
+ */
+std::uint32_t Gzip::InflateBuffer::bits(int count) {
+	while (bit_count < count) {
+		if (!fill()) {
+			throw std::runtime_error("The gzip stream ended unexpectedly.");
+		}
+	}
+	const std::uint32_t value = bit_buffer & ((1ull << count) - 1);
+	bit_buffer >>= count;
+	bit_count -= count;
+	return value;
+}
+
+/**
+ * InflateBuffer::decode(code)
+ *
+ * Private method to decode one symbol of a Huffman code, with a single lookup if the code is short.
+ *
+ * @throws
+ *      Throws std::runtime_error if the input ends first or holds a code that is not in use.
+ */
+int Gzip::InflateBuffer::decode(const Huffman &code) {
+	while (bit_count < Huffman::FAST_BITS && fill()) {
+	}
+	const std::uint16_t entry = code.fast[bit_buffer & ((1u << Huffman::FAST_BITS) - 1)];
+	if (entry != 0 && (entry & 15) <= bit_count) {
+		bit_buffer >>= entry & 15;
+		bit_count -= entry & 15;
+		return entry >> 4;
+	}
+	//Walk the canonical code a bit at a time, the first code of each length follows the last of the one before.
+	int value = 0, first = 0, index = 0;
+	for (int length = 1; length <= 15; length++) {
+		value |= bits(1);
+		const int count = code.count[length];
+		if (value - count < first) {
+			return code.symbol[index + (value - first)];
+		}
+		index += count;
+		first = (first + count) << 1;
+		value <<= 1;
+	}
+	throw std::runtime_error("The gzip stream holds an invalid Huffman code.");
+}
+
+/**
+ * InflateBuffer::build(code, lengths, symbols)
+ *
+ * Private helper to build a canonical Huffman code from the code length of each symbol, 0 for unused symbols.
+ *
+ * @throws
+ *      Throws std::runtime_error if the lengths describe more codes than there are bit patterns.
+ */
+void Gzip::InflateBuffer::build(Huffman &code, const unsigned char *lengths, int symbols) {
+	std::fill(code.count, code.count + 16, 0);
+	for (int s = 0; s < symbols; s++) {
+		code.count[lengths[s]]++;
+	}
+	int left = 1;
+	for (int length = 1; length <= 15; length++) {
+		left = (left << 1) - code.count[length];
+		if (left < 0) {
+			throw std::runtime_error("The gzip stream holds an over-subscribed Huffman code.");
+		}
+	}
+	int offsets[16] = { };
+	for (int length = 1; length < 15; length++) {
+		offsets[length + 1] = offsets[length] + code.count[length];
+	}
+	code.symbol.assign(symbols, 0);
+	for (int s = 0; s < symbols; s++) {
+		if (lengths[s] != 0) {
+			code.symbol[offsets[lengths[s]]++] = s;
+		}
+	}
+	code.fast.assign(1 << Huffman::FAST_BITS, 0);
+	int value = 0, index = 0;
+	for (int length = 1; length <= Huffman::FAST_BITS; length++) {
+		for (int i = 0; i < code.count[length]; i++, value++) {
+			const std::uint16_t entry = code.symbol[index + i] << 4 | length;
+			for (int k = reverse(value, length); k < (1 << Huffman::FAST_BITS); k += 1 << length) {
+				code.fast[k] = entry;
+			}
+		}
+		index += code.count[length];
+		value <<= 1;
+	}
+}
+
+/**
+ * InflateBuffer::read_header()
+ *
+ * Private method to read the header of a gzip member, skipping the optional fields.
+ *
+ * @throws
+ *      Throws std::runtime_error if the input is not a gzip stream or is not DEFLATE compressed.
+ */
+void Gzip::InflateBuffer::read_header() {
+	if (bits(8) != 0x1F || bits(8) != 0x8B) {
+		throw std::runtime_error("The file is not a gzip stream.");
+	}
+	if (bits(8) != 8) {
+		throw std::runtime_error("The gzip stream uses an unsupported compression method.");
+	}
+	const std::uint32_t flags = bits(8);
+	//Skip the modification time, extra flags, and operating system.
+	bits(32);
+	bits(16);
+	if (flags & 4) {
+		for (std::uint32_t length = bits(16); length > 0; length--) {
+			bits(8);
+		}
+	}
+	//The file name and comment are zero terminated.
+	for (std::uint32_t flag : { 8u, 16u }) {
+		if (flags & flag) {
+			while (bits(8) != 0) {
+			}
+		}
+	}
+	if (flags & 2) {
+		bits(16);
+	}
+	crc = 0;
+	size = 0;
+	state = BLOCK;
+}
+
+/**
+ * InflateBuffer::read_block()
+ *
+ * Private method to read the header of a DEFLATE block, and build its codes.
+ *
+ * @throws
+ *      Throws std::runtime_error if the block header is malformed.
+ */
+void Gzip::InflateBuffer::read_block() {
+	last = bits(1);
+	const std::uint32_t type = bits(2);
+	if (type == 0) {
+		bits(bit_count % 8);
+		const std::uint32_t length = bits(16), complement = bits(16);
+		if (length != (~complement & 0xFFFF)) {
+			throw std::runtime_error("The gzip stream holds a malformed stored block.");
+		}
+		stored = length;
+		state = STORED;
+		return;
+	}
+	unsigned char lengths[286 + 30] = { };
+	if (type == 1) {
+		std::fill(lengths, lengths + 144, 8);
+		std::fill(lengths + 144, lengths + 256, 9);
+		std::fill(lengths + 256, lengths + 280, 7);
+		std::fill(lengths + 280, lengths + 288, 8);
+		build(literals, lengths, 288);
+		std::fill(lengths, lengths + 30, 5);
+		build(distances, lengths, 30);
+	} else if (type == 2) {
+		const int literal_count = bits(5) + 257, distance_count = bits(5) + 1, code_count = bits(4) + 4;
+		if (literal_count > 286 || distance_count > 30) {
+			throw std::runtime_error("The gzip stream holds too many codes.");
+		}
+		unsigned char code_lengths[19] = { };
+		for (int i = 0; i < code_count; i++) {
+			code_lengths[CODE_LENGTH_ORDER[i]] = bits(3);
+		}
+		Huffman lengths_code;
+		build(lengths_code, code_lengths, 19);
+		//Code lengths 16 to 18 repeat the previous length or zeros.
+		for (int index = 0; index < literal_count + distance_count;) {
+			const int symbol = decode(lengths_code);
+			if (symbol < 16) {
+				lengths[index++] = symbol;
+				continue;
+			}
+			int length = 0, repeat;
+			if (symbol == 16) {
+				if (index == 0) {
+					throw std::runtime_error("The gzip stream repeats a code length that does not exist.");
+				}
+				length = lengths[index - 1];
+				repeat = 3 + bits(2);
+			} else if (symbol == 17) {
+				repeat = 3 + bits(3);
+			} else {
+				repeat = 11 + bits(7);
+			}
+			if (index + repeat > literal_count + distance_count) {
+				throw std::runtime_error("The gzip stream holds too many code lengths.");
+			}
+			std::fill(lengths + index, lengths + index + repeat, length);
+			index += repeat;
+		}
+		if (lengths[256] == 0) {
+			throw std::runtime_error("The gzip stream holds a block without an end.");
+		}
+		build(literals, lengths, literal_count);
+		build(distances, lengths + literal_count, distance_count);
+	} else {
+		throw std::runtime_error("The gzip stream holds an invalid block type.");
+	}
+	state = CODES;
+}
+
+/**
+ * InflateBuffer::read_trailer()
+ *
+ * Private method to check the trailer of a gzip member, then look for another member.
+ *
+ * @throws
+ *      Throws std::runtime_error if the checksum or size of the output does not match the trailer.
+ */
+void Gzip::InflateBuffer::read_trailer() {
+	bits(bit_count % 8);
+	const std::uint32_t expected_crc = bits(32), expected_size = bits(32);
+	if (expected_crc != crc || expected_size != size) {
+		throw std::runtime_error("The gzip stream is corrupt, its checksum does not match.");
+	}
+	state = (bit_count == 0 && !fill()) ? DONE : HEADER;
+}
+
+/**
+ * InflateBuffer::emit(byte)
+ *
+ * Private method to append a byte to the window.
+ */
+void Gzip::InflateBuffer::emit(char byte) {
+	window[produced++] = byte;
+}
+
+/**
+ * InflateBuffer::underflow()
+ *
+ * Decode until the window is full or the stream ends, and make what was decoded readable.
+ *
+ * @return
+ *      Returns the next byte, or eof if the stream has ended.
+ *
+ * @throws
+ *      Throws std::runtime_error if the stream is malformed.
+ */
+Gzip::InflateBuffer::int_type Gzip::InflateBuffer::underflow() {
+	if (gptr() < egptr()) {
+		return traits_type::to_int_type(*gptr());
+	}
+	while (true) {
+		if (produced == window.size()) {
+			std::memmove(window.data(), window.data() + produced - WINDOW, WINDOW);
+			produced = WINDOW;
+		}
+		const std::size_t start = produced;
+		while (produced < window.size() && state != TRAILER && state != DONE) {
+			if (state == HEADER) {
+				read_header();
+			} else if (state == BLOCK) {
+				read_block();
+			} else if (state == STORED) {
+				for (; stored > 0 && produced < window.size(); stored--) {
+					emit(bits(8));
+				}
+				if (stored == 0) {
+					state = last ? TRAILER : BLOCK;
+				}
+			} else if (match_length > 0) {
+				for (; match_length > 0 && produced < window.size(); match_length--) {
+					emit(window[produced - match_distance]);
+				}
+			} else {
+				int symbol = decode(literals);
+				if (symbol < 256) {
+					emit(symbol);
+				} else if (symbol == 256) {
+					state = last ? TRAILER : BLOCK;
+				} else {
+					symbol -= 257;
+					if (symbol >= 29) {
+						throw std::runtime_error("The gzip stream holds an invalid length.");
+					}
+					match_length = LENGTH_BASE[symbol] + bits(LENGTH_EXTRA[symbol]);
+					const int distance = decode(distances);
+					if (distance >= 30) {
+						throw std::runtime_error("The gzip stream holds an invalid distance.");
+					}
+					match_distance = DISTANCE_BASE[distance] + bits(DISTANCE_EXTRA[distance]);
+					if ((std::size_t) match_distance > produced) {
+						throw std::runtime_error("The gzip stream refers back past its start.");
+					}
+				}
+			}
+		}
+		crc = update_crc(crc, window.data() + start, produced - start);
+		size += produced - start;
+		if (state == TRAILER) {
+			read_trailer();
+		}
+		if (produced > start) {
+			setg(window.data() + start, window.data() + start, window.data() + produced);
+			return traits_type::to_int_type(*gptr());
+		}
+		if (state == DONE) {
+			return traits_type::eof();
+		}
+	}
+}
+
+/**
+ * DeflateBuffer::DeflateBuffer(destination)
+ *
+ * Construct a buffer writing a gzip stream to destination, which must outlive it, starting with the header.
+ */
+Gzip::DeflateBuffer::DeflateBuffer(std::ostream &destination) :
+		destination(destination), head(1 << HASH_BITS), previous(BLOCK) {
+	pending.reserve(BLOCK);
+	//No file name or modification time, and an unknown operating system.
+	destination.write("\x1f\x8b\x08\x00\x00\x00\x00\x00\x00\xff", 10);
+}
+
+/**
+ * DeflateBuffer::~DeflateBuffer()
+ *
+ * Finish the stream if it was not finished, ignoring any errors.
+ */
+Gzip::DeflateBuffer::~DeflateBuffer() {
+	try {
+		finish();
+	} catch (const std::exception&) {
+	}
+}
+
+/**
+ * DeflateBuffer::put_bits(value, count)
+ *
+ * Private method to append bits to the output, least significant bit first.
+ */
+void Gzip::DeflateBuffer::put_bits(std::uint32_t value, int count) {
+	bit_buffer |= (std::uint64_t) value << bit_count;
+	bit_count += count;
+	while (bit_count >= 8) {
+		output.push_back((char) (bit_buffer & 0xFF));
+		bit_buffer >>= 8;
+		bit_count -= 8;
+	}
+}
+
+/**
+ * DeflateBuffer::put_code(code, length)
+ *
+ * Private method to append a Huffman code, most significant bit first.
+ */
+void Gzip::DeflateBuffer::put_code(int code, int length) {
+	put_bits(reverse(code, length), length);
+}
+
+/**
+ * DeflateBuffer::put_literal(symbol)
+ *
+ * Private method to append a literal or length symbol in the fixed Huffman code.
+ */
+void Gzip::DeflateBuffer::put_literal(int symbol) {
+	if (symbol < 144) {
+		put_code(0x30 + symbol, 8);
+	} else if (symbol < 256) {
+		put_code(0x190 + symbol - 144, 9);
+	} else if (symbol < 280) {
+		put_code(symbol - 256, 7);
+	} else {
+		put_code(0xC0 + symbol - 280, 8);
+	}
+}
+
+/**
+ * DeflateBuffer::compress(final_block)
+ *
+ * Private method to compress everything pending as one block of fixed Huffman codes, and write it out.
+ */
+void Gzip::DeflateBuffer::compress(bool final_block) {
+	const char *data = pending.data();
+	const int count = pending.size();
+	crc = update_crc(crc, data, count);
+	size += count;
+	put_bits(final_block ? 1 : 0, 1);
+	put_bits(1, 2);
+	std::fill(head.begin(), head.end(), -1);
+	auto hash = [data](int position) {
+		return ((unsigned char) data[position] << 10 ^ (unsigned char) data[position + 1] << 5
+				^ (unsigned char) data[position + 2]) & ((1 << HASH_BITS) - 1);
+	};
+	auto insert = [&](int position) {
+		const int key = hash(position);
+		previous[position] = head[key];
+		head[key] = position;
+	};
+	for (int i = 0; i < count;) {
+		int best = 0, distance = 0;
+		if (i + MIN_MATCH <= count) {
+			const int limit = std::min(MAX_MATCH, count - i);
+			int chain = MAX_CHAIN;
+			for (int candidate = head[hash(i)]; candidate >= 0 && i - candidate <= (int) WINDOW && chain-- > 0;
+					candidate = previous[candidate]) {
+				int length = 0;
+				while (length < limit && data[candidate + length] == data[i + length]) {
+					length++;
+				}
+				if (length > best) {
+					best = length;
+					distance = i - candidate;
+					if (length == limit) {
+						break;
+					}
+				}
+			}
+			insert(i);
+		}
+		if (best < MIN_MATCH) {
+			put_literal((unsigned char) data[i]);
+			i++;
+			continue;
+		}
+		int code = 28;
+		while (LENGTH_BASE[code] > best) {
+			code--;
+		}
+		put_literal(257 + code);
+		put_bits(best - LENGTH_BASE[code], LENGTH_EXTRA[code]);
+		code = 29;
+		while (DISTANCE_BASE[code] > distance) {
+			code--;
+		}
+		put_code(code, 5);
+		put_bits(distance - DISTANCE_BASE[code], DISTANCE_EXTRA[code]);
+		for (int j = i + 1; j < i + best && j + MIN_MATCH <= count; j++) {
+			insert(j);
+		}
+		i += best;
+	}
+	put_literal(256);
+	pending.clear();
+	destination.write(output.data(), output.size());
+	output.clear();
+}
+
+/**
+ * DeflateBuffer::overflow(byte)
+ *
+ * Take a byte, compressing a block once 64KB is pending.
+ */
+Gzip::DeflateBuffer::int_type Gzip::DeflateBuffer::overflow(int_type byte) {
+	if (traits_type::eq_int_type(byte, traits_type::eof())) {
+		return traits_type::not_eof(byte);
+	}
+	pending.push_back(traits_type::to_char_type(byte));
+	if (pending.size() == BLOCK) {
+		compress(false);
+	}
+	return byte;
+}
+
+/**
+ * DeflateBuffer::xsputn(bytes, count)
+ *
+ * Take many bytes at once, compressing a block every time 64KB is pending.
+ */
+std::streamsize Gzip::DeflateBuffer::xsputn(const char *bytes, std::streamsize count) {
+	for (std::streamsize written = 0; written < count;) {
+		const std::streamsize chunk = std::min<std::streamsize>(count - written, BLOCK - pending.size());
+		pending.insert(pending.end(), bytes + written, bytes + written + chunk);
+		written += chunk;
+		if (pending.size() == BLOCK) {
+			compress(false);
+		}
+	}
+	return count;
+}
+
+/**
+ * DeflateBuffer::finish()
+ *
+ * Compress whatever is pending as the final block and write the trailer. Nothing can be written after.
+ */
+void Gzip::DeflateBuffer::finish() {
+	if (finished) {
+		return;
+	}
+	finished = true;
+	compress(true);
+	if (bit_count > 0) {
+		put_bits(0, 8 - bit_count);
+	}
+	for (std::uint32_t value : { crc, size }) {
+		for (int byte = 0; byte < 4; byte++) {
+			output.push_back((char) ((value >> (byte * 8)) & 0xFF));
+		}
+	}
+	destination.write(output.data(), output.size());
+	output.clear();
+}
+
+/**
+ * InflateStream::InflateStream(source)
+ *
+ * Construct a stream reading the decompressed contents of the gzip stream read from source.
+ *
+ * @example
+ *
+ *      // Count the lines of a compressed file without decompressing it to disc
+ *      std::ifstream file("path/to/file.gol.gz", std::ifstream::binary);
+ *      Gzip::InflateStream inflated(file);
+ *      std::string line;
+ *      int lines = 0;
+ *      while (std::getline(inflated, line)) {
+ *          lines++;
+ *      }
+ *
+ * @param source
+ *      The stream to decompress, which must outlive this stream.
+ */
+Gzip::InflateStream::InflateStream(std::istream &source) :
+		std::istream(nullptr), buffer(source) {
+	rdbuf(&buffer);
+	//Rethrow the errors of the buffer as they are, rather than only setting badbit.
+	exceptions(std::ios::badbit);
+}
+
+/**
+ * DeflateStream::DeflateStream(destination)
+ *
+ * Construct a stream compressing whatever is written to it into a gzip stream written to destination.
+ *
+ * @example
+ *
+ *      // Write a compressed file
+ *      std::ofstream file("path/to/file.gol.gz", std::ofstream::binary);
+ *      Gzip::DeflateStream deflated(file);
+ *      deflated << "3 3\n";
+ *      ...
+ *      deflated.finish();
+ *
+ * @param destination
+ *      The stream to write the compressed stream to, which must outlive this stream.
+ */
+Gzip::DeflateStream::DeflateStream(std::ostream &destination) :
+		std::ostream(nullptr), buffer(destination) {
+	rdbuf(&buffer);
+}
+
+/**
+ * DeflateStream::finish()
+ *
+ * Write the end of the gzip stream. Check the destination stream afterwards for errors.
+ */
+void Gzip::DeflateStream::finish() {
+	buffer.finish();
+}
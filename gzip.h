@@ -0,0 +1,121 @@
+/**
+ * Declares a Gzip namespace with stream buffers that inflate and deflate gzip streams on the fly.
+ * Rich documentation for the api and behaviour the Gzip namespace can be found in gzip.cpp.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the namespace.
+// #include ...
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+/**
+ * Declare the interface of the Gzip namespace for reading and writing gzip streams without a temporary file.
+ */
+namespace Gzip {
+
+bool is_gzip(std::istream &source);
+
+/**
+ * An InflateBuffer decodes a gzip stream read from another stream, a block of output at a time.
+ * Only the last 32KB of output, the most a match can reach back, is kept between blocks.
+ */
+class InflateBuffer : public std::streambuf {
+	/**
+	 * A Huffman code, as the number of codes of each length and the symbols in code order,
+	 * with a table to decode codes of up to FAST_BITS bits in one lookup.
+	 */
+	struct Huffman {
+		static const int FAST_BITS = 10;
+		short count[16];
+		std::vector<short> symbol;
+		//The symbol << 4 | length of the code in the low FAST_BITS bits, or 0 if it is longer.
+		std::vector<std::uint16_t> fast;
+	};
+	enum State {
+		HEADER, BLOCK, STORED, CODES, TRAILER, DONE
+	};
+
+	std::istream &source;
+	char input[1 << 14];
+	std::size_t input_position { }, input_length { };
+	std::uint64_t bit_buffer { };
+	int bit_count { };
+	std::vector<char> window;
+	std::size_t produced { };
+	State state { HEADER };
+	bool last { };
+	std::size_t stored { };
+	int match_length { }, match_distance { };
+	Huffman literals, distances;
+	std::uint32_t crc { }, size { };
+
+	bool fill();
+	std::uint32_t bits(int count);
+	int decode(const Huffman &code);
+	static void build(Huffman &code, const unsigned char *lengths, int symbols);
+	void read_header();
+	void read_block();
+	void read_trailer();
+	void emit(char byte);
+protected:
+	int_type underflow() override;
+public:
+	explicit InflateBuffer(std::istream &source);
+};
+
+/**
+ * A DeflateBuffer encodes everything written to it as a gzip stream written to another stream,
+ * compressing 64KB at a time.
+ */
+class DeflateBuffer : public std::streambuf {
+	std::ostream &destination;
+	std::vector<char> pending, output;
+	std::vector<int> head, previous;
+	std::uint64_t bit_buffer { };
+	int bit_count { };
+	std::uint32_t crc { }, size { };
+	bool finished { };
+
+	void put_bits(std::uint32_t value, int count);
+	void put_code(int code, int length);
+	void put_literal(int symbol);
+	void compress(bool final_block);
+protected:
+	int_type overflow(int_type byte) override;
+	std::streamsize xsputn(const char *bytes, std::streamsize count) override;
+public:
+	explicit DeflateBuffer(std::ostream &destination);
+	~DeflateBuffer();
+	void finish();
+};
+
+/**
+ * An InflateStream is an std::istream reading the decompressed contents of a gzip stream.
+ * Errors in the compressed data are thrown as std::runtime_error from the read that found them.
+ */
+class InflateStream : public std::istream {
+	InflateBuffer buffer;
+public:
+	explicit InflateStream(std::istream &source);
+};
+
+/**
+ * A DeflateStream is an std::ostream compressing whatever is written to it as a gzip stream.
+ * DeflateStream::finish must be called to write the end of the stream, or it is written on destruction.
+ */
+class DeflateStream : public std::ostream {
+	DeflateBuffer buffer;
+public:
+	explicit DeflateStream(std::ostream &destination);
+	void finish();
+};
+
+}
+;
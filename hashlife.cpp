@@ -0,0 +1,986 @@
+/**
+ * Implements a class representing a Game of Life on an unbounded plane, simulated with Gosper's HashLife algorithm.
+ *      - The plane is a quadtree of nodes. A node at level k is a 2^k x 2^k square made of 4 nodes at level k - 1,
+ *        and a node at level 0 is a single cell.
+ *      - Nodes are hash-consed, every distinct square is stored once in a node table, so repeated regions
+ *        of a pattern, in space and in time, share storage.
+ *
+ *      - The result of a node at level k is its centre 2^(k-1) x 2^(k-1) square advanced 2^step steps,
+ *        where step is at most k - 2. Results are memoised in the node, so a square is only ever stepped once.
+ *          - With step = k - 2 the result is built from 9 overlapping sub-results each advanced 2^(k-3) steps,
+ *            then from 4 sub-results of those advanced another 2^(k-3) steps.
+ *          - With a smaller step the 9 overlapping squares are not advanced, only the 4 sub-results are.
+ *          - Level 2 nodes are stepped once with a precomputed table of every 4x4 square.
+ *
+ *      - Advancing n steps performs one power of two step per bit set in n. Before each, the plane is
+ *        grown with empty borders until the pattern fits in the centre quarter and the root is at least
+ *        3 levels above the step, so nothing can grow past the edge of the result.
+ *
+ *      - The recursion can run across a ThreadPool.
+ *          - Nodes at FORK_LEVEL and above submit their 9 and then 4 sub-results as tasks and help run
+ *            queued tasks until they finish, with ThreadPool::run_one.
+ *          - The node table is split into STRIPES independently locked parts, chosen by the hash of a key,
+ *            so threads only contend when creating nodes whose keys hash to the same stripe.
+ *          - Nodes are allocated from an atomic counter into fixed size chunks, so a node never moves and
+ *            can be read without locking once its index is known.
+ *          - Memoised results are published with release and acquire ordering, two threads stepping the same
+ *            node at once compute the same canonical result.
+ *
+ *      - Memory can be capped with HashLife::set_memory_limit.
+ *          - Unreachable nodes are freed by a mark and sweep collection, which compacts the surviving nodes
+ *            to the front of the chunks, keeping children before their parents, and rebuilds the node table.
+ *          - Collections run between power of two steps, once the estimated memory passes 3/4 of the limit.
+ *            The first keeps the memoised results of surviving nodes, if that frees too little the result
+ *            cache is evicted as well.
+ *          - A step that reaches the limit part way through is abandoned, the plane is unchanged, and it is
+ *            retried after a collection, as two steps of half the size if it still does not fit.
+ *          - HashLife::get_statistics reports the nodes, memory, result cache hits, and collection pauses.
+ *
+ *      - The node table and its memoised results can be saved to a cache file and loaded by a later run,
+ *        so sub-results already known are never recomputed, HashLife::save_cache and HashLife::load_cache.
+ *          - The file is a 32 byte header followed by a flat array of 24 byte records, one per node, so it can
+ *            be mapped straight into memory. Records are in index order, children always before parents.
+ *              - Header: the magic "GOLHASH1", the birth and survival masks of the rule as uint32,
+ *                the number of records as uint64, and 8 reserved zero bytes.
+ *              - Record: the 4 child indices as uint32, then the memo as uint64, as in memory.
+ *              - Indices 0 and 1 are the dead and alive cells and have no records, the first record is index 2.
+ *              - Integers are in the byte order of the machine that wrote them.
+ *          - The file is keyed by rule, a cache for another rule is ignored.
+ *          - Loading maps the file and joins every record into the node table, so it can be loaded into
+ *            a plane that already has nodes, or with a different set of indices.
+ *
+ *      - Rules where cells are born with 0 neighbours are not supported, the empty plane would not stay empty.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#include "hashlife.h"
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * Thrown part way through a step when the memory limit is reached, so the step can be retried after a collection.
+ */
+struct MemoryLimit: public std::runtime_error {
+	MemoryLimit() :
+			std::runtime_error("The HashLife memory limit was reached.") {
+	}
+};
+
+const char CACHE_MAGIC[8] = { 'G', 'O', 'L', 'H', 'A', 'S', 'H', '1' };
+
+/**
+ * The header of a cache file.
+ */
+struct CacheHeader {
+	char magic[8];
+	std::uint32_t birth, survival;
+	std::uint64_t records;
+	std::uint64_t reserved;
+};
+
+/**
+ * A record of a cache file, one node.
+ */
+struct CacheRecord {
+	std::uint32_t child[4];
+	std::uint64_t memo;
+};
+
+/**
+ * fork(count, pool, body)
+ *
+ * Private helper to run body(0) to body(count - 1), across a pool if one is given, rethrowing the first exception.
+ */
+template<typename Body>
+void fork(int count, ThreadPool *pool, Body body) {
+	if (pool == nullptr) {
+		for (int i = 0; i < count; i++) {
+			body(i);
+		}
+		return;
+	}
+	std::atomic<int> remaining(count - 1);
+	std::exception_ptr error;
+	std::mutex error_lock;
+	for (int i = 1; i < count; i++) {
+		pool->submit([&, i](int) {
+			try {
+				body(i);
+			} catch (...) {
+				std::lock_guard<std::mutex> guard(error_lock);
+				error = std::current_exception();
+			}
+			remaining--;
+		});
+	}
+	try {
+		body(0);
+	} catch (...) {
+		std::lock_guard<std::mutex> guard(error_lock);
+		error = std::current_exception();
+	}
+	while (remaining > 0) {
+		if (!pool->run_one()) {
+			std::this_thread::yield();
+		}
+	}
+	if (error) {
+		std::rethrow_exception(error);
+	}
+}
+
+}
+
+bool HashLife::Key::operator==(const Key &other) const {
+	return child[0] == other.child[0] && child[1] == other.child[1] && child[2] == other.child[2]
+			&& child[3] == other.child[3];
+}
+
+std::size_t HashLife::KeyHash::operator()(const Key &key) const {
+	std::uint64_t hash = ((std::uint64_t) key.child[0] << 32 | key.child[1]) * 0x9e3779b97f4a7c15ULL;
+	hash ^= ((std::uint64_t) key.child[2] << 32 | key.child[3]) + 0x632be59bd9b4e019ULL + (hash << 6) + (hash >> 2);
+	hash ^= hash >> 31;
+	hash *= 0xbf58476d1ce4e5b9ULL;
+	return hash ^ (hash >> 29);
+}
+
+/**
+ * HashLife::HashLife(rule)
+ *
+ * Construct an empty plane.
+ *
+ * @example
+ *
+ *      // Make a plane, load a pattern, and jump a billion steps ahead
+ *      HashLife life;
+ *      life.set_state(Zoo::glider());
+ *      life.advance(1000000000);
+ *
+ * @param rule
+ *      Optional parameter. The rule to simulate. Defaults to B3/S23.
+ *
+ * @throws
+ *      Throws std::runtime_error if the rule gives birth to cells with 0 neighbours.
+ */
+HashLife::HashLife(const Rule &rule) :
+		rule(rule), chunks(new std::atomic<Node*>[MAX_CHUNKS]), count(0), stripes(new Stripe[STRIPES]), root(0),
+		origin_x(0), origin_y(0), generation(0), limit(0), hits(0), misses(0) {
+	if (rule.is_born(0)) {
+		throw std::runtime_error("HashLife cannot simulate rules with births on 0 neighbours.");
+	}
+	for (int i = 0; i < MAX_CHUNKS; i++) {
+		chunks[i].store(nullptr);
+	}
+	//Index 0 is the dead cell and index 1 is the alive cell.
+	for (int alive = 0; alive < 2; alive++) {
+		Node &leaf = node(allocate());
+		leaf.child[0] = leaf.child[1] = leaf.child[2] = leaf.child[3] = 0;
+		leaf.population = alive;
+		leaf.level = 0;
+		leaf.memo.store(0);
+	}
+	empty.push_back(0);
+	for (int level = 1; level < 63; level++) {
+		empty.push_back(join(empty.back(), empty.back(), empty.back(), empty.back()));
+	}
+	//Step every 4x4 square once, bit y * 4 + x is the cell (x, y), and the result bits are nw, ne, sw, se.
+	for (int square = 0; square < (1 << 16); square++) {
+		base[square] = 0;
+		for (int i = 0; i < 4; i++) {
+			const int cx = 1 + (i & 1), cy = 1 + (i >> 1);
+			int neighbours = 0;
+			for (int dy = -1; dy <= 1; dy++) {
+				for (int dx = -1; dx <= 1; dx++) {
+					if (dx != 0 || dy != 0) {
+						neighbours += (square >> ((cy + dy) * 4 + cx + dx)) & 1;
+					}
+				}
+			}
+			const bool alive = (square >> (cy * 4 + cx)) & 1;
+			if (alive ? rule.survives(neighbours) : rule.is_born(neighbours)) {
+				base[square] |= 1 << i;
+			}
+		}
+	}
+	root = empty[3];
+}
+
+/**
+ * HashLife::~HashLife()
+ *
+ * Free every chunk of nodes.
+ */
+HashLife::~HashLife() {
+	for (int i = 0; i < MAX_CHUNKS; i++) {
+		delete[] chunks[i].load();
+	}
+}
+
+/**
+ * HashLife::node(index)
+ *
+ * Private method to get the node stored at an index.
+ */
+HashLife::Node& HashLife::node(Index index) const {
+	return chunks[index >> CHUNK_BITS].load(std::memory_order_acquire)[index & ((1 << CHUNK_BITS) - 1)];
+}
+
+/**
+ * HashLife::allocate()
+ *
+ * Private method to reserve the index of a new node, allocating a new chunk of nodes when one fills up.
+ *
+ * Indices are never handed back when allocation fails, so concurrent allocations never share an index,
+ * the unused indices are reclaimed by the next collection.
+ *
+ * @throws
+ *      Throws std::runtime_error if every index is in use, or MemoryLimit if the memory limit is reached.
+ */
+HashLife::Index HashLife::allocate() {
+	const std::uint64_t index = count.fetch_add(1);
+	if (index >= 0xffffffffULL) {
+		throw std::runtime_error("The HashLife node table is full.");
+	}
+	if (limit != 0 && (index + 1) * bytes_per_node() > limit) {
+		throw MemoryLimit();
+	}
+	std::atomic<Node*> &chunk = chunks[index >> CHUNK_BITS];
+	if (chunk.load(std::memory_order_acquire) == nullptr) {
+		std::lock_guard<std::mutex> guard(chunk_lock);
+		if (chunk.load(std::memory_order_relaxed) == nullptr) {
+			chunk.store(new Node[1 << CHUNK_BITS], std::memory_order_release);
+		}
+	}
+	return (Index) index;
+}
+
+/**
+ * HashLife::join(nw, ne, sw, se)
+ *
+ * Private method to get the canonical node made of 4 quadrants, creating it if it is new.
+ */
+HashLife::Index HashLife::join(Index nw, Index ne, Index sw, Index se) {
+	const Key key = { { nw, ne, sw, se } };
+	const std::size_t hash = KeyHash()(key);
+	Stripe &stripe = stripes[hash % STRIPES];
+	std::lock_guard<std::mutex> guard(stripe.lock);
+	auto found = stripe.table.find(key);
+	if (found != stripe.table.end()) {
+		return found->second;
+	}
+	const Index index = allocate();
+	Node &created = node(index);
+	created.child[0] = nw;
+	created.child[1] = ne;
+	created.child[2] = sw;
+	created.child[3] = se;
+	created.population = node(nw).population + node(ne).population + node(sw).population + node(se).population;
+	created.level = node(nw).level + 1;
+	created.memo.store(0, std::memory_order_relaxed);
+	stripe.table.emplace(key, index);
+	return index;
+}
+
+/**
+ * HashLife::centre(index)
+ *
+ * Private method to get the centre square of a node, one level down.
+ */
+HashLife::Index HashLife::centre(Index index) {
+	const Node &n = node(index);
+	return join(node(n.child[0]).child[3], node(n.child[1]).child[2], node(n.child[2]).child[1],
+			node(n.child[3]).child[0]);
+}
+
+/**
+ * HashLife::centre_horizontal(west, east)
+ *
+ * Private method to get the square straddling the border between two side by side nodes, at the same level.
+ */
+HashLife::Index HashLife::centre_horizontal(Index west, Index east) {
+	const Node &w = node(west), &e = node(east);
+	return join(w.child[1], e.child[0], w.child[3], e.child[2]);
+}
+
+/**
+ * HashLife::centre_vertical(north, south)
+ *
+ * Private method to get the square straddling the border between two stacked nodes, at the same level.
+ */
+HashLife::Index HashLife::centre_vertical(Index north, Index south) {
+	const Node &n = node(north), &s = node(south);
+	return join(n.child[2], n.child[3], s.child[0], s.child[1]);
+}
+
+/**
+ * HashLife::next(index, step, pool)
+ *
+ * Private method to get the centre of a node advanced 2^step steps, memoised in the node.
+ *
+ * @param index
+ *      The node, at level 2 or above.
+ *
+ * @param step
+ *      The log2 of the number of steps, at most the level of the node minus 2.
+ *
+ * @param pool
+ *      The pool to fork sub-results across, or nullptr. Must only be given when running on one of its workers.
+ */
+HashLife::Index HashLife::next(Index index, int step, ThreadPool *pool) {
+	Node &n = node(index);
+	if (n.population == 0) {
+		return empty[n.level - 1];
+	}
+	const std::uint64_t memo = n.memo.load(std::memory_order_acquire);
+	if (memo != 0 && (int) (memo & 0xff) == step + 1) {
+		hits.fetch_add(1, std::memory_order_relaxed);
+		return (Index) (memo >> 8);
+	}
+	misses.fetch_add(1, std::memory_order_relaxed);
+	Index result;
+	if (n.level == 2) {
+		//Gather the 16 cells of the square and look up the next state of its centre.
+		int square = 0;
+		for (int q = 0; q < 4; q++) {
+			const Node &quadrant = node(n.child[q]);
+			for (int c = 0; c < 4; c++) {
+				const int x = (q & 1) * 2 + (c & 1), y = (q >> 1) * 2 + (c >> 1);
+				square |= (int) quadrant.child[c] << (y * 4 + x);
+			}
+		}
+		const int cells = base[square];
+		result = join(cells & 1, (cells >> 1) & 1, (cells >> 2) & 1, (cells >> 3) & 1);
+	} else {
+		ThreadPool *forked = n.level >= FORK_LEVEL ? pool : nullptr;
+		const bool fast = step == n.level - 2;
+		const Index nw = n.child[0], ne = n.child[1], sw = n.child[2], se = n.child[3];
+		const Index sub[9] = { nw, centre_horizontal(nw, ne), ne, centre_vertical(nw, sw), centre(index),
+				centre_vertical(ne, se), sw, centre_horizontal(sw, se), se };
+		Index part[9], out[4];
+		if (fast) {
+			fork(9, forked, [&](int i) {
+				part[i] = next(sub[i], step - 1, forked);
+			});
+		} else {
+			for (int i = 0; i < 9; i++) {
+				part[i] = centre(sub[i]);
+			}
+		}
+		const Index quad[4] = { join(part[0], part[1], part[3], part[4]), join(part[1], part[2], part[4], part[5]),
+				join(part[3], part[4], part[6], part[7]), join(part[4], part[5], part[7], part[8]) };
+		fork(4, forked, [&](int i) {
+			out[i] = next(quad[i], fast ? step - 1 : step, forked);
+		});
+		result = join(out[0], out[1], out[2], out[3]);
+	}
+	n.memo.store((std::uint64_t) result << 8 | (std::uint64_t) (step + 1), std::memory_order_release);
+	return result;
+}
+
+/**
+ * HashLife::build(grid, x, y, level)
+ *
+ * Private method to build the node for the square of a grid with its top left corner at (x, y).
+ * Cells outside the grid are dead.
+ */
+HashLife::Index HashLife::build(const GridView &grid, long long x, long long y, int level) {
+	if (x >= grid.get_width() || y >= grid.get_height()) {
+		return empty[level];
+	}
+	if (level == 0) {
+		return grid(x, y) == Cell::ALIVE ? 1 : 0;
+	}
+	const long long half = 1LL << (level - 1);
+	return join(build(grid, x, y, level - 1), build(grid, x + half, y, level - 1),
+			build(grid, x, y + half, level - 1), build(grid, x + half, y + half, level - 1));
+}
+
+/**
+ * HashLife::draw(index, x, y, grid, x0, y0)
+ *
+ * Private method to set the alive cells of a node with its top left corner at (x, y) in a grid whose top left
+ * corner is at (x0, y0), skipping empty nodes and nodes outside the grid.
+ */
+void HashLife::draw(Index index, long long x, long long y, Grid &grid, long long x0, long long y0) const {
+	const Node &n = node(index);
+	const long long size = 1LL << n.level;
+	if (n.population == 0 || x >= x0 + grid.get_width() || y >= y0 + grid.get_height() || x + size <= x0
+			|| y + size <= y0) {
+		return;
+	}
+	if (n.level == 0) {
+		grid.set(x - x0, y - y0, Cell::ALIVE);
+		return;
+	}
+	const long long half = size / 2;
+	draw(n.child[0], x, y, grid, x0, y0);
+	draw(n.child[1], x + half, y, grid, x0, y0);
+	draw(n.child[2], x, y + half, grid, x0, y0);
+	draw(n.child[3], x + half, y + half, grid, x0, y0);
+}
+
+/**
+ * HashLife::expand()
+ *
+ * Private method to double the size of the plane, surrounding the root with empty space.
+ *
+ * @throws
+ *      Throws std::runtime_error if the plane would be too big to address.
+ */
+void HashLife::expand() {
+	const Node &n = node(root);
+	if (n.level >= 60) {
+		throw std::runtime_error("The HashLife plane is too big.");
+	}
+	const Index e = empty[n.level - 1];
+	const Index nw = n.child[0], ne = n.child[1], sw = n.child[2], se = n.child[3];
+	const long long quarter = 1LL << (n.level - 1);
+	root = join(join(e, e, e, nw), join(e, e, ne, e), join(e, sw, e, e), join(se, e, e, e));
+	origin_x -= quarter;
+	origin_y -= quarter;
+}
+
+/**
+ * HashLife::step(step, pool)
+ *
+ * Private method to advance the plane 2^step steps, then shrink it while the pattern fits in its centre.
+ * The root, origin and generation are only changed once the step has succeeded, so a step that runs out of
+ * memory can be retried after a collection.
+ */
+void HashLife::step(int step, ThreadPool *pool) {
+	while (node(root).level < step + 3 || node(centre(centre(root))).population != node(root).population) {
+		expand();
+	}
+	const int level = node(root).level;
+	Index result = 0;
+	if (pool == nullptr) {
+		result = next(root, step, nullptr);
+	} else {
+		//Run the root on a worker, so forked sub-results can be joined with ThreadPool::run_one.
+		std::exception_ptr error;
+		pool->submit([&](int) {
+			try {
+				result = next(root, step, pool);
+			} catch (...) {
+				error = std::current_exception();
+			}
+		});
+		pool->wait();
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+	long long offset = 1LL << (level - 2);
+	//Shrinking is optional, so running out of memory while centring keeps the bigger root rather than
+	//throwing, which would have the step taken again on top of this one.
+	try {
+		while (node(result).level > 3) {
+			const Index middle = centre(result);
+			if (node(middle).population != node(result).population) {
+				break;
+			}
+			offset += 1LL << (node(result).level - 2);
+			result = middle;
+		}
+	} catch (const MemoryLimit&) {
+	}
+	root = result;
+	origin_x += offset;
+	origin_y += offset;
+	generation += 1ULL << step;
+}
+
+/**
+ * HashLife::budgeted_step(step, pool)
+ *
+ * Private method to advance the plane 2^step steps within the memory limit, collecting garbage before and
+ * after as needed, and splitting the step in two if it does not fit even after a collection.
+ *
+ * @throws
+ *      Throws std::runtime_error if a single step does not fit in the memory limit.
+ */
+void HashLife::budgeted_step(int step, ThreadPool *pool) {
+	bool fits = true;
+	try {
+		this->step(step, pool);
+	} catch (const MemoryLimit&) {
+		fits = false;
+	}
+	if (!fits) {
+		collect(false);
+		try {
+			this->step(step, pool);
+			fits = true;
+		} catch (const MemoryLimit&) {
+			if (step == 0) {
+				throw std::runtime_error("The HashLife memory limit is too small for the pattern.");
+			}
+		}
+		if (!fits) {
+			collect(false);
+			budgeted_step(step - 1, pool);
+			budgeted_step(step - 1, pool);
+			return;
+		}
+	}
+	if (limit != 0 && count * bytes_per_node() > limit / 4 * 3) {
+		collect(true);
+		if (count * bytes_per_node() > limit / 2) {
+			collect(false);
+		}
+	}
+}
+
+/**
+ * HashLife::bytes_per_node()
+ *
+ * Private method estimating the memory used by each node, its storage in a chunk and its entry in the node table.
+ */
+std::size_t HashLife::bytes_per_node() {
+	return sizeof(Node) + sizeof(std::pair<const Key, Index>) + 3 * sizeof(void*);
+}
+
+/**
+ * HashLife::get_rule()
+ *
+ * Gets the rule being simulated.
+ */
+const Rule& HashLife::get_rule() const {
+	return rule;
+}
+
+/**
+ * HashLife::set_state(state)
+ *
+ * Replace the plane with a grid, with the top left corner of the grid at (0, 0) and every cell outside it dead.
+ * The generation is reset to 0. Nodes already in the table are kept, so patterns seen before step quickly.
+ *
+ * @param state
+ *      The grid, or a view onto a region of a grid, to load.
+ */
+void HashLife::set_state(GridView state) {
+	int level = 3;
+	while ((1LL << level) < state.get_width() || (1LL << level) < state.get_height()) {
+		level++;
+	}
+	try {
+		root = build(state, 0, 0, level);
+	} catch (const MemoryLimit&) {
+		collect(false);
+		throw std::runtime_error("The HashLife memory limit is too small for the pattern.");
+	}
+	origin_x = 0;
+	origin_y = 0;
+	generation = 0;
+}
+
+/**
+ * HashLife::get_region(x, y, width, height)
+ *
+ * Get a rectangle of the plane as a grid.
+ *
+ * @example
+ *
+ *      // A glider moves one cell diagonally every 4 steps
+ *      HashLife life;
+ *      life.set_state(Zoo::glider());
+ *      life.advance(1 << 20);
+ *      Grid glider = life.get_region(1 << 18, 1 << 18, 3, 3);
+ *
+ * @param x
+ *      The x coordinate of the top left corner, relative to the top left corner of the grid loaded.
+ *
+ * @param y
+ *      The y coordinate of the top left corner, relative to the top left corner of the grid loaded.
+ *
+ * @param width
+ *      The width of the region.
+ *
+ * @param height
+ *      The height of the region.
+ *
+ * @return
+ *      Returns a new grid holding the region.
+ */
+Grid HashLife::get_region(long long x, long long y, int width, int height) const {
+	Grid region(width, height);
+	draw(root, origin_x, origin_y, region, x, y);
+	return region;
+}
+
+/**
+ * HashLife::advance(generations)
+ *
+ * Advance the plane a number of steps on the calling thread.
+ *
+ * @param generations
+ *      The number of steps to advance.
+ *
+ * @throws
+ *      Throws std::runtime_error if the pattern grows too big to address, the node table fills up,
+ *      or a single step of the pattern does not fit in the memory limit.
+ */
+void HashLife::advance(unsigned long long generations) {
+	for (int step = 0; step < 64; step++) {
+		if ((generations >> step) & 1) {
+			budgeted_step(step, nullptr);
+		}
+	}
+}
+
+/**
+ * HashLife::advance(generations, pool)
+ *
+ * Advance the plane a number of steps, forking the recursion across a pool.
+ *
+ * @example
+ *
+ *      // Advance a big pattern a million steps on every core
+ *      ThreadPool pool;
+ *      life.advance(1000000, pool);
+ *
+ * @param generations
+ *      The number of steps to advance.
+ *
+ * @param pool
+ *      The pool to run on. The caller must not be one of its workers.
+ *
+ * @throws
+ *      Throws std::runtime_error if the pattern grows too big to address, the node table fills up,
+ *      or a single step of the pattern does not fit in the memory limit.
+ */
+void HashLife::advance(unsigned long long generations, ThreadPool &pool) {
+	for (int step = 0; step < 64; step++) {
+		if ((generations >> step) & 1) {
+			budgeted_step(step, &pool);
+		}
+	}
+}
+
+/**
+ * HashLife::get_generation()
+ *
+ * Gets the number of steps advanced since the state was set.
+ */
+unsigned long long HashLife::get_generation() const {
+	return generation;
+}
+
+/**
+ * HashLife::get_alive_cells()
+ *
+ * Gets the number of alive cells on the plane.
+ */
+unsigned long long HashLife::get_alive_cells() const {
+	return node(root).population;
+}
+
+/**
+ * HashLife::get_nodes()
+ *
+ * Gets the number of nodes in the node table.
+ */
+std::size_t HashLife::get_nodes() const {
+	return count.load();
+}
+
+/**
+ * HashLife::get_level()
+ *
+ * Gets the level of the root node, the plane is 2^level cells across.
+ */
+int HashLife::get_level() const {
+	return node(root).level;
+}
+
+/**
+ * HashLife::set_memory_limit(bytes)
+ *
+ * Cap the estimated memory used by the node table, collecting garbage straight away if it is already over.
+ *
+ * @example
+ *
+ *      // Keep the node table under 8 GB
+ *      life.set_memory_limit(8ULL << 30);
+ *
+ * @param bytes
+ *      The limit, or 0 for no limit.
+ */
+void HashLife::set_memory_limit(std::size_t bytes) {
+	limit = bytes;
+	if (limit != 0 && count * bytes_per_node() > limit) {
+		collect(false);
+	}
+}
+
+/**
+ * HashLife::collect(keep_results)
+ *
+ * Free every node that is not part of the plane, with mark and sweep, and compact the rest.
+ * Must not be called while the plane is being advanced.
+ *
+ * @example
+ *
+ *      // Free the nodes of patterns that are no longer on the plane, but keep memoised results
+ *      std::size_t freed = life.collect();
+ *
+ * @param keep_results
+ *      Optional parameter. If true then memoised results of surviving nodes survive too, otherwise the result
+ *      cache is evicted and only the nodes of the plane survive. Defaults to true.
+ *
+ * @return
+ *      Returns the number of nodes freed.
+ */
+std::size_t HashLife::collect(bool keep_results) {
+	const auto start = std::chrono::steady_clock::now();
+	const std::uint64_t total = count;
+
+	//Mark every node reachable from the plane, the empty squares, and the two cells.
+	std::vector<char> marked(total, 0);
+	std::vector<Index> stack(empty.begin(), empty.end());
+	stack.push_back(root);
+	stack.push_back(1);
+	while (!stack.empty()) {
+		const Index index = stack.back();
+		stack.pop_back();
+		if (marked[index]) {
+			continue;
+		}
+		marked[index] = 1;
+		const Node &n = node(index);
+		if (n.level > 0) {
+			stack.insert(stack.end(), n.child, n.child + 4);
+			const std::uint64_t memo = n.memo.load(std::memory_order_relaxed);
+			if (keep_results && memo != 0) {
+				stack.push_back((Index) (memo >> 8));
+			}
+		}
+	}
+
+	//Slide every marked node down to the next free index, children always come before their parents,
+	//so their new indices are already known.
+	std::vector<Index> moved(total, 0);
+	Index survivors = 0;
+	for (std::uint64_t index = 0; index < total; index++) {
+		if (!marked[index]) {
+			continue;
+		}
+		moved[index] = survivors;
+		const Node &from = node((Index) index);
+		Node &to = node(survivors);
+		for (int c = 0; c < 4; c++) {
+			to.child[c] = from.level > 0 ? moved[from.child[c]] : 0;
+		}
+		to.population = from.population;
+		to.level = from.level;
+		to.memo.store(keep_results ? from.memo.load(std::memory_order_relaxed) : 0, std::memory_order_relaxed);
+		survivors++;
+	}
+	for (Index index = 0; index < survivors; index++) {
+		Node &n = node(index);
+		const std::uint64_t memo = n.memo.load(std::memory_order_relaxed);
+		if (memo != 0) {
+			n.memo.store((std::uint64_t) moved[memo >> 8] << 8 | (memo & 0xff), std::memory_order_relaxed);
+		}
+	}
+
+	//Free the chunks past the survivors and rebuild the node table.
+	for (int chunk = (survivors + (1 << CHUNK_BITS) - 1) >> CHUNK_BITS; chunk < MAX_CHUNKS; chunk++) {
+		delete[] chunks[chunk].exchange(nullptr);
+	}
+	for (int stripe = 0; stripe < STRIPES; stripe++) {
+		stripes[stripe].table.clear();
+	}
+	for (Index index = 2; index < survivors; index++) {
+		const Node &n = node(index);
+		const Key key = { { n.child[0], n.child[1], n.child[2], n.child[3] } };
+		stripes[KeyHash()(key) % STRIPES].table.emplace(key, index);
+	}
+	count = survivors;
+	root = moved[root];
+	for (Index &level : empty) {
+		level = moved[level];
+	}
+
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	collections.collections++;
+	collections.collected += total - survivors;
+	collections.gc_seconds += seconds;
+	collections.last_gc_seconds = seconds;
+	return total - survivors;
+}
+
+/**
+ * HashLife::get_statistics()
+ *
+ * Gets statistics about the node table, the result cache, and garbage collection.
+ */
+HashLife::Statistics HashLife::get_statistics() const {
+	Statistics statistics = collections;
+	statistics.nodes = count;
+	statistics.bytes = count * bytes_per_node();
+	statistics.limit = limit;
+	statistics.hits = hits;
+	statistics.misses = misses;
+	return statistics;
+}
+
+/**
+ * HashLife::save_cache(path)
+ *
+ * Save every node and memoised result to a cache file, for a later run to load with HashLife::load_cache.
+ * The file is written beside the path and renamed over it, so a cache is never left half written.
+ *
+ * @example
+ *
+ *      // Keep the results of a long run for tomorrow's run
+ *      life.advance(1ULL << 40);
+ *      life.save_cache("B3-S23.hashlife");
+ *
+ * @param path
+ *      The path of the cache file.
+ *
+ * @throws
+ *      Throws std::runtime_error if the file cannot be written.
+ */
+void HashLife::save_cache(const std::string &path) const {
+	const std::string temporary = path + ".tmp";
+	{
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			throw std::runtime_error("Unable to open the HashLife cache " + temporary + " for writing.");
+		}
+		CacheHeader header;
+		std::memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+		header.birth = rule.get_birth();
+		header.survival = rule.get_survival();
+		header.records = count - 2;
+		header.reserved = 0;
+		file.write((const char*) &header, sizeof(header));
+		std::vector<CacheRecord> records;
+		records.reserve(1 << CHUNK_BITS);
+		for (std::uint64_t index = 2; index < count; index++) {
+			const Node &n = node((Index) index);
+			CacheRecord record;
+			std::memcpy(record.child, n.child, sizeof(record.child));
+			record.memo = n.memo.load(std::memory_order_relaxed);
+			records.push_back(record);
+			if (records.size() == records.capacity() || index + 1 == count) {
+				file.write((const char*) records.data(), records.size() * sizeof(CacheRecord));
+				records.clear();
+			}
+		}
+		if (!file.flush()) {
+			throw std::runtime_error("Unable to write the HashLife cache " + temporary + ".");
+		}
+	}
+	if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+		std::remove(temporary.c_str());
+		throw std::runtime_error("Unable to replace the HashLife cache " + path + ".");
+	}
+}
+
+/**
+ * HashLife::load_cache(path)
+ *
+ * Load the nodes and memoised results of a cache file saved by HashLife::save_cache, so that stepping any
+ * square already in the cache is a lookup. The plane itself is unchanged.
+ *
+ * @example
+ *
+ *      // Warm start from yesterday's run, if there was one
+ *      HashLife life;
+ *      life.load_cache("B3-S23.hashlife");
+ *      life.set_state(pattern);
+ *
+ * @param path
+ *      The path of the cache file.
+ *
+ * @return
+ *      Returns true if the cache was loaded, or false if there is no file or it is for another rule.
+ *
+ * @throws
+ *      Throws std::runtime_error if the file is malformed or does not fit in the memory limit.
+ */
+bool HashLife::load_cache(const std::string &path) {
+	const int descriptor = open(path.c_str(), O_RDONLY);
+	if (descriptor < 0) {
+		return false;
+	}
+	struct stat status;
+	if (fstat(descriptor, &status) != 0 || (std::size_t) status.st_size < sizeof(CacheHeader)) {
+		close(descriptor);
+		throw std::runtime_error("The HashLife cache " + path + " is malformed.");
+	}
+	const std::size_t size = status.st_size;
+	void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	close(descriptor);
+	if (mapped == MAP_FAILED) {
+		throw std::runtime_error("Unable to map the HashLife cache " + path + ".");
+	}
+	//Unmap however the load ends.
+	std::unique_ptr<void, std::function<void(void*)>> unmap(mapped, [size](void *address) {
+		munmap(address, size);
+	});
+
+	const CacheHeader &header = *(const CacheHeader*) mapped;
+	if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(header.magic)) != 0
+			|| header.records != (size - sizeof(CacheHeader)) / sizeof(CacheRecord)
+			|| (size - sizeof(CacheHeader)) % sizeof(CacheRecord) != 0 || header.records >= 0xffffffffULL - 2) {
+		throw std::runtime_error("The HashLife cache " + path + " is malformed.");
+	}
+	if (header.birth != rule.get_birth() || header.survival != rule.get_survival()) {
+		return false;
+	}
+	const CacheRecord *records = (const CacheRecord*) ((const char*) mapped + sizeof(CacheHeader));
+	const std::uint64_t total = header.records + 2;
+
+	//Join the records in order, children are always joined before their parents.
+	std::vector<Index> moved(total);
+	moved[0] = 0;
+	moved[1] = 1;
+	try {
+		for (std::uint64_t index = 2; index < total; index++) {
+			const CacheRecord &record = records[index - 2];
+			for (int c = 0; c < 4; c++) {
+				if (record.child[c] >= index || node(moved[record.child[c]]).level != node(moved[record.child[0]]).level) {
+					throw std::runtime_error("The HashLife cache " + path + " is malformed.");
+				}
+			}
+			moved[index] = join(moved[record.child[0]], moved[record.child[1]], moved[record.child[2]],
+					moved[record.child[3]]);
+		}
+	} catch (const MemoryLimit&) {
+		collect(false);
+		throw std::runtime_error("The HashLife cache " + path + " does not fit in the memory limit.");
+	}
+	for (std::uint64_t index = 2; index < total; index++) {
+		const std::uint64_t memo = records[index - 2].memo;
+		if (memo == 0) {
+			continue;
+		}
+		const std::uint64_t result = memo >> 8;
+		const int level = node(moved[index]).level, step = (int) (memo & 0xff) - 1;
+		if (result >= total || step < 0 || step > level - 2 || node(moved[result]).level != level - 1) {
+			throw std::runtime_error("The HashLife cache " + path + " is malformed.");
+		}
+		node(moved[index]).memo.store((std::uint64_t) moved[result] << 8 | (memo & 0xff), std::memory_order_relaxed);
+	}
+	return true;
+}
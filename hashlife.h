@@ -0,0 +1,125 @@
+/**
+ * Declares a class representing a Game of Life on an unbounded plane, simulated with Gosper's HashLife algorithm.
+ * Rich documentation for the api and behaviour the HashLife class can be found in hashlife.cpp.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the class.
+// #include ...
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "grid.h"
+#include "rule.h"
+#include "pool.h"
+
+/**
+ * Declare the structure of the HashLife class for simulating huge, regular patterns over huge numbers of steps.
+ */
+class HashLife {
+public:
+	typedef std::uint32_t Index;
+
+	/**
+	 * Statistics about the node table, the result cache, and garbage collection.
+	 *      - bytes is an estimate of the memory used by the nodes and the node table, limit is 0 if unlimited.
+	 *      - hits and misses count lookups of memoised results.
+	 *      - collected is the total number of nodes freed by collections, and the seconds are pause times.
+	 */
+	struct Statistics {
+		std::size_t nodes { }, bytes { }, limit { };
+		unsigned long long hits { }, misses { }, collections { }, collected { };
+		double gc_seconds { }, last_gc_seconds { };
+	};
+private:
+	/**
+	 * A Node is a square of 2^level x 2^level cells made of 4 quadrant nodes one level down,
+	 * or a single cell at level 0. Nodes are immutable apart from the memoised result.
+	 */
+	struct Node {
+		Index child[4];
+		std::uint64_t population;
+		int level;
+		//The result node and the step it was computed for, as (result << 8) | (step + 1), or 0 if none.
+		std::atomic<std::uint64_t> memo;
+	};
+
+	/**
+	 * A Key identifies a node by its quadrants, nw, ne, sw, se.
+	 */
+	struct Key {
+		Index child[4];
+		bool operator==(const Key &other) const;
+	};
+	struct KeyHash {
+		std::size_t operator()(const Key &key) const;
+	};
+
+	/**
+	 * A Stripe is one lock and the part of the node table whose keys hash to it.
+	 */
+	struct Stripe {
+		std::mutex lock;
+		std::unordered_map<Key, Index, KeyHash> table;
+	};
+
+	static const int CHUNK_BITS = 16;
+	static const int MAX_CHUNKS = 1 << 16;
+	static const int STRIPES = 256;
+	//Levels at and above this fork their sub-results across the pool.
+	static const int FORK_LEVEL = 7;
+
+	Rule rule;
+	std::unique_ptr<std::atomic<Node*>[]> chunks;
+	std::atomic<std::uint64_t> count;
+	std::mutex chunk_lock;
+	std::unique_ptr<Stripe[]> stripes;
+	std::vector<Index> empty;
+	unsigned char base[1 << 16];
+	Index root;
+	long long origin_x, origin_y;
+	unsigned long long generation;
+	std::size_t limit;
+	std::atomic<unsigned long long> hits, misses;
+	Statistics collections;
+
+	Node& node(Index index) const;
+	Index allocate();
+	Index join(Index nw, Index ne, Index sw, Index se);
+	Index centre(Index index);
+	Index centre_horizontal(Index west, Index east);
+	Index centre_vertical(Index north, Index south);
+	Index next(Index index, int step, ThreadPool *pool);
+	Index build(const GridView &grid, long long x, long long y, int level);
+	void draw(Index index, long long x, long long y, Grid &grid, long long x0, long long y0) const;
+	void expand();
+	void step(int step, ThreadPool *pool);
+	void budgeted_step(int step, ThreadPool *pool);
+	static std::size_t bytes_per_node();
+public:
+	explicit HashLife(const Rule &rule = Rule());
+	~HashLife();
+	HashLife(const HashLife&) = delete;
+	HashLife& operator=(const HashLife&) = delete;
+	const Rule& get_rule() const;
+	void set_state(GridView state);
+	Grid get_region(long long x, long long y, int width, int height) const;
+	void advance(unsigned long long generations);
+	void advance(unsigned long long generations, ThreadPool &pool);
+	unsigned long long get_generation() const;
+	unsigned long long get_alive_cells() const;
+	std::size_t get_nodes() const;
+	int get_level() const;
+	void set_memory_limit(std::size_t bytes);
+	std::size_t collect(bool keep_results = true);
+	Statistics get_statistics() const;
+	void save_cache(const std::string &path) const;
+	bool load_cache(const std::string &path);
+};
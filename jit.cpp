@@ -0,0 +1,358 @@
+/**
+ * Implements a Jit namespace with methods for generating, compiling, and loading step kernels specialised to a Rule.
+ *      - The generic step in World evaluates the circuit compiled from the Rule with a small interpreter.
+ *      - A specialised kernel steps 64 cells at a time in the same way, bit-parallel, but with the circuit
+ *        emitted as straight line code, so the compiler folds it in with the neighbour sum and no operation
+ *        is dispatched at runtime.
+ *
+ *      - Kernels are emitted as C++ source, compiled with the system compiler into a shared object,
+ *        and loaded with dlopen.
+ *          - The compiler defaults to g++ and can be overridden with the CXX environment variable.
+ *          - The compiler is run directly rather than through a shell, so any path is safe to cache in.
+ *          - Shared objects are cached on disc, named by a hash of their source, so each rule is
+ *            only compiled once per machine.
+ *          - The cache directory is GOL_KERNEL_CACHE, or $XDG_CACHE_HOME/game_of_life,
+ *            or $HOME/.cache/game_of_life, or /tmp/game_of_life-UID, whichever is set first and usable.
+ *          - Loading a shared object runs its code, so the cache directory is created private, and it and
+ *            every cached kernel are only trusted if they are owned by the effective user and writable by
+ *            no one else. A directory or kernel that could have been planted by another user is refused.
+ *
+ *      - If no compiler is available, or compilation or loading fails, no kernel is returned and
+ *        the caller should fall back to the generic step.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#include "jit.h"
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include "grid.h"
+#include "bits.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <mutex>
+#include <vector>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+namespace {
+
+/**
+ * trusted(path, directory)
+ *
+ * Private helper to check a directory, or a regular file, is not a symbolic link, is owned by the effective
+ * user, and is not writable by the group or others.
+ */
+bool trusted(const std::string &path, bool directory) {
+	struct stat info;
+	return lstat(path.c_str(), &info) == 0 && (directory ? S_ISDIR(info.st_mode) : S_ISREG(info.st_mode))
+			&& info.st_uid == geteuid() && (info.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+}
+
+/**
+ * make_directories(path)
+ *
+ * Private helper to create a directory and any missing parents, like mkdir -p.
+ * The directory itself is created private to the user, and must be trusted to be used.
+ */
+bool make_directories(const std::string &path) {
+	for (std::size_t i = 1; i < path.size(); i++) {
+		if (path[i] == '/') {
+			mkdir(path.substr(0, i).c_str(), 0755);
+		}
+	}
+	mkdir(path.c_str(), 0700);
+	return trusted(path, true);
+}
+
+/**
+ * hash(text)
+ *
+ * Private helper computing the 64 bit FNV-1a hash of a string, used to name cached kernels.
+ */
+std::string hash(const std::string &text) {
+	unsigned long long h = 14695981039346656037ull;
+	for (unsigned char c : text) {
+		h = (h ^ c) * 1099511628211ull;
+	}
+	char name[17];
+	std::snprintf(name, sizeof(name), "%016llx", h);
+	return name;
+}
+
+/**
+ * compile(compiler, source, library)
+ *
+ * Private helper to run the compiler on a source file without a shell, so no path is ever parsed as a command.
+ * The compiler is split on whitespace, so it can still be a wrapper such as "ccache g++".
+ *
+ * @return
+ *      Returns true if the compiler ran and exited successfully.
+ */
+bool compile(const std::string &compiler, const std::string &source, const std::string &library) {
+	std::vector<std::string> words;
+	std::istringstream split(compiler);
+	for (std::string word; split >> word;) {
+		words.push_back(word);
+	}
+	if (words.empty()) {
+		return false;
+	}
+	for (const char *flag : { "-std=c++11", "-O3", "-shared", "-fPIC", "-o" }) {
+		words.push_back(flag);
+	}
+	words.push_back(library);
+	words.push_back(source);
+	//The arguments are built before forking, the child of a threaded process must not allocate.
+	std::vector<char*> argv;
+	for (std::string &word : words) {
+		argv.push_back(&word[0]);
+	}
+	argv.push_back(nullptr);
+	const pid_t child = fork();
+	if (child < 0) {
+		return false;
+	}
+	if (child == 0) {
+		const int null = open("/dev/null", O_WRONLY);
+		if (null >= 0) {
+			dup2(null, STDOUT_FILENO);
+			dup2(null, STDERR_FILENO);
+		}
+		execvp(argv[0], argv.data());
+		_exit(127);
+	}
+	int status;
+	while (waitpid(child, &status, 0) < 0) {
+		if (errno != EINTR) {
+			return false;
+		}
+	}
+	return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+/**
+ * build(compiler, source, name)
+ *
+ * Private helper to compile a kernel into the cache if it is missing and load it.
+ */
+StepKernel build(const std::string &compiler, const std::string &source, const std::string &name) {
+	std::string directory = Jit::cache_directory();
+	if (directory.empty()) {
+		return nullptr;
+	}
+	const std::string library = directory + "/" + name + ".so";
+	struct stat info;
+	if (lstat(library.c_str(), &info) != 0) {
+		//Compile into process unique files and rename them into place so concurrent
+		//processes never see a partially written shared object.
+		const std::string unique = directory + "/" + name + "." + std::to_string(getpid());
+		std::ofstream srcFile(unique + ".cpp");
+		srcFile << source;
+		srcFile.close();
+		if (!srcFile) {
+			return nullptr;
+		}
+		const bool compiled = compile(compiler, unique + ".cpp", unique + ".so");
+		std::remove((unique + ".cpp").c_str());
+		if (!compiled || chmod((unique + ".so").c_str(), 0700) != 0
+				|| std::rename((unique + ".so").c_str(), library.c_str()) != 0) {
+			std::remove((unique + ".so").c_str());
+			return nullptr;
+		}
+	}
+
+	if (!trusted(library, false)) {
+		return nullptr;
+	}
+	void *handle = dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+	if (handle == nullptr) {
+		return nullptr;
+	}
+	StepKernel kernel = reinterpret_cast<StepKernel>(dlsym(handle, "gol_step"));
+	if (kernel == nullptr) {
+		dlclose(handle);
+		return nullptr;
+	}
+	return kernel;
+}
+
+}
+
+/**
+ * Jit::generate_source(rule)
+ *
+ * Emit the C++ source of a step kernel specialised to a rule.
+ * The kernel is exported with C linkage as gol_step and matches the StepKernel signature.
+ *
+ * @example
+ *
+ *      // Print the kernel for HighLife
+ *      std::cout << Jit::generate_source(Rule::parse("B36/S23")) << std::endl;
+ *
+ * @param rule
+ *      The rule to specialise the kernel to.
+ *
+ * @return
+ *      Returns the source code of the kernel.
+ */
+std::string Jit::generate_source(const Rule &rule) {
+	static_assert(Cell::ALIVE % 2 == 1 && Cell::DEAD % 2 == 0, "Alive cells are packed by their lowest bit.");
+	const char alive = (char) Cell::ALIVE, dead = (char) Cell::DEAD;
+	std::ostringstream src;
+	src << "// Bit-parallel step kernel generated for " << rule.to_string() << "\n"
+		<< "#include <cstring>\n"
+		<< "#include <vector>\n"
+		<< "typedef unsigned long long W;\n";
+	//Each byte of a word unpacks to 8 cells, little endian, as the cells are laid out in memory.
+	src << "static const W SPREAD[256] = {";
+	for (int byte = 0; byte < 256; byte++) {
+		unsigned long long cells = 0;
+		for (int i = 0; i < 8; i++) {
+			cells |= (unsigned long long) (unsigned char) (((byte >> i) & 1) ? alive : dead) << (8 * i);
+		}
+		src << (byte % 4 == 0 ? "\n\t" : " ") << cells << "ull" << (byte < 255 ? "," : "");
+	}
+	src << "\n};\n"
+		<< "static inline W pack(const char *cells, int width) {\n"
+		<< "\tW row = 0;\n"
+		<< "\tint x = 0;\n"
+		<< "\tfor (; x + 8 <= width; x += 8) {\n"
+		<< "\t\tW bytes;\n"
+		<< "\t\tstd::memcpy(&bytes, cells + x, 8);\n"
+		<< "\t\trow |= (((bytes & 0x0101010101010101ull) * 0x0102040810204080ull) >> 56) << x;\n"
+		<< "\t}\n"
+		<< "\tfor (; x < width; x++) {\n"
+		<< "\t\trow |= (W) (cells[x] & 1) << x;\n"
+		<< "\t}\n"
+		<< "\treturn row;\n"
+		<< "}\n"
+		<< "static inline void unpack(W row, char *cells, int width) {\n"
+		<< "\tint x = 0;\n"
+		<< "\tfor (; x + 8 <= width; x += 8) {\n"
+		<< "\t\tstd::memcpy(cells + x, &SPREAD[(row >> x) & 0xff], 8);\n"
+		<< "\t}\n"
+		<< "\tfor (; x < width; x++) {\n"
+		<< "\t\tcells[x] = ((row >> x) & 1) ? '" << alive << "' : '" << dead << "';\n"
+		<< "\t}\n"
+		<< "}\n"
+		<< "static inline W next(W alive, W s0, W s1, W s2, W s3) {\n";
+	//The circuit of the rule, as straight line code the compiler can schedule and fold.
+	std::istringstream circuit(Bits::to_string(Bits::compile(rule)));
+	for (std::string line; std::getline(circuit, line);) {
+		if (line.compare(0, 7, "next = ") == 0) {
+			src << "\treturn " << line.substr(7) << "\n";
+		} else {
+			src << "\tconst W " << line << "\n";
+		}
+	}
+	src << "}\n"
+		<< "extern \"C\" void gol_step(const char *current, char *future, int width, int height, int toroidal) {\n"
+		<< "\tif (width <= 0 || height <= 0) {\n"
+		<< "\t\treturn;\n"
+		<< "\t}\n"
+		<< "\tconst int words = (width + 63) / 64, last = (width - 1) % 64;\n"
+		<< "\t//Row height stays dead, it is the row above and below a grid that is not toroidal.\n"
+		<< "\tstd::vector<W> plane((long) words * (height + 1), 0);\n"
+		<< "\tfor (int y = 0; y < height; y++) {\n"
+		<< "\t\tfor (int k = 0; k < words; k++) {\n"
+		<< "\t\t\tconst int cells = width - k * 64 < 64 ? width - k * 64 : 64;\n"
+		<< "\t\t\tplane[(long) y * words + k] = pack(current + (long) y * width + k * 64, cells);\n"
+		<< "\t\t}\n"
+		<< "\t}\n"
+		<< "\tfor (int y = 0; y < height; y++) {\n"
+		<< "\t\tconst W *mid = plane.data() + (long) y * words;\n"
+		<< "\t\tconst W *up = y > 0 ? mid - words : plane.data() + (long) (toroidal ? height - 1 : height) * words;\n"
+		<< "\t\tconst W *down = y + 1 < height ? mid + words : plane.data() + (long) (toroidal ? 0 : height) * words;\n"
+		<< "\t\tfor (int k = 0; k < words; k++) {\n"
+		<< "\t\t\tW west[3], east[3];\n"
+		<< "\t\t\tconst W *rows[3] = { up, mid, down };\n"
+		<< "\t\t\tfor (int i = 0; i < 3; i++) {\n"
+		<< "\t\t\t\tconst W *row = rows[i];\n"
+		<< "\t\t\t\twest[i] = row[k] << 1 | (k > 0 ? row[k - 1] >> 63 : toroidal ? (row[words - 1] >> last) & 1 : 0);\n"
+		<< "\t\t\t\teast[i] = row[k] >> 1 | (k + 1 < words ? row[k + 1] << 63 : toroidal ? (row[0] & 1) << last : 0);\n"
+		<< "\t\t\t}\n"
+		<< "\t\t\tconst W a0 = west[0] ^ up[k] ^ east[0], a1 = (west[0] & up[k]) | (east[0] & (west[0] ^ up[k]));\n"
+		<< "\t\t\tconst W b0 = west[1] ^ east[1] ^ west[2], b1 = (west[1] & east[1]) | (west[2] & (west[1] ^ east[1]));\n"
+		<< "\t\t\tconst W c0 = down[k] ^ east[2], c1 = down[k] & east[2];\n"
+		<< "\t\t\tconst W ones = a0 ^ b0 ^ c0, ones_carry = (a0 & b0) | (c0 & (a0 ^ b0));\n"
+		<< "\t\t\tconst W twos = a1 ^ b1 ^ c1, twos_carry = (a1 & b1) | (c1 & (a1 ^ b1));\n"
+		<< "\t\t\tconst W fours = twos & ones_carry;\n"
+		<< "\t\t\tconst W cells = next(mid[k], ones, twos ^ ones_carry, twos_carry ^ fours, twos_carry & fours);\n"
+		<< "\t\t\tunpack(cells, future + (long) y * width + k * 64, width - k * 64 < 64 ? width - k * 64 : 64);\n"
+		<< "\t\t}\n"
+		<< "\t}\n"
+		<< "}\n";
+	return src.str();
+}
+
+/**
+ * Jit::cache_directory()
+ *
+ * Gets the directory specialised kernels are cached in, creating it if needed.
+ *
+ * @return
+ *      Returns the path of the cache directory, or an empty string if none could be created and trusted.
+ */
+std::string Jit::cache_directory() {
+	const char *override = std::getenv("GOL_KERNEL_CACHE");
+	const char *xdg = std::getenv("XDG_CACHE_HOME");
+	const char *home = std::getenv("HOME");
+	std::string candidates[] = { override ? override : "", xdg ? std::string(xdg) + "/game_of_life" : "",
+			home ? std::string(home) + "/.cache/game_of_life" : "", "/tmp/game_of_life-" + std::to_string(geteuid()) };
+	for (const std::string &candidate : candidates) {
+		if (!candidate.empty() && make_directories(candidate)) {
+			return candidate;
+		}
+	}
+	return "";
+}
+
+/**
+ * Jit::load_kernel(rule)
+ *
+ * Get a step kernel specialised to a rule, compiling it if it is not already in the cache.
+ * Loaded kernels stay loaded for the lifetime of the process and are shared between callers.
+ * The function is safe to call from multiple threads.
+ *
+ * @example
+ *
+ *      // Fall back to the generic step if no kernel could be built
+ *      StepKernel kernel = Jit::load_kernel(Rule::parse("B36/S23"));
+ *      if (kernel == nullptr) {
+ *          ...
+ *      }
+ *
+ * @param rule
+ *      The rule to specialise the kernel to.
+ *
+ * @return
+ *      Returns the kernel, or nullptr if it could not be compiled or loaded.
+ */
+StepKernel Jit::load_kernel(const Rule &rule) {
+	static std::mutex lock;
+	static std::map<std::string, StepKernel> loaded;
+	std::lock_guard<std::mutex> guard(lock);
+
+	const char *cxx = std::getenv("CXX");
+	const std::string compiler = cxx ? cxx : "g++";
+	const std::string source = generate_source(rule);
+	const std::string name = "step_" + hash(compiler + '\n' + source);
+	auto found = loaded.find(name);
+	if (found != loaded.end()) {
+		return found->second;
+	}
+
+	//Failures are remembered too, so a missing compiler is only probed once.
+	StepKernel kernel = build(compiler, source, name);
+	loaded[name] = kernel;
+	return kernel;
+}
@@ -0,0 +1,29 @@
+/**
+ * Declares a Jit namespace with methods for generating, compiling, and loading step kernels specialised to a Rule.
+ * Rich documentation for the api and behaviour the Jit namespace can be found in jit.cpp.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the namespace.
+// #include ...
+#include <string>
+#include "rule.h"
+
+/**
+ * A StepKernel reads a width x height array of cells from current and writes the next step into future.
+ * Cells are stored as the Cell characters in row major order.
+ */
+typedef void (*StepKernel)(const char *current, char *future, int width, int height, int toroidal);
+
+/**
+ * Declare the interface of the Jit namespace for building specialised step kernels at runtime.
+ */
+namespace Jit {
+std::string generate_source(const Rule &rule);
+std::string cache_directory();
+StepKernel load_kernel(const Rule &rule);
+}
+;
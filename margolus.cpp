@@ -0,0 +1,512 @@
+/**
+ * Implements a class representing the rule of a Margolus block cellular automaton, and a class representing a
+ * 2d grid world simulated with such a rule.
+ *      - A block cellular automaton partitions the grid into 2x2 blocks and replaces every block with its next
+ *        state from a table of 16 entries. The partition alternates between steps.
+ *          - On even steps the blocks have their north west cell at even coordinates.
+ *          - On odd steps the blocks are shifted one cell south east, so every block straddles four of the
+ *            blocks before, and information crosses block boundaries.
+ *          - https://en.wikipedia.org/wiki/Block_cellular_automaton
+ *
+ *      - Rules can be built from tables or by name.
+ *          - Critters, a reversible rule that keeps blocks of 2 alive cells, complements the others, and also
+ *            turns blocks of 3 alive cells through 180 degrees.
+ *          - The Billiard Ball Machine, where lone cells fly diagonally and collide like balls.
+ *          - Tron, which complements blocks whose cells are all alike.
+ *
+ *      - Worlds are packed 64 cells to a word, like Bits::Plane.
+ *          - Two rows are stepped at once. The 2 cells of 4 blocks side by side in each row are a byte at
+ *            an even bit, so a table of 65536 entries built from the rule steps 4 blocks per lookup.
+ *          - For the odd partition both rows are rotated one cell west first, which lines the shifted blocks
+ *            up with the even bits, and rotated back after.
+ *          - On a torus the odd blocks on the last column and row wrap to the first. Otherwise they are left
+ *            unchanged, as are the cells of the first and last column and row that they would cover.
+ *          - Width and height must be even, so the partitions tile the grid.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#include "margolus.h"
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * rotate(block)
+ *
+ * Private helper to turn a block state through 180 degrees, swapping opposite corners.
+ */
+int rotate(int block) {
+	return ((block & 1) << 3) | ((block & 2) << 1) | ((block & 4) >> 1) | ((block & 8) >> 3);
+}
+
+/**
+ * population(block)
+ *
+ * Private helper to count the alive cells of a block state.
+ */
+int population(int block) {
+	return (block & 1) + ((block >> 1) & 1) + ((block >> 2) & 1) + ((block >> 3) & 1);
+}
+
+/**
+ * check_table(table)
+ *
+ * Private helper to check a table has a valid next state for every block state.
+ */
+void check_table(const std::vector<int> &table) {
+	if (table.size() != 16) {
+		throw std::runtime_error("A block rule needs a next state for each of the 16 block states.");
+	}
+	for (int next : table) {
+		if (next < 0 || next > 15) {
+			throw std::runtime_error("A block rule contains an invalid block state.");
+		}
+	}
+}
+
+/**
+ * build_blocks(rule, odd)
+ *
+ * Private helper to build the table stepping 4 blocks side by side.
+ */
+std::vector<std::uint16_t> build_blocks(const BlockRule &rule, bool odd) {
+	std::vector<std::uint16_t> blocks(1 << 16);
+	for (int index = 0; index < (1 << 16); index++) {
+		const int top = index & 0xff, bottom = index >> 8;
+		int next_top = 0, next_bottom = 0;
+		for (int i = 0; i < 8; i += 2) {
+			const int next = rule.next(((top >> i) & 3) | (((bottom >> i) & 3) << 2), odd);
+			next_top |= (next & 3) << i;
+			next_bottom |= (next >> 2) << i;
+		}
+		blocks[index] = next_top | next_bottom << 8;
+	}
+	return blocks;
+}
+
+}
+
+/**
+ * BlockRule::BlockRule()
+ *
+ * Construct the identity rule, where every block keeps its state.
+ */
+BlockRule::BlockRule() :
+		even_table(16), odd_table(16) {
+	for (int block = 0; block < 16; block++) {
+		even_table[block] = odd_table[block] = block;
+	}
+}
+
+/**
+ * BlockRule::BlockRule(table)
+ *
+ * Construct a rule with the same table for both partitions.
+ *
+ * @example
+ *
+ *      // Make the rule where every block is complemented
+ *      BlockRule rule({ 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 });
+ *
+ * @param table
+ *      The next state of each of the 16 block states.
+ *
+ * @throws
+ *      Throws std::runtime_error if the table does not have 16 states from 0 to 15.
+ */
+BlockRule::BlockRule(const std::vector<int> &table) :
+		BlockRule(table, table) {
+}
+
+/**
+ * BlockRule::BlockRule(even, odd)
+ *
+ * Construct a rule with a different table for each partition.
+ *
+ * @param even
+ *      The next state of each of the 16 block states on even steps.
+ *
+ * @param odd
+ *      The next state of each of the 16 block states on odd steps.
+ *
+ * @throws
+ *      Throws std::runtime_error if either table does not have 16 states from 0 to 15.
+ */
+BlockRule::BlockRule(const std::vector<int> &even, const std::vector<int> &odd) :
+		even_table(even), odd_table(odd) {
+	check_table(even_table);
+	check_table(odd_table);
+}
+
+/**
+ * BlockRule::critters()
+ *
+ * Gets the Critters rule. Blocks of 2 alive cells are unchanged, others are complemented, and blocks of
+ * 3 alive cells are also turned through 180 degrees.
+ */
+BlockRule BlockRule::critters() {
+	std::vector<int> table(16);
+	for (int block = 0; block < 16; block++) {
+		const int alive = population(block);
+		table[block] = alive == 2 ? block : alive == 3 ? rotate(15 - block) : 15 - block;
+	}
+	return BlockRule(table);
+}
+
+/**
+ * BlockRule::billiard_ball()
+ *
+ * Gets the Billiard Ball Machine rule. A lone cell moves to the opposite corner, two cells on a diagonal
+ * turn to the other diagonal, and every other block is unchanged.
+ */
+BlockRule BlockRule::billiard_ball() {
+	std::vector<int> table(16);
+	for (int block = 0; block < 16; block++) {
+		table[block] = population(block) == 1 ? rotate(block) : block == 9 ? 6 : block == 6 ? 9 : block;
+	}
+	return BlockRule(table);
+}
+
+/**
+ * BlockRule::tron()
+ *
+ * Gets the Tron rule. Blocks that are all dead or all alive are complemented, others are unchanged.
+ */
+BlockRule BlockRule::tron() {
+	std::vector<int> table(16);
+	for (int block = 0; block < 16; block++) {
+		table[block] = block == 0 ? 15 : block == 15 ? 0 : block;
+	}
+	return BlockRule(table);
+}
+
+/**
+ * BlockRule::parse(notation)
+ *
+ * Parse a rule from its name, or from the 16 next states of its table separated by commas.
+ *
+ * @example
+ *
+ *      // Get the Billiard Ball Machine
+ *      BlockRule bbm = BlockRule::parse("bbm");
+ *
+ *      // Make Tron from its table
+ *      BlockRule tron = BlockRule::parse("15,1,2,3,4,5,6,7,8,9,10,11,12,13,14,0");
+ *
+ * @param notation
+ *      One of critters, bbm, billiard-ball, or tron, in any case, or a table.
+ *
+ * @throws
+ *      Throws std::runtime_error if the notation is not a known name or a valid table.
+ */
+BlockRule BlockRule::parse(std::string notation) {
+	std::transform(notation.begin(), notation.end(), notation.begin(), [](char c) {
+		return (char) std::tolower(c);
+	});
+	if (notation == "critters") {
+		return critters();
+	}
+	if (notation == "bbm" || notation == "billiard-ball") {
+		return billiard_ball();
+	}
+	if (notation == "tron") {
+		return tron();
+	}
+	std::vector<int> table;
+	std::istringstream stream(notation);
+	std::string entry;
+	while (std::getline(stream, entry, ',')) {
+		if (entry.empty() || entry.find_first_not_of("0123456789") != std::string::npos || entry.size() > 2) {
+			throw std::runtime_error("The block rule is not a known name or a table of 16 block states.");
+		}
+		table.push_back(std::stoi(entry));
+	}
+	return BlockRule(table);
+}
+
+/**
+ * BlockRule::next(block, odd)
+ *
+ * Gets the next state of a block.
+ *
+ * @param block
+ *      The state of the block, from 0 to 15.
+ *
+ * @param odd
+ *      True for a block of the odd partition.
+ */
+int BlockRule::next(int block, bool odd) const {
+	return odd ? odd_table[block] : even_table[block];
+}
+
+/**
+ * BlockRule::is_reversible()
+ *
+ * Checks if every state of both tables has exactly one predecessor, so the rule can be run backwards.
+ */
+bool BlockRule::is_reversible() const {
+	for (const std::vector<int> *table : { &even_table, &odd_table }) {
+		std::vector<int> sorted(*table);
+		std::sort(sorted.begin(), sorted.end());
+		for (int block = 0; block < 16; block++) {
+			if (sorted[block] != block) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * BlockWorld::BlockWorld(width, height, rule)
+ *
+ * Construct a world of dead cells.
+ *
+ * @example
+ *
+ *      // Make a 64x64 Billiard Ball Machine
+ *      BlockWorld world(64, 64, BlockRule::billiard_ball());
+ *
+ * @param width
+ *      The width of the world, which must be even.
+ *
+ * @param height
+ *      The height of the world, which must be even.
+ *
+ * @param rule
+ *      The block rule.
+ *
+ * @throws
+ *      Throws std::runtime_error if the width or height is odd or negative.
+ */
+BlockWorld::BlockWorld(int width, int height, const BlockRule &rule) :
+		width(width), height(height), rule(rule) {
+	if (width < 0 || height < 0 || width % 2 != 0 || height % 2 != 0) {
+		throw std::runtime_error("A block world must have an even width and height.");
+	}
+	cells = Bits::Plane(width, height);
+	even_blocks = build_blocks(rule, false);
+	odd_blocks = build_blocks(rule, true);
+}
+
+/**
+ * BlockWorld::BlockWorld(state, rule)
+ *
+ * Construct a world from the cells of a grid.
+ *
+ * @example
+ *
+ *      // Run Critters from a loaded grid
+ *      BlockWorld world(Zoo::load_ascii("soup.gol"), BlockRule::critters());
+ *
+ * @param state
+ *      The initial cells, whose width and height must be even.
+ *
+ * @param rule
+ *      The block rule.
+ *
+ * @throws
+ *      Throws std::runtime_error if the width or height is odd.
+ */
+BlockWorld::BlockWorld(GridView state, const BlockRule &rule) :
+		BlockWorld(state.get_width(), state.get_height(), rule) {
+	for (int y = 0; y < height; y++) {
+		for (int k = 0; k < cells.words; k++) {
+			cells.row(y)[k] = Bits::pack_row(state.row(y) + k * 64, std::min(64, width - k * 64));
+		}
+	}
+}
+
+/**
+ * BlockWorld::get_width()
+ *
+ * Gets the width of the world.
+ */
+int BlockWorld::get_width() const {
+	return width;
+}
+
+/**
+ * BlockWorld::get_height()
+ *
+ * Gets the height of the world.
+ */
+int BlockWorld::get_height() const {
+	return height;
+}
+
+/**
+ * BlockWorld::get_generation()
+ *
+ * Gets the number of steps taken, whose parity is the partition of the next step.
+ */
+unsigned long long BlockWorld::get_generation() const {
+	return generation;
+}
+
+/**
+ * BlockWorld::get_alive_cells()
+ *
+ * Gets the number of alive cells.
+ */
+int BlockWorld::get_alive_cells() const {
+	int count = 0;
+	for (Word word : cells.bits) {
+		count += __builtin_popcountll(word);
+	}
+	return count;
+}
+
+/**
+ * BlockWorld::get(x, y)
+ *
+ * Gets a cell.
+ *
+ * @throws
+ *      Throws std::runtime_error if the cell is outside the world.
+ */
+Cell BlockWorld::get(int x, int y) const {
+	if (x < 0 || x >= width || y < 0 || y >= height) {
+		throw std::runtime_error("The cell is outside the block world.");
+	}
+	return ((cells.row(y)[x / 64] >> (x % 64)) & 1) ? Cell::ALIVE : Cell::DEAD;
+}
+
+/**
+ * BlockWorld::set(x, y, cell)
+ *
+ * Sets a cell.
+ *
+ * @throws
+ *      Throws std::runtime_error if the cell is outside the world.
+ */
+void BlockWorld::set(int x, int y, Cell cell) {
+	if (x < 0 || x >= width || y < 0 || y >= height) {
+		throw std::runtime_error("The cell is outside the block world.");
+	}
+	const Word bit = 1ull << (x % 64);
+	Word &word = cells.row(y)[x / 64];
+	word = cell == Cell::ALIVE ? word | bit : word & ~bit;
+}
+
+/**
+ * BlockWorld::get_state()
+ *
+ * Gets the cells of the world as a grid.
+ */
+Grid BlockWorld::get_state() const {
+	Grid grid(width, height);
+	for (int y = 0; y < height; y++) {
+		for (int k = 0; k < cells.words; k++) {
+			Bits::unpack_row(cells.row(y)[k], grid.data() + y * width + k * 64, std::min(64, width - k * 64));
+		}
+	}
+	return grid;
+}
+
+/**
+ * BlockWorld::step_rows(top, bottom, blocks, odd, toroidal)
+ *
+ * Private method to step the blocks of one partition that lie across two rows.
+ */
+void BlockWorld::step_rows(Word *top, Word *bottom, const std::uint16_t *blocks, bool odd, bool toroidal) const {
+	const int words = cells.words, last = (width - 1) % 64;
+	const Word edges_top[2] = { top[0] & 1, (top[words - 1] >> last) & 1 };
+	const Word edges_bottom[2] = { bottom[0] & 1, (bottom[words - 1] >> last) & 1 };
+	//Rotate one cell west, so cell x + 1 is in bit x and the odd blocks start at even bits.
+	auto rotate_west = [&](Word *row) {
+		const Word first = row[0] & 1;
+		for (int k = 0; k < words; k++) {
+			row[k] = row[k] >> 1 | (k + 1 < words ? row[k + 1] << 63 : 0);
+		}
+		row[words - 1] |= first << last;
+	};
+	auto rotate_east = [&](Word *row) {
+		const Word wrapped = (row[words - 1] >> last) & 1;
+		for (int k = words - 1; k >= 0; k--) {
+			row[k] = row[k] << 1 | (k > 0 ? row[k - 1] >> 63 : 0);
+		}
+		row[0] |= wrapped;
+	};
+	if (odd) {
+		rotate_west(top);
+		rotate_west(bottom);
+	}
+	for (int k = 0; k < words; k++) {
+		Word next_top = 0, next_bottom = 0;
+		for (int shift = 0; shift < 64; shift += 8) {
+			const std::uint16_t next = blocks[((top[k] >> shift) & 0xff) | ((bottom[k] >> shift) & 0xff) << 8];
+			next_top |= (Word) (next & 0xff) << shift;
+			next_bottom |= (Word) (next >> 8) << shift;
+		}
+		top[k] = next_top;
+		bottom[k] = next_bottom;
+	}
+	const Word mask = Bits::width_mask(width - (words - 1) * 64);
+	top[words - 1] &= mask;
+	bottom[words - 1] &= mask;
+	if (odd) {
+		rotate_east(top);
+		rotate_east(bottom);
+		top[words - 1] &= mask;
+		bottom[words - 1] &= mask;
+		if (!toroidal) {
+			//The block across the first and last columns does not exist off a torus, put its cells back.
+			top[0] = (top[0] & ~1ull) | edges_top[0];
+			bottom[0] = (bottom[0] & ~1ull) | edges_bottom[0];
+			top[words - 1] = (top[words - 1] & ~(1ull << last)) | edges_top[1] << last;
+			bottom[words - 1] = (bottom[words - 1] & ~(1ull << last)) | edges_bottom[1] << last;
+		}
+	}
+}
+
+/**
+ * BlockWorld::step(toroidal)
+ *
+ * Take one step, replacing every block of the current partition with its next state.
+ *
+ * @param toroidal
+ *      Optional parameter. If true then the odd blocks wrap around the edges of the world, otherwise
+ *      cells on the edges are left out of them. Defaults to false.
+ */
+void BlockWorld::step(bool toroidal) {
+	const bool odd = generation & 1;
+	const std::uint16_t *blocks = odd ? odd_blocks.data() : even_blocks.data();
+	if (width > 0 && height > 0) {
+		for (int y = odd ? 1 : 0; y + 1 < height; y += 2) {
+			step_rows(cells.row(y), cells.row(y + 1), blocks, odd, toroidal);
+		}
+		if (odd && toroidal) {
+			//The odd blocks on the last row wrap to the first row, so step copies and write them back.
+			std::vector<Word> top(cells.row(height - 1), cells.row(height)), bottom(cells.row(0), cells.row(1));
+			step_rows(top.data(), bottom.data(), blocks, odd, toroidal);
+			std::copy(top.begin(), top.end(), cells.row(height - 1));
+			std::copy(bottom.begin(), bottom.end(), cells.row(0));
+		}
+	}
+	generation++;
+}
+
+/**
+ * BlockWorld::advance(steps, toroidal)
+ *
+ * Advance multiple steps.
+ *
+ * @param steps
+ *      The number of steps to advance the world forward.
+ *
+ * @param toroidal
+ *      Optional parameter. If true then the world is a torus. Defaults to false.
+ */
+void BlockWorld::advance(int steps, bool toroidal) {
+	for (int i = 0; i < steps; i++) {
+		step(toroidal);
+	}
+}
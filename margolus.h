@@ -0,0 +1,65 @@
+/**
+ * Declares a class representing the rule of a Margolus block cellular automaton, and a class representing a
+ * 2d grid world simulated with such a rule.
+ * Rich documentation for the api and behaviour of both classes can be found in margolus.cpp.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the class.
+// #include ...
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "grid.h"
+#include "bits.h"
+
+/**
+ * Declare the structure of the BlockRule class for mapping each state of a 2x2 block to its next state.
+ *
+ * Bit 0 of a block state is the north west cell, bit 1 the north east, bit 2 the south west, and bit 3 the
+ * south east. Separate tables are kept for the even and odd partitions, which are usually the same.
+ */
+class BlockRule {
+	std::vector<int> even_table, odd_table;
+public:
+	BlockRule();
+	explicit BlockRule(const std::vector<int> &table);
+	BlockRule(const std::vector<int> &even, const std::vector<int> &odd);
+	static BlockRule critters();
+	static BlockRule billiard_ball();
+	static BlockRule tron();
+	static BlockRule parse(std::string notation);
+	int next(int block, bool odd) const;
+	bool is_reversible() const;
+};
+
+/**
+ * Declare the structure of the BlockWorld class for simulating a Margolus block cellular automaton.
+ *
+ * Cells are packed one per bit, and every step replaces each 2x2 block of the current partition with
+ * its next state. Even steps use blocks with even coordinates, odd steps blocks shifted by one cell.
+ */
+class BlockWorld {
+	int width { }, height { };
+	BlockRule rule;
+	Bits::Plane cells;
+	unsigned long long generation { };
+	//The next state of 4 blocks side by side, indexed by 8 cells of the top row and 8 of the bottom row.
+	std::vector<std::uint16_t> even_blocks, odd_blocks;
+	void step_rows(Word *top, Word *bottom, const std::uint16_t *blocks, bool odd, bool toroidal) const;
+public:
+	BlockWorld(int width, int height, const BlockRule &rule);
+	BlockWorld(GridView state, const BlockRule &rule);
+	int get_width() const;
+	int get_height() const;
+	unsigned long long get_generation() const;
+	int get_alive_cells() const;
+	Cell get(int x, int y) const;
+	void set(int x, int y, Cell cell);
+	Grid get_state() const;
+	void step(bool toroidal = false);
+	void advance(int steps, bool toroidal = false);
+};
@@ -0,0 +1,327 @@
+/**
+ * Implements a Metrics class of counters and gauges for a running simulation, and a MetricsServer class that
+ * serves them over loopback HTTP in the Prometheus text format.
+ *      - The step loop calls Metrics::record_step, which only updates relaxed atomics, so it never waits
+ *        on the thread serving the metrics.
+ *      - The metrics exported are:
+ *          - gol_generation, the current generation.
+ *          - gol_steps_total, the number of steps recorded.
+ *          - gol_population, the number of alive cells.
+ *          - gol_generations_per_second, the rate since the previous scrape.
+ *          - gol_step_seconds, a histogram of step latencies.
+ *          - gol_queue_depth, the tasks queued or running on a watched ThreadPool.
+ *          - process_resident_memory_bytes, read from /proc/self/statm.
+ *          - process_uptime_seconds, the time since the metrics were created.
+ *
+ *      - The server only binds to 127.0.0.1, so the metrics are never exposed off the host.
+ *          - It answers GET /metrics, and 404 to anything else, one connection at a time.
+ *          - It polls for connections so it can be stopped promptly by its destructor.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#include "metrics.h"
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+const double Metrics::BUCKET_BOUNDS[Metrics::BUCKETS - 1] = { 1e-6, 1e-5, 1e-4, 1e-3, 1e-2, 1e-1, 1 };
+
+/**
+ * Metrics::Metrics()
+ *
+ * Construct metrics with every counter at 0.
+ */
+Metrics::Metrics() :
+		started(std::chrono::steady_clock::now()), rate_time(started) {
+	for (std::atomic<unsigned long long> &bucket : buckets) {
+		bucket.store(0);
+	}
+}
+
+/**
+ * Metrics::record_step(seconds, current_generation, current_population)
+ *
+ * Record a step of the simulation. Safe to call while the metrics are being rendered.
+ *
+ * @example
+ *
+ *      // Time every step of a world
+ *      auto start = std::chrono::steady_clock::now();
+ *      world.step();
+ *      metrics.record_step(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+ *              step + 1, world.get_alive_cells());
+ *
+ * @param seconds
+ *      The time the step took.
+ *
+ * @param current_generation
+ *      The generation after the step.
+ *
+ * @param current_population
+ *      The number of alive cells after the step.
+ */
+void Metrics::record_step(double seconds, unsigned long long current_generation, long long current_population) {
+	record_step(seconds, current_generation);
+	population.store(current_population, std::memory_order_relaxed);
+}
+
+/**
+ * Metrics::record_step(seconds, current_generation)
+ *
+ * Record a step of the simulation, leaving the population as last recorded.
+ * For loops that only count the population every so often, since counting it can scan every cell.
+ *
+ * @param seconds
+ *      The time the step took.
+ *
+ * @param current_generation
+ *      The generation after the step.
+ */
+void Metrics::record_step(double seconds, unsigned long long current_generation) {
+	int bucket = 0;
+	while (bucket < BUCKETS - 1 && seconds > BUCKET_BOUNDS[bucket]) {
+		bucket++;
+	}
+	buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+	step_nanoseconds.fetch_add((unsigned long long) (seconds * 1e9), std::memory_order_relaxed);
+	generation.store(current_generation, std::memory_order_relaxed);
+	steps.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Metrics::watch(queue)
+ *
+ * Report the number of tasks queued or running on a pool as the queue depth, or stop reporting it with nullptr.
+ * The pool must outlive the metrics, or be unwatched first. Unwatching waits for any render reading the pool.
+ */
+void Metrics::watch(ThreadPool *queue) {
+	std::lock_guard<std::mutex> guard(pool_lock);
+	pool = queue;
+}
+
+/**
+ * Metrics::get_generation()
+ *
+ * Gets the generation of the last step recorded.
+ */
+unsigned long long Metrics::get_generation() const {
+	return generation.load(std::memory_order_relaxed);
+}
+
+/**
+ * Metrics::get_steps()
+ *
+ * Gets the number of steps recorded.
+ */
+unsigned long long Metrics::get_steps() const {
+	return steps.load(std::memory_order_relaxed);
+}
+
+/**
+ * Metrics::resident_memory()
+ *
+ * Gets the resident memory of this process in bytes, read from /proc/self/statm.
+ *
+ * @return
+ *      Returns the resident memory, or -1 if it cannot be read.
+ */
+long long Metrics::resident_memory() {
+	std::ifstream statm("/proc/self/statm");
+	long long size, resident;
+	if (!(statm >> size >> resident)) {
+		return -1;
+	}
+	return resident * sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * Metrics::render()
+ *
+ * Render the metrics in the Prometheus text exposition format.
+ * The generations per second are measured since the previous render, or since construction.
+ *
+ * @return
+ *      Returns the metrics, one sample per line.
+ */
+std::string Metrics::render() {
+	const unsigned long long current = generation.load(std::memory_order_relaxed);
+	double rate;
+	{
+		std::lock_guard<std::mutex> guard(rate_lock);
+		const auto now = std::chrono::steady_clock::now();
+		const double seconds = std::chrono::duration<double>(now - rate_time).count();
+		rate = seconds > 0 && current >= rate_generation ? (current - rate_generation) / seconds : 0.0;
+		rate_generation = current;
+		rate_time = now;
+	}
+	std::ostringstream text;
+	text << "# HELP gol_generation The current generation.\n"
+			<< "# TYPE gol_generation gauge\n"
+			<< "gol_generation " << current << '\n'
+			<< "# HELP gol_steps_total The number of steps simulated.\n"
+			<< "# TYPE gol_steps_total counter\n"
+			<< "gol_steps_total " << steps.load(std::memory_order_relaxed) << '\n'
+			<< "# HELP gol_population The number of alive cells.\n"
+			<< "# TYPE gol_population gauge\n"
+			<< "gol_population " << population.load(std::memory_order_relaxed) << '\n'
+			<< "# HELP gol_generations_per_second The generations simulated per second since the last scrape.\n"
+			<< "# TYPE gol_generations_per_second gauge\n"
+			<< "gol_generations_per_second " << rate << '\n'
+			<< "# HELP gol_step_seconds The time taken by each step.\n"
+			<< "# TYPE gol_step_seconds histogram\n";
+	//Prometheus buckets are cumulative.
+	unsigned long long cumulative = 0;
+	for (int bucket = 0; bucket < BUCKETS; bucket++) {
+		cumulative += buckets[bucket].load(std::memory_order_relaxed);
+		text << "gol_step_seconds_bucket{le=\"";
+		if (bucket < BUCKETS - 1) {
+			text << BUCKET_BOUNDS[bucket];
+		} else {
+			text << "+Inf";
+		}
+		text << "\"} " << cumulative << '\n';
+	}
+	text << "gol_step_seconds_sum " << step_nanoseconds.load(std::memory_order_relaxed) / 1e9 << '\n'
+			<< "gol_step_seconds_count " << cumulative << '\n';
+	int depth;
+	{
+		std::lock_guard<std::mutex> guard(pool_lock);
+		depth = pool != nullptr ? pool->get_pending() : 0;
+	}
+	text << "# HELP gol_queue_depth The number of tasks queued or running.\n"
+			<< "# TYPE gol_queue_depth gauge\n"
+			<< "gol_queue_depth " << depth << '\n'
+			<< "# HELP process_resident_memory_bytes Resident memory size in bytes.\n"
+			<< "# TYPE process_resident_memory_bytes gauge\n"
+			<< "process_resident_memory_bytes " << resident_memory() << '\n'
+			<< "# HELP process_uptime_seconds The time since the metrics were created.\n"
+			<< "# TYPE process_uptime_seconds gauge\n"
+			<< "process_uptime_seconds "
+			<< std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count() << '\n';
+	return text.str();
+}
+
+/**
+ * MetricsServer::MetricsServer(metrics, port)
+ *
+ * Start serving metrics on 127.0.0.1 from a new thread.
+ *
+ * @example
+ *
+ *      // Serve metrics for Prometheus to scrape from http://127.0.0.1:9100/metrics
+ *      Metrics metrics;
+ *      MetricsServer server(metrics, 9100);
+ *
+ * @param metrics
+ *      The metrics to serve, which must outlive the server.
+ *
+ * @param port
+ *      The port to listen on, or 0 for any free port.
+ *
+ * @throws
+ *      Throws std::runtime_error if the port cannot be listened on.
+ */
+MetricsServer::MetricsServer(Metrics &metrics, int port) :
+		metrics(metrics) {
+	listener = socket(AF_INET, SOCK_STREAM, 0);
+	if (listener < 0) {
+		throw std::runtime_error("Unable to create the metrics socket.");
+	}
+	int reuse = 1;
+	setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+	sockaddr_in address;
+	std::memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	address.sin_port = htons(port);
+	socklen_t length = sizeof(address);
+	if (bind(listener, (sockaddr*) &address, sizeof(address)) != 0 || listen(listener, 8) != 0
+			|| getsockname(listener, (sockaddr*) &address, &length) != 0) {
+		close(listener);
+		throw std::runtime_error("Unable to listen for metrics on port " + std::to_string(port) + ".");
+	}
+	this->port = ntohs(address.sin_port);
+	thread = std::thread(&MetricsServer::serve, this);
+}
+
+/**
+ * MetricsServer::~MetricsServer()
+ *
+ * Stop serving and join the serving thread.
+ */
+MetricsServer::~MetricsServer() {
+	stopping = true;
+	thread.join();
+	close(listener);
+}
+
+/**
+ * MetricsServer::get_port()
+ *
+ * Gets the port being listened on, useful when constructed with port 0.
+ */
+int MetricsServer::get_port() const {
+	return port;
+}
+
+/**
+ * MetricsServer::serve()
+ *
+ * Private method run by the serving thread, answering one connection at a time until stopped.
+ */
+void MetricsServer::serve() {
+	while (!stopping) {
+		pollfd ready = { listener, POLLIN, 0 };
+		if (poll(&ready, 1, 100) <= 0) {
+			continue;
+		}
+		int client = accept(listener, nullptr, nullptr);
+		if (client < 0) {
+			continue;
+		}
+		//Read the request head, giving up on clients that stall.
+		std::string request;
+		char buffer[1024];
+		pollfd readable = { client, POLLIN, 0 };
+		while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192
+				&& poll(&readable, 1, 1000) > 0) {
+			ssize_t received = recv(client, buffer, sizeof(buffer), 0);
+			if (received <= 0) {
+				break;
+			}
+			request.append(buffer, received);
+		}
+		std::string status = "200 OK", body;
+		if (request.compare(0, 12, "GET /metrics") == 0 && request.size() > 12
+				&& (request[12] == ' ' || request[12] == '?')) {
+			body = metrics.render();
+		} else {
+			status = "404 Not Found";
+			body = "Not found, the metrics are served at /metrics.\n";
+		}
+		std::ostringstream response;
+		response << "HTTP/1.1 " << status << "\r\n"
+				<< "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+				<< "Content-Length: " << body.size() << "\r\n"
+				<< "Connection: close\r\n\r\n" << body;
+		const std::string bytes = response.str();
+		for (std::size_t sent = 0; sent < bytes.size();) {
+			ssize_t written = send(client, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+			if (written <= 0) {
+				break;
+			}
+			sent += written;
+		}
+		close(client);
+	}
+}
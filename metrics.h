@@ -0,0 +1,69 @@
+/**
+ * Declares a Metrics class of counters and gauges for a running simulation, and a MetricsServer class that
+ * serves them over loopback HTTP in the Prometheus text format.
+ * Rich documentation for the api and behaviour of both classes can be found in metrics.cpp.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the class.
+// #include ...
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "pool.h"
+
+/**
+ * Declare the structure of the Metrics class for recording a simulation without locking it.
+ *
+ * The step loop only ever stores to atomics, the scraping thread reads them and does all the formatting.
+ */
+class Metrics {
+public:
+	//The upper bounds in seconds of the step latency histogram buckets, the last bucket is unbounded.
+	static const int BUCKETS = 8;
+	static const double BUCKET_BOUNDS[BUCKETS - 1];
+private:
+	std::atomic<unsigned long long> generation { }, steps { }, step_nanoseconds { };
+	std::atomic<long long> population { };
+	std::atomic<unsigned long long> buckets[BUCKETS];
+	//Held by Metrics::watch and while rendering the depth of the pool, so a pool is never unwatched mid-render.
+	std::mutex pool_lock;
+	ThreadPool *pool { };
+	std::chrono::steady_clock::time_point started;
+	std::mutex rate_lock;
+	unsigned long long rate_generation { };
+	std::chrono::steady_clock::time_point rate_time;
+public:
+	Metrics();
+	Metrics(const Metrics&) = delete;
+	Metrics& operator=(const Metrics&) = delete;
+	void record_step(double seconds, unsigned long long current_generation, long long current_population);
+	void record_step(double seconds, unsigned long long current_generation);
+	void watch(ThreadPool *queue);
+	unsigned long long get_generation() const;
+	unsigned long long get_steps() const;
+	std::string render();
+	static long long resident_memory();
+};
+
+/**
+ * Declare the structure of the MetricsServer class for serving Metrics on 127.0.0.1 from a thread of its own.
+ */
+class MetricsServer {
+	Metrics &metrics;
+	int listener { -1 }, port { };
+	std::atomic<bool> stopping { };
+	std::thread thread;
+	void serve();
+public:
+	MetricsServer(Metrics &metrics, int port);
+	~MetricsServer();
+	MetricsServer(const MetricsServer&) = delete;
+	MetricsServer& operator=(const MetricsServer&) = delete;
+	int get_port() const;
+};
@@ -0,0 +1,139 @@
+/**
+ * Implements a Pattern namespace with methods for normalising patterns so that copies of the same pattern compare equal.
+ *      - Trimming removes the dead border around a pattern, so translated copies become identical.
+ *      - The canonical form of a pattern is the smallest of its 8 symmetries (the 4 rotations of Grid::rotate,
+ *        with and without mirroring), so rotated and reflected copies become identical too.
+ *      - Canonical hashes let searches deduplicate the patterns they find without storing them.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#include "pattern.h"
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include <cstring>
+
+/**
+ * Pattern::trim(pattern)
+ *
+ * Crop a pattern to the bounding box of its alive cells, without copying it.
+ *
+ * @example
+ *
+ *      // A glider in the middle of a large grid trims to its 3x3 bounding box
+ *      Grid grid(16);
+ *      grid.merge(Zoo::glider(), 5, 5);
+ *      GridView glider = Pattern::trim(grid);
+ *
+ * @param pattern
+ *      The pattern to trim.
+ *
+ * @return
+ *      Returns a view of the bounding box, which is 0x0 if no cells are alive.
+ */
+GridView Pattern::trim(GridView pattern) {
+	int x0 = pattern.get_width(), y0 = pattern.get_height(), x1 = -1, y1 = -1;
+	for (int y = 0; y < pattern.get_height(); y++) {
+		const Cell *row = pattern.row(y);
+		for (int x = 0; x < pattern.get_width(); x++) {
+			if (row[x] == Cell::ALIVE) {
+				x0 = std::min(x0, x);
+				x1 = std::max(x1, x);
+				y0 = std::min(y0, y);
+				y1 = std::max(y1, y);
+			}
+		}
+	}
+	if (x1 < 0) {
+		return GridView();
+	}
+	return pattern.crop(x0, y0, x1 + 1, y1 + 1);
+}
+
+/**
+ * Pattern::mirror(pattern)
+ *
+ * Create a copy of a pattern reflected left to right.
+ *
+ * @param pattern
+ *      The pattern to reflect.
+ *
+ * @return
+ *      Returns a new grid containing the reflection.
+ */
+Grid Pattern::mirror(GridView pattern) {
+	Grid mirrored(pattern.get_width(), pattern.get_height());
+	for (int y = 0; y < pattern.get_height(); y++) {
+		std::reverse_copy(pattern.row(y), pattern.row(y) + pattern.get_width(),
+				mirrored.data() + y * pattern.get_width());
+	}
+	return mirrored;
+}
+
+/**
+ * Pattern::less(a, b)
+ *
+ * A strict total order on patterns, by width, then height, then cells in row major order.
+ *
+ * @return
+ *      Returns true if a orders before b.
+ */
+bool Pattern::less(GridView a, GridView b) {
+	if (a.get_width() != b.get_width()) {
+		return a.get_width() < b.get_width();
+	}
+	if (a.get_height() != b.get_height()) {
+		return a.get_height() < b.get_height();
+	}
+	for (int y = 0; y < a.get_height(); y++) {
+		int order = std::memcmp(a.row(y), b.row(y), a.get_width());
+		if (order != 0) {
+			return order < 0;
+		}
+	}
+	return false;
+}
+
+/**
+ * Pattern::canonical(pattern)
+ *
+ * Get the canonical form of a pattern, the smallest of the 8 symmetries of its trimmed bounding box.
+ * Two patterns have the same canonical form exactly if one is a translation, rotation, or reflection
+ * of the other.
+ *
+ * @example
+ *
+ *      // All 4 orientations of a glider have the same canonical form
+ *      bool same = Pattern::less(Pattern::canonical(Zoo::glider()), Pattern::canonical(Zoo::glider().rotate(1)))
+ *              == false;
+ *
+ * @param pattern
+ *      The pattern to canonicalise.
+ *
+ * @return
+ *      Returns a new grid holding the canonical form.
+ */
+Grid Pattern::canonical(GridView pattern) {
+	GridView trimmed = trim(pattern);
+	Grid mirrored = mirror(trimmed);
+	Grid best = trimmed;
+	for (int rotation = 0; rotation < 4; rotation++) {
+		Grid candidates[] = { trimmed.rotate(rotation), mirrored.rotate(rotation) };
+		for (const Grid &candidate : candidates) {
+			if (less(candidate, best)) {
+				best = candidate;
+			}
+		}
+	}
+	return best;
+}
+
+/**
+ * Pattern::canonical_hash(pattern)
+ *
+ * Get the hash of the canonical form of a pattern.
+ */
+unsigned long long Pattern::canonical_hash(GridView pattern) {
+	return GridView(canonical(pattern)).hash();
+}
@@ -0,0 +1,24 @@
+/**
+ * Declares a Pattern namespace with methods for normalising patterns so that copies of the same pattern compare equal.
+ * Rich documentation for the api and behaviour the Pattern namespace can be found in pattern.cpp.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the namespace.
+// #include ...
+#include "grid.h"
+
+/**
+ * Declare the interface of the Pattern namespace for canonicalising and comparing patterns.
+ */
+namespace Pattern {
+GridView trim(GridView pattern);
+Grid mirror(GridView pattern);
+bool less(GridView a, GridView b);
+Grid canonical(GridView pattern);
+unsigned long long canonical_hash(GridView pattern);
+}
+;
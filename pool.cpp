@@ -0,0 +1,199 @@
+/**
+ * Implements a class representing a fixed size pool of worker threads.
+ *      - Tasks are queued first in, first out and run on the first idle worker.
+ *      - Each task is passed the index of the worker running it.
+ *      - The pool can be waited on until every submitted task has finished.
+ *      - Destroying the pool finishes the queued tasks and joins the workers.
+ *      - A task that forks tasks of its own can join them with ThreadPool::run_one, running queued tasks
+ *        itself instead of blocking a worker, so nested fork and join never deadlocks the pool.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#include "pool.h"
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+
+namespace {
+
+//The pool and worker index of the current thread, if it is a worker.
+thread_local ThreadPool *current_pool = nullptr;
+thread_local int current_worker = -1;
+
+}
+
+/**
+ * ThreadPool::ThreadPool(threads)
+ *
+ * Construct a pool and start its worker threads.
+ *
+ * @example
+ *
+ *      // Make a pool with one worker per core
+ *      ThreadPool pool;
+ *
+ *      // Make a pool with 4 workers
+ *      ThreadPool small(4);
+ *
+ * @param threads
+ *      Optional parameter. The number of workers, or 0 for one per hardware thread. Defaults to 0.
+ */
+ThreadPool::ThreadPool(int threads) {
+	if (threads <= 0) {
+		threads = default_threads();
+	}
+	for (int i = 0; i < threads; i++) {
+		workers.emplace_back(&ThreadPool::work, this, i);
+	}
+}
+
+/**
+ * ThreadPool::~ThreadPool()
+ *
+ * Finish every queued task and join the workers.
+ */
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+	task_ready.notify_all();
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+}
+
+/**
+ * ThreadPool::default_threads()
+ *
+ * Gets the number of hardware threads, or 1 if it cannot be determined.
+ */
+int ThreadPool::default_threads() {
+	int threads = (int) std::thread::hardware_concurrency();
+	return threads > 0 ? threads : 1;
+}
+
+/**
+ * ThreadPool::get_size()
+ *
+ * Gets the number of workers in the pool.
+ */
+int ThreadPool::get_size() const {
+	return (int) workers.size();
+}
+
+/**
+ * ThreadPool::get_pending()
+ *
+ * Gets the number of tasks queued or running.
+ */
+int ThreadPool::get_pending() {
+	std::lock_guard<std::mutex> guard(lock);
+	return (int) tasks.size() + running;
+}
+
+/**
+ * ThreadPool::submit(task)
+ *
+ * Queue a task to run on the next idle worker.
+ *
+ * @example
+ *
+ *      // Give each worker its own scratch world
+ *      std::vector<World> scratch(pool.get_size());
+ *      pool.submit([&](int worker) {
+ *          scratch[worker].advance(10);
+ *      });
+ *
+ * @param task
+ *      The task to run. It is passed the index of the worker running it.
+ *      Tasks must catch their own exceptions, an exception escaping a worker terminates the program.
+ */
+void ThreadPool::submit(std::function<void(int)> task) {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		tasks.push_back(std::move(task));
+	}
+	task_ready.notify_one();
+}
+
+/**
+ * ThreadPool::wait()
+ *
+ * Block until every submitted task has finished running.
+ */
+void ThreadPool::wait() {
+	std::unique_lock<std::mutex> guard(lock);
+	all_done.wait(guard, [this]() {
+		return tasks.empty() && running == 0;
+	});
+}
+
+/**
+ * ThreadPool::run_one()
+ *
+ * Run the most recently queued task on the calling worker, so a task waiting on tasks it forked
+ * can help run them rather than blocking. The newest task is taken, which is most likely one it forked.
+ *
+ * @example
+ *
+ *      // Fork two halves of a job from inside a task, then help until both are done
+ *      std::atomic<int> remaining(2);
+ *      pool.submit([&](int) { left(); remaining--; });
+ *      pool.submit([&](int) { right(); remaining--; });
+ *      while (remaining > 0) {
+ *          if (!pool.run_one()) {
+ *              std::this_thread::yield();
+ *          }
+ *      }
+ *
+ * @return
+ *      Returns true if a task was run, false if the queue was empty or the caller is not a worker of this pool.
+ */
+bool ThreadPool::run_one() {
+	if (current_pool != this) {
+		return false;
+	}
+	std::unique_lock<std::mutex> guard(lock);
+	if (tasks.empty()) {
+		return false;
+	}
+	std::function<void(int)> task = std::move(tasks.back());
+	tasks.pop_back();
+	running++;
+	guard.unlock();
+	task(current_worker);
+	guard.lock();
+	running--;
+	return true;
+}
+
+/**
+ * ThreadPool::work(worker)
+ *
+ * Private loop run by each worker, taking tasks off the queue until the pool is destroyed.
+ */
+void ThreadPool::work(int worker) {
+	current_pool = this;
+	current_worker = worker;
+	std::unique_lock<std::mutex> guard(lock);
+	while (true) {
+		task_ready.wait(guard, [this]() {
+			return stopping || !tasks.empty();
+		});
+		if (tasks.empty()) {
+			return;
+		}
+		std::function<void(int)> task = std::move(tasks.front());
+		tasks.pop_front();
+		running++;
+		guard.unlock();
+		task(worker);
+		guard.lock();
+		running--;
+		if (tasks.empty() && running == 0) {
+			all_done.notify_all();
+		}
+	}
+}
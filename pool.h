@@ -0,0 +1,44 @@
+/**
+ * Declares a class representing a fixed size pool of worker threads.
+ * Rich documentation for the api and behaviour the ThreadPool class can be found in pool.cpp.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the class.
+// #include ...
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Declare the structure of the ThreadPool class for running tasks across cores.
+ *
+ * Tasks are handed the index of the worker running them, from 0 to get_size() - 1,
+ * so callers can keep per-worker scratch buffers without any locking.
+ */
+class ThreadPool {
+	std::vector<std::thread> workers;
+	std::deque<std::function<void(int)>> tasks;
+	std::mutex lock;
+	std::condition_variable task_ready, all_done;
+	int running { };
+	bool stopping { };
+	void work(int worker);
+public:
+	explicit ThreadPool(int threads = 0);
+	~ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	int get_size() const;
+	int get_pending();
+	void submit(std::function<void(int)> task);
+	void wait();
+	bool run_one();
+	static int default_threads();
+};
@@ -0,0 +1,227 @@
+/**
+ * Implements a Predecessor namespace with methods for searching for a Grid that steps into a target Grid.
+ *      - A predecessor of a target is a grid of the same size that becomes the target after one
+ *        non-toroidal World::step. A target without one is a Garden of Eden.
+ *          - The search can be widened with a margin of extra cells on every side, in which case the
+ *            predecessor is bigger than the target and must step into the target surrounded by dead cells.
+ *
+ *      - The search is a backtracking search that fixes the predecessor one row at a time.
+ *          - Once rows r-1, r, and r+1 are fixed, row r of the target is determined, so each row is only
+ *            extended with continuations that reproduce the target row above it.
+ *          - Continuations are themselves built one cell at a time, checking every finished cell of the
+ *            target row at once with the bit-parallel Bits::next_row, so dead branches are cut early.
+ *          - The continuations of each pair of rows are memoised, as are the pairs of rows that are
+ *            known to lead nowhere, so repeated sub-problems are only solved once.
+ *
+ *      - The first row is split into ranges that are searched in parallel on the workers of a ThreadPool,
+ *        each worker keeping its own memo tables. The search stops as soon as any worker finds a predecessor.
+ *
+ *      - Rows are packed one cell per bit, so the predecessor can be at most 32 cells wide.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#include "predecessor.h"
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include "bits.h"
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+/**
+ * A Key identifies a pair of rows, either with the target row they must produce or the row index they are at.
+ */
+struct Key {
+	Word up, row, extra;
+	bool operator==(const Key &other) const {
+		return up == other.up && row == other.row && extra == other.extra;
+	}
+};
+
+struct KeyHash {
+	std::size_t operator()(const Key &key) const {
+		return (std::size_t) ((key.up * 0x9E3779B97F4A7C15ull) ^ (key.row * 0xC2B2AE3D27D4EB4Full) ^ key.extra);
+	}
+};
+
+/**
+ * The search state of one worker, kept between tasks so its memo tables are reused.
+ */
+struct Searcher {
+	const Rule *rule { };
+	const std::vector<Word> *target { };
+	int width { }, height { };
+	const std::atomic<bool> *done { };
+	std::unordered_map<Key, std::vector<Word>, KeyHash> continuations;
+	std::unordered_set<Key, KeyHash> dead_ends;
+	std::vector<Word> rows;
+	long long nodes { };
+
+	/**
+	 * Collect every row below that, together with up and row, steps row into the target row t.
+	 * The bits of the row below are decided from column 0 up, and once bit x is decided cell x - 1
+	 * of the target row can no longer change, so every finished cell is checked after each bit.
+	 */
+	void extend(Word up, Word row, Word t, Word below, int bit, std::vector<Word> &out) {
+		for (Word value = 0; value < 2; value++) {
+			Word candidate = below | (value << bit);
+			Word decided = Bits::width_mask(bit + 1 == width ? width : bit);
+			if ((Bits::next_row(*rule, up, row, candidate, width) ^ t) & decided) {
+				continue;
+			}
+			if (bit + 1 == width) {
+				out.push_back(candidate);
+			} else {
+				extend(up, row, t, candidate, bit + 1, out);
+			}
+		}
+	}
+
+	const std::vector<Word>& below(Word up, Word row, Word t) {
+		Key key = { up, row, t };
+		auto found = continuations.find(key);
+		if (found != continuations.end()) {
+			return found->second;
+		}
+		//Keep the memo from growing without bound on wide searches.
+		if (continuations.size() > (1u << 20)) {
+			continuations.clear();
+		}
+		std::vector<Word> &out = continuations[key];
+		extend(up, row, t, 0, 0, out);
+		return out;
+	}
+
+	/**
+	 * Search for the rows below row r, given row r - 1 (up) and row r.
+	 */
+	bool search(int r, Word up, Word row) {
+		nodes++;
+		rows[r] = row;
+		if (*done) {
+			return false;
+		}
+		//The row below the last row is always dead.
+		if (r == height - 1) {
+			return Bits::next_row(*rule, up, row, 0, width) == (*target)[r];
+		}
+		Key key = { up, row, (Word) r };
+		if (dead_ends.count(key)) {
+			return false;
+		}
+		//Copy the continuations, the memo table may rehash while searching deeper rows.
+		std::vector<Word> candidates = below(up, row, (*target)[r]);
+		for (Word candidate : candidates) {
+			if (search(r + 1, row, candidate)) {
+				return true;
+			}
+		}
+		if (dead_ends.size() > (1u << 22)) {
+			dead_ends.clear();
+		}
+		dead_ends.insert(key);
+		return false;
+	}
+};
+
+}
+
+/**
+ * Predecessor::search(target, pool, margin, rule)
+ *
+ * Search for a predecessor of a target, or prove that none exists within the bounds.
+ *
+ * @example
+ *
+ *      // Look for a predecessor of a glider, allowing one extra cell on every side
+ *      ThreadPool pool;
+ *      Predecessor::Result result = Predecessor::search(Zoo::glider(), pool, 1);
+ *      if (result.found) {
+ *          std::cout << result.predecessor << std::endl;
+ *      }
+ *
+ * @param target
+ *      The grid the predecessor must step into.
+ *
+ * @param pool
+ *      The pool to search on.
+ *
+ * @param margin
+ *      Optional parameter. The number of extra cells on every side of the predecessor. Defaults to 0.
+ *
+ * @param rule
+ *      Optional parameter. The rule to step with. Defaults to B3/S23.
+ *
+ * @return
+ *      Returns whether a predecessor was found, and if so the predecessor, which is the size of the
+ *      target plus the margin on every side.
+ *
+ * @throws
+ *      Throws std::runtime_error if the margin is negative or the predecessor would be wider than 32 cells.
+ */
+Predecessor::Result Predecessor::search(GridView target, ThreadPool &pool, int margin, const Rule &rule) {
+	if (margin < 0) {
+		throw std::runtime_error("The margin must not be negative.");
+	}
+	const int width = target.get_width() + 2 * margin, height = target.get_height() + 2 * margin;
+	if (width > 32) {
+		throw std::runtime_error("The predecessor must be at most 32 cells wide.");
+	}
+	Result result;
+	result.predecessor = Grid(width, height);
+	if (width == 0 || height == 0) {
+		result.found = true;
+		return result;
+	}
+
+	//Pad the target with dead rows and columns for the margin.
+	std::vector<Word> rows(height, 0);
+	for (int y = 0; y < target.get_height(); y++) {
+		rows[y + margin] = Bits::pack_row(target.row(y), target.get_width()) << margin;
+	}
+
+	std::atomic<bool> done(false);
+	std::mutex lock;
+	std::vector<Searcher> searchers(pool.get_size());
+	for (Searcher &searcher : searchers) {
+		searcher.rule = &rule;
+		searcher.target = &rows;
+		searcher.width = width;
+		searcher.height = height;
+		searcher.done = &done;
+		searcher.rows.resize(height);
+	}
+
+	//Split the choices for the first row into chunks, enough for the workers to balance their load.
+	const Word first_rows = 1ull << width;
+	const Word chunk = std::max<Word>(1, first_rows / (Word) (pool.get_size() * 64));
+	for (Word start = 0; start < first_rows; start += chunk) {
+		Word end = std::min(first_rows, start + chunk);
+		pool.submit([&, start, end](int worker) {
+			Searcher &searcher = searchers[worker];
+			for (Word first = start; first < end && !done; first++) {
+				if (searcher.search(0, 0, first)) {
+					std::lock_guard<std::mutex> guard(lock);
+					if (!done) {
+						done = true;
+						result.found = true;
+						for (int y = 0; y < height; y++) {
+							Bits::unpack_row(searcher.rows[y], result.predecessor.data() + y * width, width);
+						}
+					}
+				}
+			}
+		});
+	}
+	pool.wait();
+	for (const Searcher &searcher : searchers) {
+		result.nodes += searcher.nodes;
+	}
+	return result;
+}
@@ -0,0 +1,33 @@
+/**
+ * Declares a Predecessor namespace with methods for searching for a Grid that steps into a target Grid.
+ * Rich documentation for the api and behaviour the Predecessor namespace can be found in predecessor.cpp.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the namespace.
+// #include ...
+#include "grid.h"
+#include "rule.h"
+#include "pool.h"
+
+/**
+ * Declare the interface of the Predecessor namespace for Garden of Eden searches.
+ */
+namespace Predecessor {
+
+/**
+ * A Result records whether a predecessor was found, the predecessor if it was,
+ * and the number of search nodes visited.
+ */
+struct Result {
+	bool found { };
+	Grid predecessor;
+	long long nodes { };
+};
+
+Result search(GridView target, ThreadPool &pool, int margin = 0, const Rule &rule = Rule());
+}
+;
@@ -0,0 +1,201 @@
+/**
+ * Implements a class representing an outer totalistic birth/survival rule for a 2d cellular automaton.
+ *      - Rules count the alive cells in the 3x3 Moore neighbourhood around a cell, excluding the cell itself.
+ *      - Rules default to Conway's Game of Life, B3/S23.
+ *      - Rules can be parsed from and printed to the common B/S notation.
+ *          - https://www.conwaylife.com/wiki/Rulestring
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#include "rule.h"
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include <cctype>
+
+/**
+ * Rule::Rule()
+ *
+ * Construct the rule for Conway's Game of Life, B3/S23.
+ *
+ * @example
+ *
+ *      // Make the default rule
+ *      Rule rule;
+ *
+ */
+Rule::Rule() :
+		Rule(1 << 3, (1 << 2) | (1 << 3)) {
+}
+
+/**
+ * Rule::Rule(birth, survival)
+ *
+ * Construct a rule from a birth and a survival bit mask.
+ * Only the lowest 9 bits (neighbour counts 0 to 8) of each mask are kept.
+ *
+ * @example
+ *
+ *      // Make HighLife, B36/S23
+ *      Rule rule((1 << 3) | (1 << 6), (1 << 2) | (1 << 3));
+ *
+ * @param birth
+ *      Bit n is set if a dead cell with n alive neighbours becomes alive.
+ *
+ * @param survival
+ *      Bit n is set if an alive cell with n alive neighbours stays alive.
+ */
+Rule::Rule(unsigned int birth, unsigned int survival) :
+		birth_mask(birth & 0x1FF), survival_mask(survival & 0x1FF) {
+}
+
+/**
+ * Rule::parse(notation)
+ *
+ * Parse a rule from B/S notation, e.g. "B3/S23". The letters are case insensitive
+ * and the classic S/B notation without letters, e.g. "23/3", is also accepted.
+ *
+ * @example
+ *
+ *      // Parse Day & Night
+ *      Rule rule = Rule::parse("B3678/S34678");
+ *
+ * @param notation
+ *      The rule string to parse.
+ *
+ * @return
+ *      Returns the parsed rule.
+ *
+ * @throws
+ *      Throws std::runtime_error if the notation is not a valid B/S rule.
+ */
+Rule Rule::parse(std::string notation) {
+	std::size_t slash = notation.find('/');
+	if (slash == std::string::npos) {
+		throw std::runtime_error("The rule is not in B/S notation.");
+	}
+	std::string first = notation.substr(0, slash), second = notation.substr(slash + 1);
+	//Read the digits of one half of the rule, starting after any leading letter.
+	auto read_mask = [](const std::string &part, std::size_t from) {
+		unsigned int mask = 0;
+		for (std::size_t i = from; i < part.size(); i++) {
+			if (part[i] < '0' || part[i] > '8') {
+				throw std::runtime_error("The rule contains an invalid neighbour count.");
+			}
+			mask |= 1u << (part[i] - '0');
+		}
+		return mask;
+	};
+	char first_letter = first.empty() ? '\0' : (char) std::toupper(first[0]);
+	char second_letter = second.empty() ? '\0' : (char) std::toupper(second[0]);
+	if (first_letter == 'B' && second_letter == 'S') {
+		return Rule(read_mask(first, 1), read_mask(second, 1));
+	}
+	if (first_letter == 'S' && second_letter == 'B') {
+		return Rule(read_mask(second, 1), read_mask(first, 1));
+	}
+	//The classic notation lists the survival counts before the birth counts.
+	return Rule(read_mask(second, 0), read_mask(first, 0));
+}
+
+/**
+ * Rule::get_birth()
+ *
+ * Gets the birth bit mask of the rule.
+ *
+ * @return
+ *      The birth mask, bit n is set if a dead cell with n neighbours becomes alive.
+ */
+unsigned int Rule::get_birth() const {
+	return birth_mask;
+}
+
+/**
+ * Rule::get_survival()
+ *
+ * Gets the survival bit mask of the rule.
+ *
+ * @return
+ *      The survival mask, bit n is set if an alive cell with n neighbours stays alive.
+ */
+unsigned int Rule::get_survival() const {
+	return survival_mask;
+}
+
+/**
+ * Rule::is_born(neighbours)
+ *
+ * Checks if a dead cell with the given number of alive neighbours becomes alive.
+ *
+ * @param neighbours
+ *      The number of alive neighbours, from 0 to 8.
+ *
+ * @return
+ *      Returns true if the cell is born.
+ */
+bool Rule::is_born(int neighbours) const {
+	return (birth_mask >> neighbours) & 1;
+}
+
+/**
+ * Rule::survives(neighbours)
+ *
+ * Checks if an alive cell with the given number of alive neighbours stays alive.
+ *
+ * @param neighbours
+ *      The number of alive neighbours, from 0 to 8.
+ *
+ * @return
+ *      Returns true if the cell survives.
+ */
+bool Rule::survives(int neighbours) const {
+	return (survival_mask >> neighbours) & 1;
+}
+
+/**
+ * Rule::to_string()
+ *
+ * Prints the rule in B/S notation.
+ *
+ * @example
+ *
+ *      // Prints B3/S23
+ *      std::cout << Rule().to_string() << std::endl;
+ *
+ * @return
+ *      Returns the rule string.
+ */
+std::string Rule::to_string() const {
+	std::string notation = "B";
+	for (int i = 0; i <= 8; i++) {
+		if (is_born(i)) {
+			notation += (char) ('0' + i);
+		}
+	}
+	notation += "/S";
+	for (int i = 0; i <= 8; i++) {
+		if (survives(i)) {
+			notation += (char) ('0' + i);
+		}
+	}
+	return notation;
+}
+
+/**
+ * Rule::operator==(other)
+ *
+ * Rules are equal if they have the same birth and survival masks.
+ */
+bool Rule::operator==(const Rule &other) const {
+	return birth_mask == other.birth_mask && survival_mask == other.survival_mask;
+}
+
+/**
+ * Rule::operator!=(other)
+ *
+ * Rules are different if their birth or survival masks differ.
+ */
+bool Rule::operator!=(const Rule &other) const {
+	return !(*this == other);
+}
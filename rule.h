@@ -0,0 +1,34 @@
+/**
+ * Declares a class representing an outer totalistic birth/survival rule for a 2d cellular automaton.
+ * Rich documentation for the api and behaviour the Rule class can be found in rule.cpp.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the class.
+// #include ...
+#include <string>
+#include <stdexcept>
+
+/**
+ * Declare the structure of the Rule class for representing a B/S rule on the Moore neighbourhood.
+ *
+ * Bit n of the birth mask is set if a dead cell with n alive neighbours becomes alive.
+ * Bit n of the survival mask is set if an alive cell with n alive neighbours stays alive.
+ */
+class Rule {
+	unsigned int birth_mask { }, survival_mask { };
+public:
+	Rule();
+	Rule(unsigned int birth, unsigned int survival);
+	static Rule parse(std::string notation);
+	unsigned int get_birth() const;
+	unsigned int get_survival() const;
+	bool is_born(int neighbours) const;
+	bool survives(int neighbours) const;
+	std::string to_string() const;
+	bool operator==(const Rule &other) const;
+	bool operator!=(const Rule &other) const;
+};
@@ -0,0 +1,384 @@
+/**
+ * Implements a Search namespace with methods for enumerating still lifes and oscillators that fit in a bounding box.
+ *      - Patterns are searched for in a width x height bounding box, with rows packed one cell per bit.
+ *          - Only patterns touching the top and left edges of the box are considered, so every pattern is
+ *            visited once rather than once per translation that fits.
+ *          - Every pattern found is reduced to its canonical form with the Pattern namespace and deduplicated
+ *            by its canonical hash, so rotations, reflections, and (for oscillators) phases are reported once.
+ *          - Patterns made of several separate still lifes or oscillators are reported too.
+ *
+ *      - Still lifes are searched for depth first, a row at a time, with bit-parallel constraint propagation.
+ *          - A still life is a pattern that steps into itself, so once rows r-1, r, and r+1 are fixed,
+ *            row r is checked against its own next state with Bits::next_row.
+ *          - Each row is built a cell at a time and every finished cell of the row above is checked at once,
+ *            so inconsistent rows are abandoned as soon as they go wrong.
+ *          - The rows above and below the box and the columns either side of it must stay dead.
+ *
+ *      - Oscillators of period p are searched for in the same way, depth first a cell at a time, on a board
+ *        padded by p cells, which is as far as a pattern can grow in p steps.
+ *          - Only the first phase is chosen. Once row r of it is fixed, row r - t of phase t follows from
+ *            the rows above it with Bits::next_row, so every phase is stepped a row behind the one before.
+ *          - Row r - p of phase p must equal the same row of the first phase, and each of its cells is
+ *            checked as soon as the cells up to p columns either side of it have been decided.
+ *          - The check lags p rows behind the row being decided, so the work grows exponentially with the
+ *            width times the period, rather than with the area of the box like an exhaustive enumeration.
+ *          - Oscillators that repeat sooner than p steps, or die, are rejected, and each one found is
+ *            canonicalised across the phases the search has already stepped.
+ *
+ *      - The first row is distributed across the workers of a ThreadPool.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#include "search.h"
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include "bits.h"
+#include "pattern.h"
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace {
+
+/**
+ * The deduplicated patterns found so far, shared by every worker.
+ */
+struct Catalogue {
+	std::mutex lock;
+	std::unordered_set<unsigned long long> seen;
+	std::vector<Search::Found> found;
+
+	void record(const Grid &canonical, int period) {
+		std::lock_guard<std::mutex> guard(lock);
+		if (seen.insert(GridView(canonical).hash()).second) {
+			Search::Found pattern;
+			pattern.pattern = canonical;
+			pattern.period = period;
+			found.push_back(pattern);
+		}
+	}
+
+	std::vector<Search::Found> sorted() {
+		std::sort(found.begin(), found.end(), [](const Search::Found &a, const Search::Found &b) {
+			return Pattern::less(a.pattern, b.pattern);
+		});
+		return found;
+	}
+};
+
+/**
+ * unpack(rows, width, shift)
+ *
+ * Private helper to unpack rows of bits into a grid, dropping the lowest shift bits of each row.
+ */
+Grid unpack(const std::vector<Word> &rows, int first, int count, int width, int shift) {
+	Grid grid(width, count);
+	for (int y = 0; y < count; y++) {
+		Bits::unpack_row(rows[first + y] >> shift, grid.data() + y * width, width);
+	}
+	return grid;
+}
+
+/**
+ * The depth first still life search from one first row.
+ * rows[0] and rows[height + 1] are the dead rows outside the box, and bit 0 and bit width + 1
+ * of each row are the dead columns outside it, so the box occupies bits 1 to width.
+ */
+struct StillLifeSearch {
+	const Rule *rule { };
+	int width { }, height { };
+	std::vector<Word> rows;
+	Catalogue *catalogue { };
+	std::vector<Word> *collect { };
+
+	/**
+	 * Decide the bits of rows[i] from bit up to width, keeping rows[i - 1] a still row.
+	 */
+	void extend(int i, Word candidate, int bit) {
+		const int padded = width + 2;
+		const Word up = i >= 2 ? rows[i - 2] : 0;
+		for (Word value = 0; value < 2; value++) {
+			Word row = candidate | (value << bit);
+			Word decided = Bits::width_mask(bit == width ? padded : bit);
+			if ((Bits::next_row(*rule, up, rows[i - 1], row, padded) ^ rows[i - 1]) & decided) {
+				continue;
+			}
+			if (bit < width) {
+				extend(i, row, bit + 1);
+			} else if (i > 1 || row != 0) {
+				rows[i] = row;
+				if (collect != nullptr) {
+					collect->push_back(row);
+				} else {
+					descend(i);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Continue below rows[i], or check the bottom of the box once every row is decided.
+	 */
+	void descend(int i) {
+		if (i < height) {
+			extend(i + 1, 0, 1);
+			return;
+		}
+		const int padded = width + 2;
+		Word columns = 0;
+		for (int y = 1; y <= height; y++) {
+			columns |= rows[y];
+		}
+		if (Bits::next_row(*rule, rows[height - 1], rows[height], 0, padded) == rows[height]
+				&& Bits::next_row(*rule, rows[height], 0, 0, padded) == 0 && (columns & 2)) {
+			catalogue->record(Pattern::canonical(unpack(rows, 1, height, width, 1)), 1);
+		}
+	}
+};
+
+/**
+ * The depth first oscillator search from one first row.
+ * The box is placed in a board padded by the period on every side, so bit period of a row is the left column
+ * of the box and row period its top row. phases[t] holds the board after t steps, with a dead row past the
+ * last. Only phase 0 is chosen, the later phases follow from it a row behind for every step.
+ */
+struct OscillatorSearch {
+	const Rule *rule { };
+	int width { }, height { }, period { }, padded { }, rows { };
+	std::vector<std::vector<Word>> phases;
+	Catalogue *catalogue { };
+	std::vector<Word> *collect { };
+
+	/**
+	 * Step the rows of the later phases that row y0 of phase 0 completes, then check the cells of the
+	 * last phase that are decided match phase 0. Row y0 - t of phase t is complete once row y0 of phase 0 is.
+	 */
+	bool propagate(int y0, Word decided) {
+		for (int t = 1; t <= period; t++) {
+			const int y = y0 - t;
+			if (y < 0) {
+				return true;
+			}
+			if (y < rows) {
+				const std::vector<Word> &before = phases[t - 1];
+				phases[t][y] = Bits::next_row(*rule, y > 0 ? before[y - 1] : 0, before[y], before[y + 1], padded);
+			}
+		}
+		const int y = y0 - period;
+		return ((phases[period][y] ^ phases[0][y]) & decided) == 0;
+	}
+
+	/**
+	 * Decide the bits of row y0 of phase 0 from bit to the right edge of the box. A cell of the last phase
+	 * depends on the cells up to period columns either side of it, so cells up to bit - period are decided.
+	 */
+	void extend(int y0, Word candidate, int bit) {
+		const int last = period + width - 1;
+		for (Word value = 0; value < 2; value++) {
+			const Word row = candidate | (value << bit);
+			phases[0][y0] = row;
+			if (!propagate(y0, bit == last ? ~0ull : Bits::width_mask(std::max(0, bit - period + 1)))) {
+				continue;
+			}
+			if (bit < last) {
+				extend(y0, row, bit + 1);
+			} else if (y0 > period || row != 0) {
+				if (collect != nullptr) {
+					collect->push_back(row);
+				} else {
+					descend(y0);
+				}
+			}
+		}
+		phases[0][y0] = 0;
+	}
+
+	/**
+	 * Continue below row y0, or finish the later phases below the box once every row of it is decided.
+	 */
+	void descend(int y0) {
+		if (y0 + 1 < period + height) {
+			extend(y0 + 1, 0, period);
+			return;
+		}
+		for (int y = y0 + 1; y < rows + period; y++) {
+			if (!propagate(y, ~0ull)) {
+				return;
+			}
+		}
+		evaluate();
+	}
+
+	/**
+	 * Check a complete oscillator touches the left of the box and has exactly the period, then record it.
+	 */
+	void evaluate() {
+		Word columns = 0;
+		for (int y = period; y < period + height; y++) {
+			columns |= phases[0][y];
+		}
+		if (!((columns >> period) & 1)) {
+			return;
+		}
+		for (int t = 1; t < period; t++) {
+			if (phases[t] == phases[0]
+					|| std::all_of(phases[t].begin(), phases[t].end(), [](Word row) {return row == 0;})) {
+				return;
+			}
+		}
+		//Canonicalise across every phase.
+		Grid best = Pattern::canonical(GridView(unpack(phases[0], 0, rows, padded, 0)));
+		for (int t = 1; t < period; t++) {
+			Grid candidate = Pattern::canonical(GridView(unpack(phases[t], 0, rows, padded, 0)));
+			if (Pattern::less(candidate, best)) {
+				best = candidate;
+			}
+		}
+		catalogue->record(best, period);
+	}
+};
+}
+
+/**
+ * Search::still_lifes(width, height, pool, rule)
+ *
+ * Find every still life that fits in a bounding box.
+ *
+ * @example
+ *
+ *      // Find the still lifes of Conway's Game of Life up to 4x4, the block, beehive, loaf, boat, ...
+ *      ThreadPool pool;
+ *      for (const Search::Found &found : Search::still_lifes(4, 4, pool)) {
+ *          std::cout << found.pattern << std::endl;
+ *      }
+ *
+ * @param width
+ *      The width of the bounding box, at most 62.
+ *
+ * @param height
+ *      The height of the bounding box.
+ *
+ * @param pool
+ *      The pool to search on.
+ *
+ * @param rule
+ *      Optional parameter. The rule to search in. Defaults to B3/S23.
+ *
+ * @return
+ *      Returns the canonical form of every distinct still life, in canonical order.
+ *
+ * @throws
+ *      Throws std::runtime_error if the bounding box is empty or too wide.
+ */
+std::vector<Search::Found> Search::still_lifes(int width, int height, ThreadPool &pool, const Rule &rule) {
+	if (width < 1 || height < 1 || width > 62) {
+		throw std::runtime_error("The bounding box must be between 1 and 62 cells wide and at least 1 cell high.");
+	}
+	Catalogue catalogue;
+	StillLifeSearch prototype;
+	prototype.rule = &rule;
+	prototype.width = width;
+	prototype.height = height;
+	prototype.rows.assign(height + 2, 0);
+	prototype.catalogue = &catalogue;
+
+	//Collect the first rows that keep the row above the box dead, then search below each in parallel.
+	std::vector<Word> first_rows;
+	StillLifeSearch collector = prototype;
+	collector.collect = &first_rows;
+	collector.extend(1, 0, 1);
+
+	for (Word first : first_rows) {
+		pool.submit([&, first](int) {
+			StillLifeSearch search = prototype;
+			search.rows[1] = first;
+			search.descend(1);
+		});
+	}
+	pool.wait();
+	return catalogue.sorted();
+}
+
+/**
+ * Search::oscillators(width, height, period, pool, rule)
+ *
+ * Find every oscillator of exactly the given period whose bounding box, in the phase searched,
+ * fits in the given box. A period of 1 searches for still lifes.
+ * The work still grows exponentially with the width times the period, so boxes are limited to 36 cells,
+ * periods to 4, and the width times the period to 18, where a search takes up to tens of seconds on one core.
+ *
+ * @example
+ *
+ *      // Find the period 2 oscillators up to 4x4, the blinker, toad, beacon, ...
+ *      ThreadPool pool;
+ *      std::vector<Search::Found> found = Search::oscillators(4, 4, 2, pool);
+ *
+ * @param width
+ *      The width of the bounding box.
+ *
+ * @param height
+ *      The height of the bounding box.
+ *
+ * @param period
+ *      The period of the oscillators.
+ *
+ * @param pool
+ *      The pool to search on.
+ *
+ * @param rule
+ *      Optional parameter. The rule to search in. Defaults to B3/S23.
+ *
+ * @return
+ *      Returns the canonical form of every distinct oscillator, in canonical order.
+ *
+ * @throws
+ *      Throws std::runtime_error if the period is not positive, or the box is empty or beyond the limits above.
+ */
+std::vector<Search::Found> Search::oscillators(int width, int height, int period, ThreadPool &pool,
+		const Rule &rule) {
+	if (period < 1) {
+		throw std::runtime_error("The period must be positive.");
+	}
+	if (period == 1) {
+		return still_lifes(width, height, pool, rule);
+	}
+	if (width < 1 || height < 1 || width * height > 36 || period > 4 || width * period > 18) {
+		throw std::runtime_error("The bounding box or period is too big to search.");
+	}
+	Catalogue catalogue;
+	OscillatorSearch prototype;
+	prototype.rule = &rule;
+	prototype.width = width;
+	prototype.height = height;
+	prototype.period = period;
+	prototype.padded = width + 2 * period;
+	prototype.rows = height + 2 * period;
+	prototype.phases.assign(period + 1, std::vector<Word>(prototype.rows + 1, 0));
+	prototype.catalogue = &catalogue;
+	//The rows above the box are dead in phase 0.
+	for (int y = 0; y < period; y++) {
+		if (!prototype.propagate(y, ~0ull)) {
+			return catalogue.sorted();
+		}
+	}
+
+	//Collect the first rows consistent with the rows above the box, then search below each in parallel.
+	std::vector<Word> first_rows;
+	OscillatorSearch collector = prototype;
+	collector.collect = &first_rows;
+	collector.extend(period, 0, period);
+
+	for (Word first : first_rows) {
+		pool.submit([&, first](int) {
+			OscillatorSearch search = prototype;
+			search.phases[0][period] = first;
+			search.propagate(period, ~0ull);
+			search.descend(period);
+		});
+	}
+	pool.wait();
+	return catalogue.sorted();
+}
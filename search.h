@@ -0,0 +1,33 @@
+/**
+ * Declares a Search namespace with methods for enumerating still lifes and oscillators that fit in a bounding box.
+ * Rich documentation for the api and behaviour the Search namespace can be found in search.cpp.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the namespace.
+// #include ...
+#include <vector>
+#include "grid.h"
+#include "rule.h"
+#include "pool.h"
+
+/**
+ * Declare the interface of the Search namespace for still life and oscillator searches.
+ */
+namespace Search {
+
+/**
+ * A Found pattern is the canonical form of a still life or oscillator, with its period (1 for still lifes).
+ */
+struct Found {
+	Grid pattern;
+	int period { };
+};
+
+std::vector<Found> still_lifes(int width, int height, ThreadPool &pool, const Rule &rule = Rule());
+std::vector<Found> oscillators(int width, int height, int period, ThreadPool &pool, const Rule &rule = Rule());
+}
+;
@@ -0,0 +1,280 @@
+/**
+ * Implements a SnapshotWriter class for writing large grids to disc in the binary format, bypassing the page cache.
+ *      - Snapshots are byte for byte the files Zoo::save_binary writes, so Zoo::load_binary reads them back.
+ *
+ *      - Files are opened with O_DIRECT, so gigabytes of snapshot do not push the pages of the run out of the
+ *        page cache, and the kernel does not have to write them back later.
+ *          - Direct writes must be aligned in memory, in the file, and in length, so the buffers are aligned
+ *            to 4KB and are whole multiples of it. The last chunk is padded and the file truncated after.
+ *          - Filesystems that refuse O_DIRECT, such as tmpfs, are written through the page cache instead,
+ *            and the pages are dropped from the cache once the file is on disc.
+ *
+ *      - Writing is double buffered.
+ *          - Cells are packed 8 at a time into one buffer while a thread of the writer's own writes the other
+ *            with pwrite, so packing the next chunk overlaps with writing the last.
+ *          - The writer thread lives as long as the writer, so a run writing a snapshot every few steps
+ *            does not start a thread for each.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#include "snapshot.h"
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+const std::size_t SnapshotWriter::ALIGNMENT;
+
+namespace {
+
+/**
+ * pack8(cells)
+ *
+ * Private helper to pack 8 cells into a byte, the first cell in the lowest bit.
+ * The lowest bit of each cell is moved to bit 56 + i of the product, with no carries between them.
+ */
+unsigned pack8(const Cell *cells) {
+	static_assert(Cell::ALIVE % 2 == 1 && Cell::DEAD % 2 == 0, "Alive cells are packed by their lowest bit.");
+	std::uint64_t word;
+	std::memcpy(&word, cells, 8);
+	return ((word & 0x0101010101010101ull) * 0x0102040810204080ull) >> 56;
+}
+
+}
+
+/**
+ * SnapshotWriter::SnapshotWriter(chunk_bytes)
+ *
+ * Construct a writer with two aligned buffers and start its writing thread.
+ *
+ * @example
+ *
+ *      // Write a snapshot of a world every 100 steps
+ *      SnapshotWriter writer;
+ *      for (int step = 0; step < 1000; step++) {
+ *          world.step();
+ *          if (step % 100 == 0) {
+ *              writer.write("snapshot." + std::to_string(step) + ".bgol", world.get_view());
+ *          }
+ *      }
+ *
+ * @param chunk_bytes
+ *      Optional parameter. The size of each buffer, rounded up to a multiple of ALIGNMENT. Defaults to 4MB.
+ *
+ * @throws
+ *      Throws std::runtime_error if the buffers cannot be allocated.
+ */
+SnapshotWriter::SnapshotWriter(std::size_t chunk_bytes) :
+		chunk(std::max<std::size_t>(ALIGNMENT, (chunk_bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT)) {
+	for (Buffer &buffer : buffers) {
+		void *memory = nullptr;
+		if (posix_memalign(&memory, ALIGNMENT, chunk) != 0) {
+			std::free(buffers[0].data);
+			throw std::runtime_error("Unable to allocate the snapshot buffers.");
+		}
+		buffer.data = static_cast<char*>(memory);
+	}
+	thread = std::thread(&SnapshotWriter::serve, this);
+}
+
+/**
+ * SnapshotWriter::~SnapshotWriter()
+ *
+ * Stop the writing thread and free the buffers.
+ */
+SnapshotWriter::~SnapshotWriter() {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+	changed.notify_all();
+	thread.join();
+	for (Buffer &buffer : buffers) {
+		std::free(buffer.data);
+	}
+}
+
+/**
+ * SnapshotWriter::serve()
+ *
+ * Private method run by the writing thread, writing each buffer as it is queued, lowest offset first.
+ */
+void SnapshotWriter::serve() {
+	std::unique_lock<std::mutex> guard(lock);
+	while (true) {
+		changed.wait(guard, [this]() {
+			return stopping || buffers[0].queued || buffers[1].queued;
+		});
+		Buffer *buffer = nullptr;
+		for (Buffer &candidate : buffers) {
+			if (candidate.queued && (buffer == nullptr || candidate.offset < buffer->offset)) {
+				buffer = &candidate;
+			}
+		}
+		if (buffer == nullptr) {
+			return;
+		}
+		const Buffer job = *buffer;
+		guard.unlock();
+		std::string failure;
+		for (std::size_t done = 0; done < job.length;) {
+			const ssize_t written = pwrite(file, job.data + done, job.length - done, job.offset + done);
+			if (written < 0 && errno == EINTR) {
+				continue;
+			}
+			//Some filesystems accept O_DIRECT when opening but not when writing, so write through the cache.
+			if (written < 0 && errno == EINVAL && direct) {
+				fcntl(file, F_SETFL, fcntl(file, F_GETFL) & ~O_DIRECT);
+				direct = false;
+				continue;
+			}
+			if (written <= 0) {
+				failure = std::string("Unable to write the snapshot, ") + std::strerror(errno) + ".";
+				break;
+			}
+			done += written;
+		}
+		guard.lock();
+		if (!failure.empty() && error.empty()) {
+			error = failure;
+		}
+		buffer->queued = false;
+		changed.notify_all();
+	}
+}
+
+/**
+ * SnapshotWriter::submit(buffer)
+ *
+ * Private method to queue a packed buffer for the writing thread.
+ */
+void SnapshotWriter::submit(Buffer &buffer) {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		buffer.queued = true;
+	}
+	changed.notify_all();
+}
+
+/**
+ * SnapshotWriter::wait(buffer)
+ *
+ * Private method to wait until a buffer has been written and can be packed again.
+ */
+void SnapshotWriter::wait(Buffer &buffer) {
+	std::unique_lock<std::mutex> guard(lock);
+	changed.wait(guard, [&buffer]() {
+		return !buffer.queued;
+	});
+}
+
+/**
+ * SnapshotWriter::write(path, grid)
+ *
+ * Write a grid to a file in the binary format, returning once the whole file has been written.
+ *
+ * @param path
+ *      The std::string path to the file to write to.
+ *
+ * @param grid
+ *      The grid, or a view onto a region of a grid, to write.
+ *
+ * @throws
+ *      Throws std::runtime_error if the file cannot be opened or written.
+ */
+void SnapshotWriter::write(const std::string &path, GridView grid) {
+	file = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+	direct = file >= 0;
+	if (file < 0 && errno == EINVAL) {
+		file = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	}
+	if (file < 0) {
+		throw std::runtime_error("Unable to open the specified file.");
+	}
+	error.clear();
+	const int width = grid.get_width(), height = grid.get_height();
+	//The binary format always ends with one more byte than the cells fill, as Zoo::save_binary writes it.
+	const std::uint64_t total = 2 * sizeof(int) + (std::uint64_t) width * height / 8 + 1;
+	int current = 0;
+	Buffer *buffer = &buffers[current];
+	buffer->length = 0;
+	buffer->offset = 0;
+	auto put = [&](unsigned byte) {
+		buffer->data[buffer->length++] = (char) byte;
+		if (buffer->length == chunk) {
+			const std::uint64_t next = buffer->offset + chunk;
+			submit(*buffer);
+			current ^= 1;
+			buffer = &buffers[current];
+			wait(*buffer);
+			buffer->length = 0;
+			buffer->offset = next;
+		}
+	};
+	for (int value : { width, height }) {
+		for (std::size_t byte = 0; byte < sizeof(int); byte++) {
+			put(reinterpret_cast<const unsigned char*>(&value)[byte]);
+		}
+	}
+	//Cells run on from one row to the next with no padding, so a byte may hold cells of two rows.
+	unsigned bits = 0;
+	int count = 0;
+	for (int y = 0; y < height; y++) {
+		const Cell *row = grid.row(y);
+		int x = 0;
+		for (; x + 8 <= width; x += 8) {
+			bits |= pack8(row + x) << count;
+			put(bits & 0xFF);
+			bits >>= 8;
+		}
+		for (; x < width; x++) {
+			bits |= (row[x] & 1u) << count;
+			if (++count == 8) {
+				put(bits);
+				bits = 0;
+				count = 0;
+			}
+		}
+	}
+	if (count > 0) {
+		put(bits);
+	}
+	while (buffer->offset + buffer->length < total) {
+		put(0);
+	}
+	if (buffer->length > 0) {
+		//Direct writes must be whole blocks, the padding is truncated away afterwards.
+		const std::size_t padded = (buffer->length + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+		std::memset(buffer->data + buffer->length, 0, padded - buffer->length);
+		buffer->length = padded;
+		submit(*buffer);
+	}
+	wait(buffers[0]);
+	wait(buffers[1]);
+	bool failed = !error.empty() || ftruncate(file, total) != 0;
+	if (!failed && !direct) {
+		failed = fdatasync(file) != 0;
+		posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED);
+	}
+	failed = close(file) != 0 || failed;
+	file = -1;
+	if (failed) {
+		throw std::runtime_error(error.empty() ? "Unable to write the snapshot." : error);
+	}
+}
+
+/**
+ * SnapshotWriter::is_direct()
+ *
+ * Checks if the last snapshot was written with O_DIRECT, or fell back to writing through the page cache.
+ */
+bool SnapshotWriter::is_direct() const {
+	return direct;
+}
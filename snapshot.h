@@ -0,0 +1,59 @@
+/**
+ * Declares a SnapshotWriter class for writing large grids to disc in the binary format, bypassing the page cache.
+ * Rich documentation for the api and behaviour the SnapshotWriter class can be found in snapshot.cpp.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the class.
+// #include ...
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "grid.h"
+
+/**
+ * Declare the structure of the SnapshotWriter class for writing snapshots with O_DIRECT and double buffering.
+ *
+ * Cells are packed into one aligned buffer while a thread of the writer's own writes the other.
+ */
+class SnapshotWriter {
+public:
+	//The alignment of the buffers, file offsets, and lengths of direct writes.
+	static const std::size_t ALIGNMENT = 4096;
+private:
+	/**
+	 * A Buffer is an aligned chunk of the file, written at offset once length bytes are packed into it.
+	 */
+	struct Buffer {
+		char *data { };
+		std::size_t length { };
+		std::uint64_t offset { };
+		bool queued { };
+	};
+
+	std::size_t chunk;
+	Buffer buffers[2];
+	int file { -1 };
+	bool direct { };
+	std::string error;
+	bool stopping { };
+	std::mutex lock;
+	std::condition_variable changed;
+	std::thread thread;
+
+	void serve();
+	void submit(Buffer &buffer);
+	void wait(Buffer &buffer);
+public:
+	explicit SnapshotWriter(std::size_t chunk_bytes = 1 << 22);
+	~SnapshotWriter();
+	SnapshotWriter(const SnapshotWriter&) = delete;
+	SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+	void write(const std::string &path, GridView grid);
+	bool is_direct() const;
+};
@@ -0,0 +1,208 @@
+/**
+ * Implements a Sweep namespace with methods for running one seed under many rules and classifying the outcomes.
+ *      - The seed is shared read-only between workers as a GridView, it is never copied per rule
+ *        except into the world that simulates it.
+ *      - Each worker of a ThreadPool keeps one World and recycles it for every rule it runs.
+ *
+ *      - A simulation stops as soon as its outcome is known:
+ *          - DIES when no cells are alive.
+ *          - STABILISES when a state repeats the state one step before it.
+ *          - OSCILLATES when a state repeats an earlier state, the gap between them is the period.
+ *          - EXPLODES when the fraction of alive cells passes the explode density.
+ *          - UNDECIDED when none of the above happened within the maximum number of steps.
+ *      - Repeated states are detected by their GridView::hash, so no history of grids is kept.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#include "sweep.h"
+
+// Include the minimal number of headers needed to support your implementation.
+// #include ...
+#include <fstream>
+#include <unordered_map>
+
+/**
+ * Sweep::outcome_name(outcome)
+ *
+ * Gets the lower case name of an outcome, as printed in the result table.
+ */
+std::string Sweep::outcome_name(Outcome outcome) {
+	switch (outcome) {
+	case DIES:
+		return "dies";
+	case STABILISES:
+		return "stabilises";
+	case OSCILLATES:
+		return "oscillates";
+	case EXPLODES:
+		return "explodes";
+	default:
+		return "undecided";
+	}
+}
+
+/**
+ * Sweep::classify(world, max_steps, toroidal, explode_density)
+ *
+ * Step a world until its outcome is known or the maximum number of steps is reached.
+ * The world is left in the state the outcome was decided at.
+ *
+ * @example
+ *
+ *      // A glider on a torus returns to its start state after 4 * size steps
+ *      World world(Zoo::glider());
+ *      Sweep::Result result = Sweep::classify(world, 1000, true);
+ *
+ * @param world
+ *      The world to step, already holding the seed and rule.
+ *
+ * @param max_steps
+ *      The number of steps after which the outcome is UNDECIDED.
+ *
+ * @param toroidal
+ *      Optional parameter. If true then simulate on a torus. Defaults to false.
+ *
+ * @param explode_density
+ *      Optional parameter. The fraction of alive cells above which the outcome is EXPLODES. Defaults to 0.5.
+ *
+ * @return
+ *      Returns the result, with the rule of the world.
+ */
+Sweep::Result Sweep::classify(World &world, int max_steps, bool toroidal, double explode_density) {
+	std::unordered_map<unsigned long long, int> seen;
+	Result result;
+	result.rule = world.get_rule();
+	for (int generation = 0; generation <= max_steps; generation++) {
+		if (generation > 0) {
+			world.step(toroidal);
+		}
+		const int alive = world.get_alive_cells();
+		result.generation = generation;
+		result.alive = alive;
+		if (alive == 0) {
+			result.outcome = DIES;
+			return result;
+		}
+		if (alive > explode_density * world.get_total_cells()) {
+			result.outcome = EXPLODES;
+			return result;
+		}
+		auto inserted = seen.insert(std::make_pair(world.get_view().hash(), generation));
+		if (!inserted.second) {
+			result.period = generation - inserted.first->second;
+			result.outcome = result.period == 1 ? STABILISES : OSCILLATES;
+			return result;
+		}
+	}
+	result.outcome = UNDECIDED;
+	return result;
+}
+
+/**
+ * Sweep::load_rules(path)
+ *
+ * Load a file of rules in B/S notation, one per line.
+ * Blank lines and lines starting with # are ignored.
+ *
+ * @param path
+ *      The std::string path to the file to read in.
+ *
+ * @return
+ *      Returns the rules in the order they appear in the file.
+ *
+ * @throws
+ *      Throws std::runtime_error if the file cannot be opened or a rule cannot be parsed.
+ */
+std::vector<Rule> Sweep::load_rules(std::string path) {
+	std::ifstream inFile(path);
+	if (!inFile) {
+		throw std::runtime_error("Unable to open the specified file.");
+	}
+	std::vector<Rule> rules;
+	std::string line;
+	while (inFile >> line) {
+		if (line[0] == '#') {
+			std::getline(inFile, line);
+			continue;
+		}
+		rules.push_back(Rule::parse(line));
+	}
+	return rules;
+}
+
+/**
+ * Sweep::run(seed, rules, pool, max_steps, toroidal, explode_density)
+ *
+ * Classify the outcome of a seed under every rule, in parallel on the workers of a pool.
+ *
+ * @example
+ *
+ *      // Try the r-pentomino on a 64x64 torus under every rule in a file
+ *      Grid seed(64);
+ *      seed.merge(Zoo::r_pentomino(), 30, 30);
+ *
+ *      ThreadPool pool;
+ *      std::vector<Sweep::Result> results = Sweep::run(seed, Sweep::load_rules("rules.txt"), pool, 1000, true);
+ *
+ * @param seed
+ *      The initial state shared by every run. It must not change until the sweep returns.
+ *
+ * @param rules
+ *      The rules to try.
+ *
+ * @param pool
+ *      The pool to run the simulations on.
+ *
+ * @param max_steps
+ *      The number of steps after which an outcome is UNDECIDED.
+ *
+ * @param toroidal
+ *      Optional parameter. If true then simulate on a torus. Defaults to false.
+ *
+ * @param explode_density
+ *      Optional parameter. The fraction of alive cells above which the outcome is EXPLODES. Defaults to 0.5.
+ *
+ * @return
+ *      Returns one result per rule, in the same order as the rules.
+ */
+std::vector<Sweep::Result> Sweep::run(GridView seed, const std::vector<Rule> &rules, ThreadPool &pool, int max_steps,
+		bool toroidal, double explode_density) {
+	std::vector<Result> results(rules.size());
+	std::vector<World> worlds(pool.get_size());
+	for (std::size_t i = 0; i < rules.size(); i++) {
+		pool.submit([&, i](int worker) {
+			World &world = worlds[worker];
+			world.set_state(seed);
+			world.set_rule(rules[i]);
+			results[i] = classify(world, max_steps, toroidal, explode_density);
+		});
+	}
+	pool.wait();
+	return results;
+}
+
+/**
+ * Sweep::write_table(stream, results)
+ *
+ * Write a compact tab separated table with one line per rule.
+ *
+ * @example
+ *
+ *      // Prints lines like: B36/S23	oscillates	48	2	12
+ *      Sweep::write_table(std::cout, results);
+ *
+ * @param stream
+ *      An ascii mode output stream such as std::cout.
+ *
+ * @param results
+ *      The results returned by Sweep::run.
+ */
+void Sweep::write_table(std::ostream &stream, const std::vector<Result> &results) {
+	stream << "rule\toutcome\tgeneration\tperiod\talive\n";
+	for (const Result &result : results) {
+		stream << result.rule.to_string() << '\t' << outcome_name(result.outcome) << '\t' << result.generation << '\t'
+				<< result.period << '\t' << result.alive << '\n';
+	}
+	stream.flush();
+}
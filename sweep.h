@@ -0,0 +1,48 @@
+/**
+ * Declares a Sweep namespace with methods for running one seed under many rules and classifying the outcomes.
+ * Rich documentation for the api and behaviour the Sweep namespace can be found in sweep.cpp.
+ *
+ * @author 964379
+ * @date March, 2020
+ */
+#pragma once
+
+// Add the minimal number of includes you need in order to declare the namespace.
+// #include ...
+#include <iostream>
+#include <string>
+#include <vector>
+#include "world.h"
+#include "pool.h"
+
+/**
+ * Declare the interface of the Sweep namespace for rule space exploration.
+ */
+namespace Sweep {
+
+/**
+ * An Outcome is the long term behaviour observed when simulating a seed.
+ */
+enum Outcome {
+	DIES, STABILISES, OSCILLATES, EXPLODES, UNDECIDED
+};
+
+/**
+ * A Result records the outcome of simulating the seed under one rule.
+ *      - generation is the step the outcome was decided at.
+ *      - period is the oscillation period, 1 for still lifes and 0 otherwise.
+ */
+struct Result {
+	Rule rule;
+	Outcome outcome { UNDECIDED };
+	int generation { }, period { }, alive { };
+};
+
+std::string outcome_name(Outcome outcome);
+Result classify(World &world, int max_steps, bool toroidal = false, double explode_density = 0.5);
+std::vector<Rule> load_rules(std::string path);
+std::vector<Result> run(GridView seed, const std::vector<Rule> &rules, ThreadPool &pool, int max_steps,
+		bool toroidal = false, double explode_density = 0.5);
+void write_table(std::ostream &stream, const std::vector<Result> &results);
+}
+;
@@ -46,4 +46,25 @@ SCENARIO( "an ascii file can be read in from disc and parsed into a grid", "[zoo
 
     } // GIVEN
 
-} // SCENARIO
\ No newline at end of file
+} // SCENARIO
+
+SCENARIO( "a gzip compressed ascii file is inflated as it is parsed", "[zoo][load_ascii][gzip]" ) {
+
+    GIVEN( "ascii files compressed by gzip, and the same files uncompressed" ) {
+
+        WHEN( "they are loaded" ) {
+
+            Grid glider = Zoo::load_ascii("../test_inputs/GLIDER.gol.gz");
+            Grid random = Zoo::load_ascii("../test_inputs/RANDOM.gol.gz");
+
+            THEN( "they hold the same cells as the uncompressed files" ) {
+
+                REQUIRE(GridView(glider).hash() == GridView(Zoo::load_ascii("../test_inputs/GLIDER.gol")).hash());
+                REQUIRE(random.get_width() == 64);
+                REQUIRE(random.get_height() == 48);
+                REQUIRE(GridView(random).hash() == GridView(Zoo::load_ascii("../test_inputs/RANDOM.gol")).hash());
+            }
+        }
+    }
+
+} // SCENARIO
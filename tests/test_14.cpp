@@ -61,4 +61,34 @@ SCENARIO( "a grid can be saved to disc as an ascii file", "[zoo][save_ascii]" )
 
     } // GIVEN
 
-} // SCENARIO
\ No newline at end of file
+} // SCENARIO
+
+SCENARIO( "a grid saved to a .gz path is gzip compressed", "[zoo][save_ascii][gzip]" ) {
+
+    GIVEN( "a 200x150 grid of long runs of alive and dead cells" ) {
+
+        Grid g(200, 150);
+        for (int y = 0; y < 150; y++) {
+            for (int x = (y * 7) % 50; x < 200; x += 50) {
+                g.set(x, y, Cell::ALIVE);
+            }
+        }
+
+        WHEN( "the grid is saved to a .gol.gz file" ) {
+
+            Zoo::save_ascii("../test_outputs/SAVE_ASCII_RUNS.gol.gz", g);
+
+            THEN( "the file is gzip compressed, far smaller than the cells, and loads back the same" ) {
+
+                std::ifstream file("../test_outputs/SAVE_ASCII_RUNS.gol.gz", std::ifstream::binary);
+                const std::string file_contents((std::istreambuf_iterator<char>(file)),
+                                            std::istreambuf_iterator<char>());
+
+                REQUIRE( file_contents.compare(0, 3, "\x1f\x8b\x08") == 0 );
+                REQUIRE( file_contents.size() < 200 * 150 / 10 );
+                REQUIRE( GridView(Zoo::load_ascii("../test_outputs/SAVE_ASCII_RUNS.gol.gz")).hash() == GridView(g).hash() );
+            }
+        }
+    }
+
+} // SCENARIO
@@ -48,6 +48,12 @@ SCENARIO( "loading an ascii file throws exceptions on error", "[zoo][load_ascii]
         REQUIRE_THROWS( Zoo::load_ascii("../test_inputs/MALFORMED_CELL.gol") );
     }
 
+    WHEN( "a gzip compressed file with corrupt data is loaded as an ascii file throw an exception" ) {
+
+        REQUIRE(            file_exists("../test_inputs/MALFORMED_DATA.gol.gz") );
+        REQUIRE_THROWS( Zoo::load_ascii("../test_inputs/MALFORMED_DATA.gol.gz") );
+    }
+
 } // SCENARIO
 
 
@@ -0,0 +1,454 @@
+/**
+ * @author 964379
+ * @date March, 2020
+ */
+
+// Uses Catch2 from https://github.com/catchorg/Catch2 under the BOOST license
+#include "../catch2/catch.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <sys/stat.h>
+
+#include "../grid.h"
+#include "../world.h"
+#include "../rule.h"
+#include "../jit.h"
+#include "../zoo.h"
+
+SCENARIO( "rules can be parsed from B/S notation", "[rule][parse]" ) {
+
+    GIVEN( "the rule strings for Conway's Game of Life" ) {
+
+        THEN( "all notations parse to the default rule" ) {
+
+            REQUIRE(Rule::parse("B3/S23") == Rule());
+            REQUIRE(Rule::parse("b3/s23") == Rule());
+            REQUIRE(Rule::parse("S23/B3") == Rule());
+            REQUIRE(Rule::parse("23/3")   == Rule());
+        }
+
+        THEN( "the default rule prints in B/S notation" ) {
+
+            REQUIRE(Rule().to_string() == "B3/S23");
+        }
+    }
+
+    GIVEN( "malformed rule strings" ) {
+
+        THEN( "parsing throws an exception" ) {
+
+            REQUIRE_THROWS(Rule::parse("B3S23"));
+            REQUIRE_THROWS(Rule::parse("B39/S23"));
+            REQUIRE_THROWS(Rule::parse("B3/X23"));
+        }
+    }
+
+} // SCENARIO
+
+SCENARIO( "a world can be stepped with a rule other than B3/S23", "[world][rule]" ) {
+
+    GIVEN( "a world with size 5x5 containing a single alive cell" ) {
+
+        Grid g(5);
+
+        g.set(2, 2, Cell::ALIVE);
+
+        World w(g);
+
+        WHEN( "the world is stepped with B1/S" ) {
+
+            w.set_rule(Rule::parse("B1/S"));
+            w.step();
+
+            THEN( "the cell dies and its 8 neighbours are born" ) {
+
+                REQUIRE(w.get_alive_cells() == 8);
+                REQUIRE(w.get_state().get(2, 2) == Cell::DEAD);
+                REQUIRE(w.get_state().get(1, 1) == Cell::ALIVE);
+                REQUIRE(w.get_state().get(3, 3) == Cell::ALIVE);
+            }
+        }
+    }
+
+} // SCENARIO
+
+SCENARIO( "a specialised kernel steps a world exactly like the generic step", "[world][rule][jit]" ) {
+
+    GIVEN( "worlds filled with random cells, narrower than a word and several words wide" ) {
+
+        std::srand(42);
+        for (int width : { 23, 150 }) {
+
+            Grid g(width, 17);
+            for (int y = 0; y < g.get_height(); y++) {
+                for (int x = 0; x < g.get_width(); x++) {
+                    g.set(x, y, (std::rand() % 3 == 0) ? Cell::ALIVE : Cell::DEAD);
+                }
+            }
+
+            const char *rules[] = { "B3/S23", "B36/S23", "B3678/S34678", "B2/S" };
+
+            for (const char *notation : rules) {
+                for (bool toroidal : { false, true }) {
+
+                    World generic(g), specialised(g);
+
+                    generic.set_rule(Rule::parse(notation));
+                    specialised.set_rule(Rule::parse(notation), true);
+
+                    // The kernel can only be checked where a compiler is available
+                    if (!specialised.is_specialised()) {
+                        continue;
+                    }
+
+                    generic.advance(8, toroidal);
+                    specialised.advance(8, toroidal);
+
+                    for (int y = 0; y < g.get_height(); y++) {
+                        for (int x = 0; x < g.get_width(); x++) {
+                            REQUIRE(generic.get_state().get(x, y) == specialised.get_state().get(x, y));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+} // SCENARIO
+
+SCENARIO( "kernels are only cached where no other user can plant one", "[rule][jit]" ) {
+
+    GIVEN( "a kernel cache directory others can write to" ) {
+
+        const std::string directory = "../test_outputs/JIT_CACHE";
+        const char *previous = std::getenv("GOL_KERNEL_CACHE");
+        const std::string restore = previous ? previous : "";
+        mkdir(directory.c_str(), 0700);
+        chmod(directory.c_str(), 0777);
+        setenv("GOL_KERNEL_CACHE", directory.c_str(), 1);
+
+        THEN( "it is refused, until it is private again" ) {
+            REQUIRE(Jit::cache_directory() != directory);
+            chmod(directory.c_str(), 0700);
+            REQUIRE(Jit::cache_directory() == directory);
+        }
+
+        if (previous) {
+            setenv("GOL_KERNEL_CACHE", restore.c_str(), 1);
+        } else {
+            unsetenv("GOL_KERNEL_CACHE");
+        }
+    }
+
+    GIVEN( "a kernel cache directory with a quote in its name" ) {
+
+        // Whether a compiler is available, from a kernel cached where the tests normally cache them
+        const bool compiler = Jit::load_kernel(Rule()) != nullptr;
+        const std::string directory = "../test_outputs/JIT_O'CACHE";
+        const char *previous = std::getenv("GOL_KERNEL_CACHE");
+        const std::string restore = previous ? previous : "";
+        setenv("GOL_KERNEL_CACHE", directory.c_str(), 1);
+
+        THEN( "kernels are compiled and cached in it all the same" ) {
+            REQUIRE(Jit::cache_directory() == directory);
+            REQUIRE((Jit::load_kernel(Rule::parse("B1357/S1357")) != nullptr) == compiler);
+        }
+
+        if (previous) {
+            setenv("GOL_KERNEL_CACHE", restore.c_str(), 1);
+        } else {
+            unsetenv("GOL_KERNEL_CACHE");
+        }
+    }
+
+} // SCENARIO
+
+SCENARIO( "tiles of a world can follow rules of their own", "[rule][world]" ) {
+
+    GIVEN( "a random 150x50 grid" ) {
+
+        Grid g(150, 50);
+        std::srand(3);
+        for (int y = 0; y < g.get_height(); y++) {
+            for (int x = 0; x < g.get_width(); x++) {
+                g.set(x, y, (std::rand() % 3 == 0) ? Cell::ALIVE : Cell::DEAD);
+            }
+        }
+
+        const std::vector<Rule> rules = { Rule(), Rule::parse("B36/S23"), Rule::parse("B2/S") };
+
+        WHEN( "every tile of the map follows the same rule" ) {
+
+            World mapped(g), plain(g);
+            mapped.set_rule_map(rules, std::vector<int>(3 * 2, 1), 3, 50);
+            plain.set_rule(rules[1]);
+            mapped.advance(10);
+            plain.advance(10);
+
+            THEN( "it steps like a world of that rule" ) {
+
+                REQUIRE(mapped.has_rule_map());
+                REQUIRE(mapped.get_view().hash() == plain.get_view().hash());
+            }
+        }
+
+        for (bool toroidal : { false, true }) {
+
+            WHEN( std::string("a 5x3 map of 24x24 tiles covers part of the world") + (toroidal ? " on a torus" : "") ) {
+
+                World w(g);
+                w.set_rule(Rule::parse("B3/S012345678"));
+                const std::vector<int> map = { 0, 1, 2, 1, 0,
+                                               2, 2, 0, 1, 1,
+                                               1, 0, 0, 2, 0 };
+                w.set_rule_map(rules, map, 5, 24);
+                w.step(toroidal);
+
+                THEN( "every cell follows the rule of its tile, with neighbours from every tile" ) {
+
+                    REQUIRE(w.get_rule(30, 30).to_string() == "B2/S");
+                    REQUIRE(w.get_rule(149, 0).to_string() == "B3/S012345678");
+                    for (int y = 0; y < g.get_height(); y++) {
+                        for (int x = 0; x < g.get_width(); x++) {
+                            const int width = g.get_width(), height = g.get_height();
+                            int neighbours = 0;
+                            for (int dy = -1; dy <= 1; dy++) {
+                                for (int dx = -1; dx <= 1; dx++) {
+                                    int nx = x + dx, ny = y + dy;
+                                    if ((dx == 0 && dy == 0) || (!toroidal && (nx < 0 || nx >= width || ny < 0 || ny >= height))) {
+                                        continue;
+                                    }
+                                    neighbours += g.get((nx + width) % width, (ny + height) % height) == Cell::ALIVE;
+                                }
+                            }
+                            const Rule &rule = w.get_rule(x, y);
+                            const bool next = g.get(x, y) == Cell::ALIVE ? rule.survives(neighbours) : rule.is_born(neighbours);
+
+                            REQUIRE((w.get_state().get(x, y) == Cell::ALIVE) == next);
+                        }
+                    }
+                }
+            }
+        }
+
+        WHEN( "the rule is set again" ) {
+
+            World w(g);
+            w.set_rule_map(rules, { 2 }, 1, 8);
+            w.set_rule(Rule());
+
+            THEN( "the map is cleared" ) {
+
+                REQUIRE_FALSE(w.has_rule_map());
+                REQUIRE(w.get_rule(0, 0) == Rule());
+            }
+        }
+
+        WHEN( "a map is malformed" ) {
+
+            World w(g);
+
+            THEN( "it is rejected" ) {
+
+                REQUIRE_THROWS(w.set_rule_map(rules, { 0, 1, 2 }, 2, 8));
+                REQUIRE_THROWS(w.set_rule_map(rules, { 0, 3 }, 2, 8));
+                REQUIRE_THROWS(w.set_rule_map(rules, { 0, 1 }, 2, 0));
+            }
+        }
+    }
+
+} // SCENARIO
+
+SCENARIO( "cells of a world can be forced dead or alive", "[world][mask]" ) {
+
+    GIVEN( "a glider heading for a wall in a 20x20 world" ) {
+
+        Grid g(20, 20);
+        g.merge(Zoo::glider(), 2, 2);
+        Grid wall(20, 20);
+        for (int y = 0; y < 20; y++) {
+            wall(12, y) = Cell::ALIVE;
+        }
+
+        WHEN( "the wall is forced dead and it is advanced 80 steps" ) {
+
+            World w(g);
+            w.set_force_dead(wall);
+            w.advance(80);
+
+            THEN( "nothing ever lives in the wall or gets past it" ) {
+
+                REQUIRE(w.get_state().crop(12, 0, 20, 20).get_alive_cells() == 0);
+                REQUIRE_FALSE(w.is_specialised());
+            }
+        }
+
+        WHEN( "the wall is forced alive" ) {
+
+            World w(g);
+            w.set_force_alive(wall);
+
+            THEN( "the wall is alive straight away and after every step" ) {
+
+                REQUIRE(w.get_state().crop(12, 0, 13, 20).get_alive_cells() == 20);
+                for (int step = 0; step < 30; step++) {
+                    w.step();
+                    REQUIRE(w.get_state().crop(12, 0, 13, 20).get_alive_cells() == 20);
+                }
+            }
+        }
+
+        WHEN( "the same cells are forced dead and alive" ) {
+
+            World w(g);
+            w.set_force_alive(wall);
+            w.set_force_dead(wall);
+            w.step();
+
+            THEN( "forcing alive wins" ) {
+
+                REQUIRE(w.get_state().crop(12, 0, 13, 20).get_alive_cells() == 20);
+            }
+        }
+
+        WHEN( "the masks are matched against patching the grid after every step" ) {
+
+            Grid source(20, 20);
+            source(17, 17) = source(18, 17) = source(17, 18) = Cell::ALIVE;
+            World masked(g), patched(g);
+            masked.set_force_dead(wall);
+            masked.set_force_alive(source);
+            Grid state = patched.get_state();
+            for (int step = 0; step < 50; step++) {
+                masked.step(true);
+                patched.step(true);
+                state = patched.get_state();
+                for (int y = 0; y < 20; y++) {
+                    for (int x = 0; x < 20; x++) {
+                        if (wall(x, y) == Cell::ALIVE) {
+                            state(x, y) = Cell::DEAD;
+                        }
+                    }
+                }
+                state.merge(source, 0, 0, true);
+                patched.set_state(state);
+            }
+
+            THEN( "they agree" ) {
+
+                REQUIRE(masked.get_view().hash() == patched.get_view().hash());
+            }
+        }
+
+        WHEN( "a new state the same size is set on a masked world" ) {
+
+            World w(g);
+            Grid source(20, 20);
+            source(17, 17) = source(12, 5) = Cell::ALIVE;
+            w.set_force_dead(wall);
+            w.set_force_alive(source);
+            w.set_state(wall);
+
+            THEN( "the masks are kept and force the new cells straight away" ) {
+
+                REQUIRE(w.get_state().crop(12, 0, 13, 20).get_alive_cells() == 1);
+                REQUIRE(w.get_state()(12, 5) == Cell::ALIVE);
+                REQUIRE(w.get_state()(17, 17) == Cell::ALIVE);
+                REQUIRE(w.get_alive_cells() == 2);
+            }
+        }
+
+        WHEN( "the world is resized" ) {
+
+            World w(g);
+            w.set_force_alive(wall);
+            w.resize(30, 30);
+            w.step();
+
+            THEN( "the masks are dropped" ) {
+
+                REQUIRE(w.get_state().crop(12, 0, 13, 20).get_alive_cells() < 20);
+            }
+        }
+
+        WHEN( "a mask is the wrong size" ) {
+
+            World w(g);
+
+            THEN( "it is rejected" ) {
+
+                REQUIRE_THROWS(w.set_force_dead(Grid(10, 20)));
+            }
+        }
+    }
+
+} // SCENARIO
+
+SCENARIO( "a world can keep a pyramid of block populations up to date", "[world][pyramid]" ) {
+
+    GIVEN( "a random 150x70 world keeping a pyramid" ) {
+
+        std::srand(122);
+        Grid g(150, 70);
+        for (int y = 0; y < 70; y++) {
+            for (int x = 0; x < 150; x++) {
+                g(x, y) = std::rand() % 3 == 0 ? Cell::ALIVE : Cell::DEAD;
+            }
+        }
+        World w(g);
+        w.set_pyramid(true);
+
+        THEN( "it has levels from 8x8 blocks up to a single block" ) {
+
+            REQUIRE(w.has_pyramid());
+            REQUIRE(w.get_pyramid_levels() == 6);
+            REQUIRE(w.get_pyramid_level(0).across == 19);
+            REQUIRE(w.get_pyramid_level(0).down == 9);
+            REQUIRE(w.get_pyramid_level(5).counts.size() == 1);
+            REQUIRE(w.get_pyramid_level(5).counts[0] == w.get_state().get_alive_cells());
+            REQUIRE_THROWS(w.get_pyramid_level(6));
+        }
+
+        WHEN( "it is stepped on a torus, with a wall forced alive part of the way through" ) {
+
+            w.advance(10, true);
+            Grid wall(150, 70);
+            for (int y = 0; y < 70; y++) {
+                wall(75, y) = Cell::ALIVE;
+            }
+            w.set_force_alive(wall);
+            w.advance(10, true);
+
+            THEN( "every block of every level matches the cells" ) {
+
+                for (int l = 0; l < w.get_pyramid_levels(); l++) {
+                    const World::Level &level = w.get_pyramid_level(l);
+                    for (int y = 0; y < level.down; y++) {
+                        for (int x = 0; x < level.across; x++) {
+                            const int x1 = std::min(150, (x + 1) * level.block), y1 = std::min(70, (y + 1) * level.block);
+                            REQUIRE(level.counts[y * level.across + x]
+                                    == w.get_state().crop(x * level.block, y * level.block, x1, y1).get_alive_cells());
+                        }
+                    }
+                }
+                REQUIRE(w.get_alive_cells() == w.get_state().get_alive_cells());
+                REQUIRE_FALSE(w.is_specialised());
+            }
+        }
+
+        WHEN( "it is resized and the pyramid is dropped" ) {
+
+            w.resize(300, 300);
+            REQUIRE(w.get_pyramid_level(0).across == 38);
+            w.set_pyramid(false);
+
+            THEN( "no pyramid is kept" ) {
+
+                REQUIRE_FALSE(w.has_pyramid());
+                REQUIRE(w.get_pyramid_levels() == 0);
+            }
+        }
+    }
+
+} // SCENARIO
@@ -0,0 +1,96 @@
+/**
+ * @author 964379
+ * @date March, 2020
+ */
+
+// Uses Catch2 from https://github.com/catchorg/Catch2 under the BOOST license
+#include "../catch2/catch.hpp"
+
+#include <sstream>
+
+#include "../grid.h"
+#include "../zoo.h"
+
+SCENARIO( "cropping a grid returns a view onto its cells", "[grid][crop][view]" ) {
+
+    GIVEN( "a grid with size 6x6 containing a glider" ) {
+
+        Grid g(6);
+
+        g.set(1, 3, Cell::ALIVE);
+        g.set(2, 3, Cell::ALIVE);
+        g.set(3, 3, Cell::ALIVE);
+        g.set(3, 2, Cell::ALIVE);
+        g.set(2, 1, Cell::ALIVE);
+
+        WHEN( "the glider's bounding box is cropped" ) {
+
+            GridView v = g.crop(1, 1, 4, 4);
+
+            THEN( "the view looks at the original cells without a copy" ) {
+
+                REQUIRE(v.get_width() == 3);
+                REQUIRE(v.get_height() == 3);
+                REQUIRE(v.get_stride() == 6);
+                REQUIRE(v.get_alive_cells() == 5);
+                REQUIRE(v.get_dead_cells() == 4);
+                REQUIRE(&v(0, 0) == &g(1, 1));
+
+                g.set(1, 1, Cell::ALIVE);
+
+                REQUIRE(v.get(0, 0) == Cell::ALIVE);
+                REQUIRE(v.get_alive_cells() == 6);
+            }
+
+            THEN( "the view can be cropped again relative to itself" ) {
+
+                GridView w = v.crop(1, 2, 3, 3);
+
+                REQUIRE(w.get_width() == 2);
+                REQUIRE(w.get_height() == 1);
+                REQUIRE(&w(0, 0) == &g(2, 3));
+                REQUIRE_THROWS(w.get(2, 0));
+                REQUIRE_THROWS(v.crop(0, 0, 4, 3));
+            }
+
+            THEN( "the view can be rotated and printed like the grid it came from" ) {
+
+                Grid box = v;
+
+                std::ostringstream from_view, from_grid;
+                from_view << v.rotate(1);
+                from_grid << box.rotate(1);
+
+                REQUIRE(from_view.str() == from_grid.str());
+            }
+
+            THEN( "the view can be saved without copying it into a grid" ) {
+
+                REQUIRE_NOTHROW(Zoo::save_ascii("../test_outputs/SAVE_ASCII_VIEW.gol", v));
+
+                Grid loaded = Zoo::load_ascii("../test_outputs/SAVE_ASCII_VIEW.gol");
+
+                REQUIRE(loaded.get_width() == 3);
+                REQUIRE(loaded.get_height() == 3);
+                REQUIRE(loaded.get_alive_cells() == 5);
+                REQUIRE(loaded.get(1, 0) == Cell::ALIVE);
+            }
+        }
+
+        WHEN( "a view of the grid is merged back into an overlapping region of the same grid" ) {
+
+            g.merge(g.crop(1, 1, 4, 4), 2, 2);
+
+            THEN( "the merge reads the cells as they were before it started" ) {
+
+                REQUIRE(g.get(3, 2) == Cell::ALIVE);
+                REQUIRE(g.get(4, 3) == Cell::ALIVE);
+                REQUIRE(g.get(2, 4) == Cell::ALIVE);
+                REQUIRE(g.get(3, 4) == Cell::ALIVE);
+                REQUIRE(g.get(4, 4) == Cell::ALIVE);
+                REQUIRE(g.crop(2, 2, 5, 5).get_alive_cells() == 5);
+            }
+        }
+    }
+
+} // SCENARIO
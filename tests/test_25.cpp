@@ -0,0 +1,167 @@
+/**
+ * @author 964379
+ * @date March, 2020
+ */
+
+// Uses Catch2 from https://github.com/catchorg/Catch2 under the BOOST license
+#include "../catch2/catch.hpp"
+
+#include <atomic>
+#include <fstream>
+#include <sstream>
+
+#include "../grid.h"
+#include "../zoo.h"
+#include "../pool.h"
+#include "../batch.h"
+
+SCENARIO( "a thread pool runs every submitted task", "[pool]" ) {
+
+    GIVEN( "a pool with 4 workers" ) {
+
+        ThreadPool pool(4);
+
+        WHEN( "1000 tasks are submitted and waited on" ) {
+
+            std::atomic<int> count(0);
+            std::atomic<bool> valid_worker(true);
+
+            for (int i = 0; i < 1000; i++) {
+                pool.submit([&](int worker) {
+                    valid_worker = valid_worker && worker >= 0 && worker < 4;
+                    count++;
+                });
+            }
+            pool.wait();
+
+            THEN( "every task has run on one of the workers" ) {
+
+                REQUIRE(pool.get_size() == 4);
+                REQUIRE(pool.get_pending() == 0);
+                REQUIRE(count == 1000);
+                REQUIRE(valid_worker);
+            }
+        }
+    }
+
+    GIVEN( "a pool with a single worker" ) {
+
+        ThreadPool pool(1);
+
+        WHEN( "a task forks tasks of its own and helps run them until they finish" ) {
+
+            std::atomic<int> count(0);
+            bool helped_outside = true;
+
+            pool.submit([&](int) {
+                std::atomic<int> remaining(8);
+                for (int i = 0; i < 8; i++) {
+                    pool.submit([&](int) {
+                        count++;
+                        remaining--;
+                    });
+                }
+                while (remaining > 0) {
+                    pool.run_one();
+                }
+            });
+            pool.wait();
+            helped_outside = pool.run_one();
+
+            THEN( "the forked tasks ran without deadlocking the worker" ) {
+
+                REQUIRE(count == 8);
+                REQUIRE(!helped_outside);
+            }
+        }
+    }
+
+} // SCENARIO
+
+SCENARIO( "a manifest of jobs can be run as a batch", "[batch]" ) {
+
+    GIVEN( "a manifest with two good jobs, a missing input, and comments" ) {
+
+        std::ofstream manifest("../test_outputs/BATCH_MANIFEST.txt");
+        manifest << "# input output steps topology\n"
+                 << "\n"
+                 << "../test_inputs/GLIDER.gol ../test_outputs/BATCH_GLIDER.gol 4 toroidal\n"
+                 << "../test_inputs/GLIDER.gol ../test_outputs/BATCH_GLIDER.bgol 1\n"
+                 << "../test_inputs/DOES_NOT_EXIST.gol ../test_outputs/BATCH_MISSING.gol 1 bounded\n";
+        manifest.close();
+
+        std::vector<Batch::Job> jobs = Batch::load_manifest("../test_outputs/BATCH_MANIFEST.txt");
+
+        THEN( "the manifest is parsed in order" ) {
+
+            REQUIRE(jobs.size() == 3);
+            REQUIRE(jobs[0].steps == 4);
+            REQUIRE(jobs[0].toroidal);
+            REQUIRE(!jobs[1].toroidal);
+            REQUIRE(jobs[2].output == "../test_outputs/BATCH_MISSING.gol");
+        }
+
+        WHEN( "the batch is run on a pool" ) {
+
+            ThreadPool pool(2);
+            std::vector<Batch::Result> results = Batch::run(jobs, pool);
+
+            THEN( "the good jobs are saved and the bad job is reported" ) {
+
+                REQUIRE(results.size() == 3);
+                REQUIRE(results[0].ok);
+                REQUIRE(results[1].ok);
+                REQUIRE(!results[2].ok);
+                REQUIRE(results[0].alive == 5);
+
+                Grid glider = Zoo::load_ascii("../test_outputs/BATCH_GLIDER.gol");
+                REQUIRE(glider.get_alive_cells() == 5);
+                REQUIRE(Zoo::load_binary("../test_outputs/BATCH_GLIDER.bgol").get_alive_cells() == 5);
+
+                std::vector<Batch::Result> specialised = Batch::run(jobs, pool, Rule(), true);
+                REQUIRE(specialised[0].ok);
+                REQUIRE(specialised[0].alive == 5);
+                REQUIRE(Zoo::load_ascii("../test_outputs/BATCH_GLIDER.gol").get_alive_cells() == 5);
+
+                std::ostringstream report;
+                const std::ios_base::fmtflags flags = report.flags();
+                Batch::write_report(report, results, 1.0);
+                REQUIRE(report.str().find("Jobs 3 | Failed 1") != std::string::npos);
+                REQUIRE(report.flags() == flags);
+                REQUIRE(report.precision() == 6);
+            }
+        }
+    }
+
+    GIVEN( "a grid recycled between loads, as each worker's is" ) {
+
+        Grid g;
+        Zoo::load_ascii("../test_inputs/RANDOM.gol", g);
+
+        THEN( "each load replaces the size and every cell of the last" ) {
+
+            Zoo::load_binary("../test_inputs/GLIDER.bgol", g);
+            REQUIRE(g.get_width() == Zoo::load_binary("../test_inputs/GLIDER.bgol").get_width());
+            REQUIRE(g.get_height() == Zoo::load_binary("../test_inputs/GLIDER.bgol").get_height());
+            REQUIRE(GridView(g).hash() == GridView(Zoo::load_binary("../test_inputs/GLIDER.bgol")).hash());
+
+            Zoo::load_ascii("../test_inputs/RANDOM.gol.gz", g);
+            REQUIRE(GridView(g).hash() == GridView(Zoo::load_ascii("../test_inputs/RANDOM.gol")).hash());
+            REQUIRE_THROWS(Zoo::load_ascii("../test_inputs/DOES_NOT_EXIST.gol", g));
+        }
+    }
+
+    GIVEN( "a malformed manifest" ) {
+
+        std::ofstream manifest("../test_outputs/BATCH_MALFORMED.txt");
+        manifest << "../test_inputs/GLIDER.gol ../test_outputs/BATCH_GLIDER.gol 4 sphere\n";
+        manifest.close();
+
+        THEN( "loading it throws an exception" ) {
+
+            REQUIRE_THROWS(Batch::load_manifest("../test_outputs/BATCH_MALFORMED.txt"));
+            REQUIRE_THROWS(Batch::load_manifest("../test_outputs/DOES_NOT_EXIST/MANIFEST.txt"));
+        }
+    }
+
+} // SCENARIO
@@ -0,0 +1,121 @@
+/**
+ * @author 964379
+ * @date March, 2020
+ */
+
+// Uses Catch2 from https://github.com/catchorg/Catch2 under the BOOST license
+#include "../catch2/catch.hpp"
+
+#include "../grid.h"
+#include "../world.h"
+#include "../pool.h"
+#include "../sweep.h"
+
+SCENARIO( "the outcome of a simulation can be classified", "[sweep][classify]" ) {
+
+    GIVEN( "a 8x8 grid containing a blinker" ) {
+
+        Grid g(8);
+
+        g.set(3, 2, Cell::ALIVE);
+        g.set(3, 3, Cell::ALIVE);
+        g.set(3, 4, Cell::ALIVE);
+
+        WHEN( "it is classified under B3/S23" ) {
+
+            World w(g);
+            Sweep::Result r = Sweep::classify(w, 100);
+
+            THEN( "it oscillates with period 2" ) {
+
+                REQUIRE(r.outcome == Sweep::OSCILLATES);
+                REQUIRE(r.period == 2);
+                REQUIRE(r.generation == 2);
+            }
+        }
+
+        WHEN( "it is classified under B/S2" ) {
+
+            World w(g);
+            w.set_rule(Rule::parse("B/S2"));
+            Sweep::Result r = Sweep::classify(w, 100);
+
+            THEN( "the ends die and the centre dies a step later" ) {
+
+                REQUIRE(r.outcome == Sweep::DIES);
+                REQUIRE(r.generation == 2);
+            }
+        }
+
+        WHEN( "it is classified under B/S12" ) {
+
+            World w(g);
+            w.set_rule(Rule::parse("B/S12"));
+            Sweep::Result r = Sweep::classify(w, 100);
+
+            THEN( "it is already stable" ) {
+
+                REQUIRE(r.outcome == Sweep::STABILISES);
+                REQUIRE(r.period == 1);
+                REQUIRE(r.alive == 3);
+            }
+        }
+
+        WHEN( "it is classified under B1/S012345678" ) {
+
+            World w(g);
+            w.set_rule(Rule::parse("B1/S012345678"));
+            Sweep::Result r = Sweep::classify(w, 100);
+
+            THEN( "it fills the grid" ) {
+
+                REQUIRE(r.outcome == Sweep::EXPLODES);
+            }
+        }
+
+        WHEN( "it is classified with too few steps" ) {
+
+            World w(g);
+            Sweep::Result r = Sweep::classify(w, 1);
+
+            THEN( "the outcome is undecided" ) {
+
+                REQUIRE(r.outcome == Sweep::UNDECIDED);
+            }
+        }
+    }
+
+} // SCENARIO
+
+SCENARIO( "one seed can be swept across many rules in parallel", "[sweep][run]" ) {
+
+    GIVEN( "a blinker and a list of rules" ) {
+
+        Grid g(8);
+
+        g.set(3, 2, Cell::ALIVE);
+        g.set(3, 3, Cell::ALIVE);
+        g.set(3, 4, Cell::ALIVE);
+
+        std::vector<Rule> rules = { Rule::parse("B3/S23"), Rule::parse("B/S2"), Rule::parse("B/S12"),
+                                    Rule::parse("B1/S012345678") };
+
+        WHEN( "the rules are swept on a pool" ) {
+
+            ThreadPool pool(3);
+            std::vector<Sweep::Result> results = Sweep::run(g, rules, pool, 100);
+
+            THEN( "the results are in rule order and the seed is untouched" ) {
+
+                REQUIRE(results.size() == 4);
+                REQUIRE(results[0].rule == rules[0]);
+                REQUIRE(results[0].outcome == Sweep::OSCILLATES);
+                REQUIRE(results[1].outcome == Sweep::DIES);
+                REQUIRE(results[2].outcome == Sweep::STABILISES);
+                REQUIRE(results[3].outcome == Sweep::EXPLODES);
+                REQUIRE(g.get_alive_cells() == 3);
+            }
+        }
+    }
+
+} // SCENARIO
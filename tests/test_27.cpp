@@ -0,0 +1,213 @@
+/**
+ * @author 964379
+ * @date March, 2020
+ */
+
+// Uses Catch2 from https://github.com/catchorg/Catch2 under the BOOST license
+#include "../catch2/catch.hpp"
+
+#include <cstdlib>
+
+#include "../grid.h"
+#include "../world.h"
+#include "../bits.h"
+#include "../pool.h"
+#include "../predecessor.h"
+
+SCENARIO( "rows of packed cells can be stepped bit-parallel", "[bits]" ) {
+
+    GIVEN( "a 13x9 grid filled with random cells" ) {
+
+        Grid g(13, 9);
+
+        std::srand(7);
+        for (int y = 0; y < g.get_height(); y++) {
+            for (int x = 0; x < g.get_width(); x++) {
+                g.set(x, y, (std::rand() % 2) ? Cell::ALIVE : Cell::DEAD);
+            }
+        }
+
+        const char *rules[] = { "B3/S23", "B36/S23", "B012345678/S" };
+
+        for (const char *notation : rules) {
+
+            Rule rule = Rule::parse(notation);
+
+            World w(g);
+            w.set_rule(rule);
+            w.step();
+
+            THEN( "every stepped row matches the world under " + std::string(notation) ) {
+
+                for (int y = 0; y < g.get_height(); y++) {
+                    Word up   = y > 0 ? Bits::pack_row(g.data() + (y - 1) * 13, 13) : 0;
+                    Word row  = Bits::pack_row(g.data() + y * 13, 13);
+                    Word down = y < 8 ? Bits::pack_row(g.data() + (y + 1) * 13, 13) : 0;
+
+                    REQUIRE(Bits::next_row(rule, up, row, down, 13) == Bits::pack_row(w.get_state().data() + y * 13, 13));
+                }
+            }
+        }
+    }
+
+} // SCENARIO
+
+SCENARIO( "rules compile to circuits of bitwise operations", "[bits]" ) {
+
+    GIVEN( "Conway's Game of Life" ) {
+
+        Bits::Circuit circuit = Bits::compile(Rule());
+
+        THEN( "it compiles to 3 operations" ) {
+
+            REQUIRE(circuit.ops.size() == 3);
+        }
+    }
+
+    GIVEN( "random rules and random words of cells" ) {
+
+        std::srand(11);
+
+        THEN( "every compiled circuit matches the rule" ) {
+
+            for (int i = 0; i < 500; i++) {
+                Rule rule(std::rand() & 511, std::rand() & 511);
+                Bits::Circuit circuit = Bits::compile(rule);
+                for (int j = 0; j < 8; j++) {
+                    Word words[9];
+                    for (Word &word : words) {
+                        word = (Word) std::rand() << 40 ^ (Word) std::rand() << 20 ^ (Word) std::rand();
+                    }
+                    Bits::Sum sum = Bits::neighbour_sum(words[0], words[1], words[2], words[3], words[4], words[5],
+                            words[6], words[7]);
+
+                    REQUIRE(Bits::evaluate(circuit, words[8], sum) == Bits::apply(rule, words[8], sum));
+                }
+            }
+        }
+    }
+
+    GIVEN( "random grids wider than a word" ) {
+
+        std::srand(13);
+        const int sizes[][2] = { { 130, 7 }, { 64, 3 }, { 65, 1 }, { 1, 5 }, { 1, 1 } };
+        const char *rules[] = { "B3/S23", "B36/S23", "B0/S8", "B1357/S02468" };
+
+        for (const int *size : sizes) {
+
+            const int width = size[0], height = size[1];
+            Grid g(width, height);
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    g.set(x, y, (std::rand() % 2) ? Cell::ALIVE : Cell::DEAD);
+                }
+            }
+
+            for (const char *notation : rules) {
+
+                Rule rule = Rule::parse(notation);
+
+                THEN( "a step matches counting every neighbour under " + std::string(notation) ) {
+
+                    for (bool toroidal : { false, true }) {
+                        World w(g);
+                        w.set_rule(rule);
+                        w.step(toroidal);
+                        for (int y = 0; y < height; y++) {
+                            for (int x = 0; x < width; x++) {
+                                int neighbours = 0;
+                                for (int dy = -1; dy <= 1; dy++) {
+                                    for (int dx = -1; dx <= 1; dx++) {
+                                        int nx = x + dx, ny = y + dy;
+                                        if ((dx == 0 && dy == 0) || (!toroidal && (nx < 0 || nx >= width || ny < 0 || ny >= height))) {
+                                            continue;
+                                        }
+                                        nx = (nx + width) % width;
+                                        ny = (ny + height) % height;
+                                        neighbours += g.get(nx, ny) == Cell::ALIVE;
+                                    }
+                                }
+                                const bool alive = g.get(x, y) == Cell::ALIVE;
+                                const bool next = alive ? rule.survives(neighbours) : rule.is_born(neighbours);
+
+                                REQUIRE((w.get_state().get(x, y) == Cell::ALIVE) == next);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+} // SCENARIO
+
+SCENARIO( "predecessors of a grid can be searched for", "[predecessor]" ) {
+
+    ThreadPool pool(2);
+
+    GIVEN( "a 6x5 grid that is the next state of a random grid" ) {
+
+        Grid g(6, 5);
+
+        std::srand(11);
+        for (int y = 0; y < g.get_height(); y++) {
+            for (int x = 0; x < g.get_width(); x++) {
+                g.set(x, y, (std::rand() % 3 == 0) ? Cell::ALIVE : Cell::DEAD);
+            }
+        }
+
+        World w(g);
+        w.step();
+        Grid target = w.get_state();
+
+        WHEN( "a predecessor is searched for" ) {
+
+            Predecessor::Result result = Predecessor::search(target, pool);
+
+            THEN( "one is found and it steps into the target" ) {
+
+                REQUIRE(result.found);
+                REQUIRE(result.nodes > 0);
+
+                World check(result.predecessor);
+                check.step();
+
+                REQUIRE(check.get_view().hash() == GridView(target).hash());
+            }
+        }
+    }
+
+    GIVEN( "a single alive cell, which nothing can step into within a 1x1 grid" ) {
+
+        Grid target(1);
+        target.set(0, 0, Cell::ALIVE);
+
+        THEN( "no predecessor exists without a margin" ) {
+
+            REQUIRE(!Predecessor::search(target, pool).found);
+        }
+
+        THEN( "a predecessor exists with a margin" ) {
+
+            Predecessor::Result result = Predecessor::search(target, pool, 1);
+
+            REQUIRE(result.found);
+            REQUIRE(result.predecessor.get_width() == 3);
+
+            World check(result.predecessor);
+            check.step();
+
+            REQUIRE(check.get_alive_cells() == 1);
+            REQUIRE(check.get_state().get(1, 1) == Cell::ALIVE);
+        }
+    }
+
+    GIVEN( "a target wider than 32 cells" ) {
+
+        THEN( "the search throws an exception" ) {
+
+            REQUIRE_THROWS(Predecessor::search(Grid(33, 1), pool));
+        }
+    }
+
+} // SCENARIO
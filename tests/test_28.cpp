@@ -0,0 +1,126 @@
+/**
+ * @author 964379
+ * @date March, 2020
+ */
+
+// Uses Catch2 from https://github.com/catchorg/Catch2 under the BOOST license
+#include "../catch2/catch.hpp"
+
+#include "../grid.h"
+#include "../world.h"
+#include "../zoo.h"
+#include "../pool.h"
+#include "../pattern.h"
+#include "../search.h"
+
+SCENARIO( "patterns can be reduced to a canonical form", "[pattern]" ) {
+
+    GIVEN( "a glider in the corner of a larger grid" ) {
+
+        Grid g(8);
+        g.merge(Zoo::glider(), 2, 3);
+
+        THEN( "trimming crops it to its 3x3 bounding box" ) {
+
+            GridView trimmed = Pattern::trim(g);
+
+            REQUIRE(trimmed.get_width() == 3);
+            REQUIRE(trimmed.get_height() == 3);
+            REQUIRE(trimmed.hash() == GridView(Zoo::glider()).hash());
+        }
+
+        THEN( "every rotation and reflection has the same canonical form" ) {
+
+            unsigned long long hash = Pattern::canonical_hash(g);
+
+            for (int rotation = 0; rotation < 4; rotation++) {
+                REQUIRE(Pattern::canonical_hash(Zoo::glider().rotate(rotation)) == hash);
+                REQUIRE(Pattern::canonical_hash(Pattern::mirror(Zoo::glider().rotate(rotation))) == hash);
+            }
+        }
+
+        THEN( "a different pattern has a different canonical form" ) {
+
+            REQUIRE(Pattern::canonical_hash(Grid(3)) != Pattern::canonical_hash(g));
+        }
+    }
+
+} // SCENARIO
+
+SCENARIO( "still lifes and oscillators can be searched for", "[search]" ) {
+
+    ThreadPool pool(2);
+
+    GIVEN( "a 3x3 box" ) {
+
+        WHEN( "still lifes are searched for" ) {
+
+            std::vector<Search::Found> found = Search::still_lifes(3, 3, pool);
+
+            THEN( "the block, tub, boat and ship are found" ) {
+
+                REQUIRE(found.size() == 4);
+
+                for (const Search::Found &still : found) {
+                    World w(Grid(still.pattern.get_width() + 2, still.pattern.get_height() + 2));
+                    Grid padded = w.get_state();
+                    padded.merge(still.pattern, 1, 1);
+                    w.set_state(padded);
+                    w.step();
+
+                    REQUIRE(still.period == 1);
+                    REQUIRE(w.get_view().hash() == GridView(padded).hash());
+                }
+            }
+        }
+
+        WHEN( "period 2 oscillators are searched for" ) {
+
+            std::vector<Search::Found> found = Search::oscillators(3, 3, 2, pool);
+
+            THEN( "only the blinker is found" ) {
+
+                REQUIRE(found.size() == 1);
+                REQUIRE(found[0].period == 2);
+                REQUIRE(found[0].pattern.get_alive_cells() == 3);
+            }
+        }
+    }
+
+    GIVEN( "a 4x4 box" ) {
+
+        std::vector<Search::Found> found = Search::oscillators(4, 4, 2, pool);
+
+        THEN( "the blinker, toad and beacon are among the period 2 oscillators" ) {
+
+            int sizes[7] = { };
+            for (const Search::Found &oscillator : found) {
+                int cells = oscillator.pattern.get_alive_cells();
+                if (cells < 7) {
+                    sizes[cells]++;
+                }
+            }
+
+            REQUIRE(sizes[3] == 1);
+            REQUIRE(sizes[6] >= 2);
+        }
+
+        THEN( "the searches for the block with period 1 agree" ) {
+
+            REQUIRE(Search::oscillators(4, 4, 1, pool).size() == Search::still_lifes(4, 4, pool).size());
+        }
+    }
+
+    GIVEN( "invalid boxes" ) {
+
+        THEN( "the searches throw exceptions" ) {
+
+            REQUIRE_THROWS(Search::still_lifes(0, 3, pool));
+            REQUIRE_THROWS(Search::oscillators(3, 3, 0, pool));
+            REQUIRE_THROWS(Search::oscillators(7, 7, 2, pool));
+            REQUIRE_THROWS(Search::oscillators(3, 3, 5, pool));
+            REQUIRE_THROWS(Search::oscillators(5, 4, 4, pool));
+        }
+    }
+
+} // SCENARIO
@@ -0,0 +1,133 @@
+/**
+ * @author 964379
+ * @date March, 2020
+ */
+
+// Uses Catch2 from https://github.com/catchorg/Catch2 under the BOOST license
+#include "../catch2/catch.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#include "../grid.h"
+#include "../world.h"
+#include "../pool.h"
+#include "../rule.h"
+#include "../pattern.h"
+#include "../collision.h"
+
+SCENARIO( "collisions of two gliders can be set up", "[collision]" ) {
+
+    GIVEN( "the setups within 1 lane" ) {
+
+        std::vector<Collision::Setup> setups = Collision::setups(1);
+
+        THEN( "there are 3 orientations of 9 offsets at 4 timings" ) {
+
+            REQUIRE(setups.size() == 3 * 9 * 4);
+        }
+
+        THEN( "every setup places two gliders" ) {
+
+            for (const Collision::Setup &setup : setups) {
+                REQUIRE(Collision::place(setup, 1).get_alive_cells() == 10);
+            }
+        }
+    }
+
+    GIVEN( "a negative number of lanes" ) {
+
+        THEN( "generating setups throws an exception" ) {
+
+            REQUIRE_THROWS(Collision::setups(-1));
+        }
+    }
+
+} // SCENARIO
+
+SCENARIO( "collisions of two gliders can be catalogued", "[collision]" ) {
+
+    ThreadPool pool(2);
+
+    GIVEN( "the collisions of gliders heading for the same point" ) {
+
+        std::vector<Collision::Entry> entries = Collision::enumerate(pool, 0);
+
+        THEN( "10 distinct collisions have 5 distinct outcomes" ) {
+
+            int collisions = 0;
+            for (const Collision::Entry &entry : entries) {
+                collisions += entry.setups;
+            }
+
+            REQUIRE(collisions == 10);
+            REQUIRE(entries.size() == 5);
+        }
+
+        THEN( "the most common outcome is that both gliders vanish" ) {
+
+            REQUIRE(entries[0].outcome == Sweep::DIES);
+            REQUIRE(entries[0].debris.get_alive_cells() == 0);
+        }
+
+        THEN( "one collision leaves a pond" ) {
+
+            Grid pond(4, 4);
+            pond.set(1, 0, Cell::ALIVE);
+            pond.set(2, 0, Cell::ALIVE);
+            pond.set(0, 1, Cell::ALIVE);
+            pond.set(3, 1, Cell::ALIVE);
+            pond.set(0, 2, Cell::ALIVE);
+            pond.set(3, 2, Cell::ALIVE);
+            pond.set(1, 3, Cell::ALIVE);
+            pond.set(2, 3, Cell::ALIVE);
+
+            int ponds = 0;
+            for (const Collision::Entry &entry : entries) {
+                if (entry.outcome == Sweep::STABILISES && GridView(entry.debris).hash() == GridView(pond).hash()) {
+                    ponds++;
+                }
+            }
+
+            REQUIRE(ponds == 1);
+        }
+
+        THEN( "the catalogue has a line per outcome and a summary" ) {
+
+            std::ostringstream stream;
+            Collision::write_catalogue(stream, entries);
+
+            std::string catalogue = stream.str();
+
+            REQUIRE(catalogue.find("Collisions 10 | Outcomes 5") != std::string::npos);
+            REQUIRE(std::count(catalogue.begin(), catalogue.end(), '\n') == 7);
+        }
+    }
+
+    GIVEN( "the same collisions in HighLife, where the glider is still a glider" ) {
+
+        std::vector<Collision::Entry> entries = Collision::enumerate(pool, 0, 1000, Rule::parse("B36/S23"));
+
+        THEN( "the same 10 distinct collisions are found, and none of them escapes the board" ) {
+
+            int collisions = 0;
+            for (const Collision::Entry &entry : entries) {
+                collisions += entry.setups;
+                REQUIRE(entry.outcome != Sweep::UNDECIDED);
+            }
+
+            REQUIRE(collisions == 10);
+        }
+    }
+
+    GIVEN( "a rule where the glider is not a glider" ) {
+
+        THEN( "collisions cannot be set up in it" ) {
+
+            REQUIRE_THROWS_AS(Collision::enumerate(pool, 0, 1000, Rule::parse("B2/S")), std::runtime_error);
+            REQUIRE_THROWS_AS(Collision::place(Collision::Setup(), 0, Rule::parse("B2/S")), std::runtime_error);
+        }
+    }
+
+} // SCENARIO
@@ -0,0 +1,121 @@
+/**
+ * @author 964379
+ * @date March, 2020
+ */
+
+// Uses Catch2 from https://github.com/catchorg/Catch2 under the BOOST license
+#include "../catch2/catch.hpp"
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "../grid.h"
+#include "../zoo.h"
+
+SCENARIO( "a grid can be saved to and loaded from a NumPy npy file", "[zoo][npy]" ) {
+
+    GIVEN( "an 11x3 grid containing a glider" ) {
+
+        Grid g(11, 3);
+        g.merge(Zoo::glider(), 8, 0);
+
+        WHEN( "the grid is saved with one byte per cell" ) {
+
+            Zoo::save_npy("../test_outputs/SAVE_NPY_GLIDER.npy", g);
+
+            std::ifstream file("../test_outputs/SAVE_NPY_GLIDER.npy", std::ifstream::binary);
+            std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+            std::size_t data = contents.find('\n') + 1;
+
+            THEN( "the file has a 64 byte aligned npy header describing the shape" ) {
+
+                REQUIRE(data % 64 == 0);
+                REQUIRE(contents.size() == data + 11 * 3);
+                REQUIRE(contents.substr(1, 5) == "NUMPY");
+                REQUIRE(contents.find("{'descr': '|u1', 'fortran_order': False, 'shape': (3, 11), }") == 10);
+            }
+
+            THEN( "the cells are written as bytes in row major order" ) {
+
+                REQUIRE(contents[data + 9] == 1);
+                REQUIRE(contents[data + 11 + 10] == 1);
+                REQUIRE(contents[data + 22 + 8] == 1);
+                REQUIRE(contents[data + 22 + 7] == 0);
+            }
+
+            THEN( "loading the file gives back the same grid" ) {
+
+                Grid loaded = Zoo::load_npy("../test_outputs/SAVE_NPY_GLIDER.npy");
+
+                REQUIRE(loaded.get_width() == 11);
+                REQUIRE(loaded.get_height() == 3);
+                REQUIRE(GridView(loaded).hash() == GridView(g).hash());
+            }
+        }
+
+        WHEN( "the grid is saved packed 8 cells per byte" ) {
+
+            Zoo::save_npy("../test_outputs/SAVE_NPY_GLIDER_PACKED.npy", g, true);
+
+            std::ifstream file("../test_outputs/SAVE_NPY_GLIDER_PACKED.npy", std::ifstream::binary);
+            std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+            std::size_t data = contents.find('\n') + 1;
+
+            THEN( "each row is 2 bytes packed most significant bit first" ) {
+
+                REQUIRE(data % 64 == 0);
+                REQUIRE(contents.size() == data + 2 * 3);
+                REQUIRE(contents.find("'shape': (3, 2)") != std::string::npos);
+                REQUIRE(static_cast<unsigned char>(contents[data]) == 0x00);
+                REQUIRE(static_cast<unsigned char>(contents[data + 1]) == 0x40);
+                REQUIRE(static_cast<unsigned char>(contents[data + 4]) == 0x00);
+                REQUIRE(static_cast<unsigned char>(contents[data + 5]) == 0xe0);
+            }
+
+            THEN( "loading the file with its width gives back the same grid" ) {
+
+                Grid loaded = Zoo::load_npy("../test_outputs/SAVE_NPY_GLIDER_PACKED.npy", 11);
+
+                REQUIRE(loaded.get_width() == 11);
+                REQUIRE(GridView(loaded).hash() == GridView(g).hash());
+            }
+
+            THEN( "loading the file with a width that needs a different number of bytes throws an exception" ) {
+
+                REQUIRE_THROWS(Zoo::load_npy("../test_outputs/SAVE_NPY_GLIDER_PACKED.npy", 17));
+            }
+        }
+    }
+
+    GIVEN( "files that are not npy files" ) {
+
+        THEN( "loading them throws an exception" ) {
+
+            REQUIRE_THROWS(Zoo::load_npy("../test_inputs/GLIDER.gol"));
+            REQUIRE_THROWS(Zoo::load_npy("../test_inputs/DOES_NOT_EXIST.npy"));
+        }
+    }
+
+    GIVEN( "npy files whose header has a key with no value after it" ) {
+
+        auto write_npy = [](const std::string &path, std::string header) {
+            header.resize(54, ' ');
+            std::ofstream file(path, std::ofstream::binary);
+            file.write("\x93NUMPY\x01\x00", 8);
+            file.put((char) header.size()).put(0);
+            file << header;
+        };
+        write_npy("../test_outputs/NPY_NO_SHAPE.npy", "{'descr': '|u1', 'fortran_order': False, 'shape':");
+        write_npy("../test_outputs/NPY_OPEN_SHAPE.npy", "{'descr': '|u1', 'fortran_order': False, 'shape': (3, 4");
+
+        THEN( "loading them throws an exception" ) {
+
+            REQUIRE_THROWS_AS(Zoo::load_npy("../test_outputs/NPY_NO_SHAPE.npy"), std::runtime_error);
+            REQUIRE_THROWS_AS(Zoo::load_npy("../test_outputs/NPY_OPEN_SHAPE.npy"), std::runtime_error);
+        }
+    }
+
+} // SCENARIO
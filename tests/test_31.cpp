@@ -0,0 +1,88 @@
+/**
+ * @author 964379
+ * @date March, 2020
+ */
+
+// Uses Catch2 from https://github.com/catchorg/Catch2 under the BOOST license
+#include "../catch2/catch.hpp"
+
+#include "../grid.h"
+#include "../zoo.h"
+
+SCENARIO( "a grid can be loaded from a Netpbm image", "[zoo][pbm][pgm]" ) {
+
+    Grid glider(5, 4);
+    glider.merge(Zoo::glider(), 1, 0);
+
+//        +-----+
+//        |  #  |
+//        |   # |
+//        | ### |
+//        |     |
+//        +-----+
+
+    GIVEN( "a glider drawn as an ascii bitmap with a comment" ) {
+
+        Grid g = Zoo::load_pbm("../test_inputs/GLIDER_P1.pbm");
+
+        THEN( "the black pixels are the alive cells" ) {
+
+            REQUIRE(g.get_width() == 5);
+            REQUIRE(g.get_height() == 4);
+            REQUIRE(GridView(g).hash() == GridView(glider).hash());
+        }
+    }
+
+    GIVEN( "a glider drawn as an ascii bitmap with no spaces between pixels" ) {
+
+        Grid g = Zoo::load_pbm("../test_inputs/GLIDER_P1_DENSE.pbm");
+
+        THEN( "every digit is a pixel" ) {
+
+            REQUIRE(GridView(g).hash() == GridView(glider).hash());
+        }
+    }
+
+    GIVEN( "a glider drawn as a packed binary bitmap" ) {
+
+        Grid g = Zoo::load_pbm("../test_inputs/GLIDER_P4.pbm");
+
+        THEN( "the packed rows unpack to the glider" ) {
+
+            REQUIRE(GridView(g).hash() == GridView(glider).hash());
+        }
+    }
+
+    GIVEN( "a glider drawn in shades of grey, as an ascii and a binary greymap" ) {
+
+        const char *paths[] = { "../test_inputs/GLIDER_P2.pgm", "../test_inputs/GLIDER_P5.pgm" };
+
+        for (const char *path : paths) {
+
+            THEN( "pixels darker than mid grey are alive by default in " + std::string(path) ) {
+
+                REQUIRE(GridView(Zoo::load_pgm(path)).hash() == GridView(glider).hash());
+            }
+
+            THEN( "the threshold decides which shades are alive in " + std::string(path) ) {
+
+                REQUIRE(Zoo::load_pgm(path, 50).get_alive_cells() == 2);
+                REQUIRE(Zoo::load_pgm(path, 201).get_alive_cells() == 6);
+                REQUIRE(Zoo::load_pgm(path, 0).get_alive_cells() == 0);
+            }
+        }
+    }
+
+    GIVEN( "images that are missing, of the wrong kind, or truncated" ) {
+
+        THEN( "loading them throws an exception" ) {
+
+            REQUIRE_THROWS(Zoo::load_pbm("../test_inputs/DOES_NOT_EXIST.pbm"));
+            REQUIRE_THROWS(Zoo::load_pbm("../test_inputs/GLIDER_P2.pgm"));
+            REQUIRE_THROWS(Zoo::load_pgm("../test_inputs/GLIDER_P4.pbm"));
+            REQUIRE_THROWS(Zoo::load_pbm("../test_inputs/GLIDER.gol"));
+            REQUIRE_THROWS(Zoo::load_pbm("../test_inputs/MALFORMED_DATA.pbm"));
+        }
+    }
+
+} // SCENARIO
@@ -0,0 +1,162 @@
+/**
+ * @author 964379
+ * @date March, 2020
+ */
+
+// Uses Catch2 from https://github.com/catchorg/Catch2 under the BOOST license
+#include "../catch2/catch.hpp"
+
+#include <cstring>
+#include <string>
+#include <thread>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "../pool.h"
+#include "../metrics.h"
+
+/**
+ * Send a request to a port on 127.0.0.1 and read the whole response.
+ */
+static std::string fetch(int port, const std::string &request) {
+    int client = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    std::string response;
+    if (connect(client, (sockaddr*) &address, sizeof(address)) == 0) {
+        send(client, request.data(), request.size(), 0);
+        char buffer[1024];
+        ssize_t received;
+        while ((received = recv(client, buffer, sizeof(buffer), 0)) > 0) {
+            response.append(buffer, received);
+        }
+    }
+    close(client);
+    return response;
+}
+
+SCENARIO( "metrics of a simulation can be recorded and rendered", "[metrics]" ) {
+
+    GIVEN( "metrics with three steps recorded" ) {
+
+        Metrics metrics;
+        metrics.record_step(5e-6, 1, 10);
+        metrics.record_step(5e-6, 2, 12);
+        metrics.record_step(0.5, 3, 7);
+
+        std::string text = metrics.render();
+
+        THEN( "the counters and gauges hold the latest values" ) {
+
+            REQUIRE(metrics.get_steps() == 3);
+            REQUIRE(metrics.get_generation() == 3);
+            REQUIRE(text.find("\ngol_generation 3\n") != std::string::npos);
+            REQUIRE(text.find("\ngol_steps_total 3\n") != std::string::npos);
+            REQUIRE(text.find("\ngol_population 7\n") != std::string::npos);
+            REQUIRE(text.find("# TYPE gol_step_seconds histogram\n") != std::string::npos);
+        }
+
+        THEN( "the latency histogram buckets are cumulative" ) {
+
+            REQUIRE(text.find("gol_step_seconds_bucket{le=\"1e-06\"} 0\n") != std::string::npos);
+            REQUIRE(text.find("gol_step_seconds_bucket{le=\"1e-05\"} 2\n") != std::string::npos);
+            REQUIRE(text.find("gol_step_seconds_bucket{le=\"0.1\"} 2\n") != std::string::npos);
+            REQUIRE(text.find("gol_step_seconds_bucket{le=\"1\"} 3\n") != std::string::npos);
+            REQUIRE(text.find("gol_step_seconds_bucket{le=\"+Inf\"} 3\n") != std::string::npos);
+            REQUIRE(text.find("gol_step_seconds_count 3\n") != std::string::npos);
+        }
+
+        THEN( "the resident memory of the process is reported" ) {
+
+            REQUIRE(Metrics::resident_memory() > 0);
+            REQUIRE(text.find("process_resident_memory_bytes ") != std::string::npos);
+        }
+    }
+
+    GIVEN( "metrics watching a pool" ) {
+
+        Metrics metrics;
+        ThreadPool pool(1);
+        metrics.watch(&pool);
+
+        THEN( "an idle pool has a queue depth of 0" ) {
+
+            REQUIRE(metrics.render().find("\ngol_queue_depth 0\n") != std::string::npos);
+        }
+
+        metrics.watch(nullptr);
+    }
+
+    GIVEN( "metrics recording steps without counting the population" ) {
+
+        Metrics metrics;
+        metrics.record_step(5e-6, 1, 10);
+        metrics.record_step(5e-6, 2);
+
+        THEN( "the population is left as last counted" ) {
+
+            std::string text = metrics.render();
+            REQUIRE(metrics.get_steps() == 2);
+            REQUIRE(text.find("\ngol_generation 2\n") != std::string::npos);
+            REQUIRE(text.find("\ngol_population 10\n") != std::string::npos);
+        }
+    }
+
+    GIVEN( "pools watched and unwatched while the metrics are rendered" ) {
+
+        Metrics metrics;
+        std::atomic<bool> done { };
+        std::thread scraper([&]() {
+            while (!done) {
+                metrics.render();
+            }
+        });
+
+        THEN( "each pool can be destroyed as soon as it is unwatched" ) {
+
+            for (int round = 0; round < 200; round++) {
+                ThreadPool pool(1);
+                metrics.watch(&pool);
+                metrics.watch(nullptr);
+            }
+            done = true;
+            scraper.join();
+            REQUIRE(metrics.render().find("\ngol_queue_depth 0\n") != std::string::npos);
+        }
+    }
+
+} // SCENARIO
+
+SCENARIO( "metrics can be served over loopback HTTP", "[metrics]" ) {
+
+    GIVEN( "a server on any free port" ) {
+
+        Metrics metrics;
+        metrics.record_step(1e-3, 42, 5);
+        MetricsServer server(metrics, 0);
+
+        REQUIRE(server.get_port() > 0);
+
+        THEN( "GET /metrics returns the metrics as plain text" ) {
+
+            std::string response = fetch(server.get_port(), "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+
+            REQUIRE(response.compare(0, 15, "HTTP/1.1 200 OK") == 0);
+            REQUIRE(response.find("Content-Type: text/plain; version=0.0.4") != std::string::npos);
+            REQUIRE(response.find("\ngol_generation 42\n") != std::string::npos);
+        }
+
+        THEN( "any other path is not found" ) {
+
+            std::string response = fetch(server.get_port(), "GET / HTTP/1.1\r\n\r\n");
+
+            REQUIRE(response.compare(0, 22, "HTTP/1.1 404 Not Found") == 0);
+        }
+    }
+
+} // SCENARIO
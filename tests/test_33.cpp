@@ -0,0 +1,312 @@
+/**
+ * @author 964379
+ * @date March, 2020
+ */
+
+// Uses Catch2 from https://github.com/catchorg/Catch2 under the BOOST license
+#include "../catch2/catch.hpp"
+
+#include <cstdlib>
+#include <stdexcept>
+
+#include "../grid.h"
+#include "../world.h"
+#include "../zoo.h"
+#include "../pool.h"
+#include "../hashlife.h"
+
+SCENARIO( "HashLife simulates the unbounded plane", "[hashlife]" ) {
+
+    GIVEN( "an r-pentomino in the middle of a 256x256 grid" ) {
+
+        Grid g(256);
+        g.merge(Zoo::r_pentomino(), 128, 128);
+
+        World w(g);
+        w.advance(300);
+
+        WHEN( "it is advanced 300 steps on the calling thread" ) {
+
+            HashLife life;
+            life.set_state(g);
+            life.advance(300);
+
+            THEN( "the plane matches a world big enough to hold it" ) {
+
+                REQUIRE(life.get_generation() == 300);
+                REQUIRE(life.get_alive_cells() == (unsigned long long) w.get_alive_cells());
+                REQUIRE(GridView(life.get_region(0, 0, 256, 256)).hash() == w.get_view().hash());
+            }
+        }
+
+        WHEN( "it is advanced 300 steps across a pool, a step at a time and then in one go" ) {
+
+            ThreadPool pool(4);
+            HashLife stepped, jumped;
+            stepped.set_state(g);
+            jumped.set_state(g);
+            for (int step = 0; step < 300; step++) {
+                stepped.advance(1, pool);
+            }
+            jumped.advance(300, pool);
+
+            THEN( "both match the world" ) {
+
+                REQUIRE(GridView(stepped.get_region(0, 0, 256, 256)).hash() == w.get_view().hash());
+                REQUIRE(GridView(jumped.get_region(0, 0, 256, 256)).hash() == w.get_view().hash());
+            }
+        }
+
+        WHEN( "it is advanced 2^30 steps across a pool" ) {
+
+            ThreadPool pool(2);
+            HashLife life;
+            life.set_state(g);
+            life.advance(1ULL << 30, pool);
+
+            THEN( "it has long since stabilised at 116 cells, 6 of the gliders among them" ) {
+
+                REQUIRE(life.get_generation() == 1ULL << 30);
+                REQUIRE(life.get_alive_cells() == 116);
+            }
+        }
+    }
+
+    GIVEN( "a glider" ) {
+
+        HashLife life;
+        life.set_state(Zoo::glider());
+
+        WHEN( "it is advanced 2^20 steps" ) {
+
+            life.advance(1 << 20);
+
+            THEN( "it has moved 2^18 cells down and right" ) {
+
+                REQUIRE(life.get_alive_cells() == 5);
+                REQUIRE(GridView(life.get_region(1 << 18, 1 << 18, 3, 3)).hash() == GridView(Zoo::glider()).hash());
+                REQUIRE(life.get_region(0, 0, 3, 3).get_alive_cells() == 0);
+            }
+
+            THEN( "the node table stays small" ) {
+
+                REQUIRE(life.get_nodes() < 5000);
+            }
+        }
+    }
+
+    GIVEN( "a rule with births on 0 neighbours" ) {
+
+        THEN( "HashLife cannot simulate it" ) {
+
+            REQUIRE_THROWS(HashLife(Rule::parse("B0/S8")));
+        }
+    }
+
+} // SCENARIO
+
+SCENARIO( "HashLife keeps to a memory limit by collecting garbage", "[hashlife]" ) {
+
+    Grid g(256);
+    g.merge(Zoo::r_pentomino(), 128, 128);
+
+    //Gliders escape a bounded world, so compare against a plane without a limit.
+    HashLife reference;
+    reference.set_state(g);
+    reference.advance(1000);
+
+    GIVEN( "an R-pentomino advanced 1000 steps" ) {
+
+        HashLife life;
+        life.set_state(g);
+        life.advance(1000);
+        Grid before = life.get_region(0, 0, 256, 256);
+        const std::size_t nodes = life.get_nodes();
+
+        WHEN( "it is collected keeping memoised results" ) {
+
+            const std::size_t freed = life.collect();
+
+            THEN( "nodes are freed and the plane is unchanged" ) {
+
+                REQUIRE(freed > 0);
+                REQUIRE(life.get_nodes() == nodes - freed);
+                REQUIRE(GridView(life.get_region(0, 0, 256, 256)).hash() == GridView(before).hash());
+                REQUIRE(life.get_statistics().collections == 1);
+                REQUIRE(life.get_statistics().collected == freed);
+            }
+
+            THEN( "it still steps correctly" ) {
+
+                reference.advance(300);
+                life.advance(300);
+                REQUIRE(GridView(life.get_region(-512, -512, 1280, 1280)).hash()
+                        == GridView(reference.get_region(-512, -512, 1280, 1280)).hash());
+            }
+        }
+
+        WHEN( "it is collected dropping memoised results" ) {
+
+            life.collect();
+            const std::size_t kept = life.get_nodes();
+            life.collect(false);
+
+            THEN( "fewer nodes survive than when keeping them" ) {
+
+                REQUIRE(life.get_nodes() < kept);
+                REQUIRE(GridView(life.get_region(0, 0, 256, 256)).hash() == GridView(before).hash());
+            }
+        }
+    }
+
+    GIVEN( "a limit of a megabyte" ) {
+
+        HashLife life;
+        life.set_memory_limit(1 << 20);
+        life.set_state(g);
+
+        WHEN( "an R-pentomino is advanced 1000 steps, one at a time and in one jump" ) {
+
+            for (int step = 0; step < 500; step++) {
+                life.advance(1);
+            }
+            ThreadPool pool(2);
+            life.advance(500, pool);
+
+            THEN( "it matches the plane without a limit, within the limit" ) {
+
+                HashLife::Statistics statistics = life.get_statistics();
+                REQUIRE(GridView(life.get_region(-512, -512, 1280, 1280)).hash()
+                        == GridView(reference.get_region(-512, -512, 1280, 1280)).hash());
+                REQUIRE(statistics.collections > 0);
+                REQUIRE(statistics.bytes <= statistics.limit);
+                REQUIRE(statistics.limit == 1 << 20);
+                REQUIRE(statistics.hits + statistics.misses > 0);
+            }
+        }
+    }
+
+    GIVEN( "random soups under limits tight enough to run out of memory part way through steps" ) {
+
+        std::srand(112);
+
+        THEN( "each reaches exactly the generation asked for, with the same cells as without a limit" ) {
+
+            for (int run = 0; run < 300; run++) {
+                Grid soup(16, 16);
+                for (int y = 0; y < 16; y++) {
+                    for (int x = 0; x < 16; x++) {
+                        soup.set(x, y, std::rand() % 2 ? Cell::ALIVE : Cell::DEAD);
+                    }
+                }
+                const int generations = 40 + std::rand() % 40;
+                HashLife life, unlimited;
+                life.set_memory_limit(30000 + std::rand() % 120000);
+                unlimited.set_state(soup);
+                unlimited.advance(generations);
+                try {
+                    life.set_state(soup);
+                    life.advance(generations);
+                } catch (const std::runtime_error&) {
+                    // Too small a limit for this soup at all
+                    continue;
+                }
+                REQUIRE(life.get_generation() == (unsigned long long) generations);
+                REQUIRE(GridView(life.get_region(-128, -128, 272, 272)).hash()
+                        == GridView(unlimited.get_region(-128, -128, 272, 272)).hash());
+            }
+        }
+    }
+
+    GIVEN( "a limit too small to hold the pattern" ) {
+
+        HashLife life;
+        life.set_state(g);
+        life.set_memory_limit(life.get_statistics().bytes / 2);
+
+        THEN( "advancing throws" ) {
+
+            REQUIRE_THROWS(life.advance(1));
+        }
+    }
+
+} // SCENARIO
+
+SCENARIO( "HashLife saves and loads a cache of results", "[hashlife]" ) {
+
+    Grid g(Zoo::glider());
+
+    GIVEN( "the cache of a glider advanced 4096 steps" ) {
+
+        HashLife cold;
+        cold.set_state(g);
+        cold.advance(4096);
+        cold.save_cache("../test_outputs/GLIDER.hashlife");
+
+        WHEN( "it is loaded by a new plane for the same rule" ) {
+
+            HashLife warm;
+            REQUIRE(warm.load_cache("../test_outputs/GLIDER.hashlife"));
+            const std::size_t nodes = warm.get_nodes();
+            warm.set_state(g);
+            warm.advance(4096);
+
+            THEN( "it has every node and advances without creating any" ) {
+
+                REQUIRE(nodes == cold.get_nodes());
+                REQUIRE(warm.get_nodes() == nodes);
+                REQUIRE(warm.get_region(1020, 1020, 8, 8).get_alive_cells() == 5);
+                REQUIRE(warm.get_statistics().misses < cold.get_statistics().misses / 10);
+                REQUIRE(GridView(warm.get_region(1020, 1020, 8, 8)).hash()
+                        == GridView(cold.get_region(1020, 1020, 8, 8)).hash());
+            }
+        }
+
+        WHEN( "it is loaded by a plane that already has nodes" ) {
+
+            HashLife warm;
+            warm.set_state(Zoo::r_pentomino());
+            warm.advance(100);
+            REQUIRE(warm.load_cache("../test_outputs/GLIDER.hashlife"));
+            warm.set_state(g);
+            warm.advance(4096);
+
+            THEN( "it still steps correctly" ) {
+
+                REQUIRE(GridView(warm.get_region(1020, 1020, 8, 8)).hash()
+                        == GridView(cold.get_region(1020, 1020, 8, 8)).hash());
+            }
+        }
+
+        WHEN( "it is loaded by a plane for another rule" ) {
+
+            HashLife other(Rule::parse("B36/S23"));
+
+            THEN( "it is ignored" ) {
+
+                REQUIRE_FALSE(other.load_cache("../test_outputs/GLIDER.hashlife"));
+            }
+        }
+    }
+
+    GIVEN( "no cache file" ) {
+
+        HashLife life;
+
+        THEN( "nothing is loaded" ) {
+
+            REQUIRE_FALSE(life.load_cache("../test_outputs/MISSING.hashlife"));
+        }
+    }
+
+    GIVEN( "a file that is not a cache" ) {
+
+        HashLife life;
+
+        THEN( "loading throws" ) {
+
+            REQUIRE_THROWS(life.load_cache("../test_inputs/GLIDER.gol"));
+        }
+    }
+
+} // SCENARIO
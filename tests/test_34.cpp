@@ -0,0 +1,164 @@
+/**
+ * @author 964379
+ * @date March, 2020
+ */
+
+// Uses Catch2 from https://github.com/catchorg/Catch2 under the BOOST license
+#include "../catch2/catch.hpp"
+
+#include <cstdlib>
+#include <sstream>
+
+#include "../grid.h"
+#include "../world.h"
+#include "../zoo.h"
+#include "../colour.h"
+
+SCENARIO( "Coloured worlds move their alive cells like a World", "[colour]" ) {
+
+    GIVEN( "a random 100x40 grid" ) {
+
+        Grid g(100, 40);
+        std::srand(5);
+        for (int y = 0; y < g.get_height(); y++) {
+            for (int x = 0; x < g.get_width(); x++) {
+                g.set(x, y, (std::rand() % 3 == 0) ? Cell::ALIVE : Cell::DEAD);
+            }
+        }
+
+        for (int colours : { 2, 4 }) {
+
+            for (bool toroidal : { false, true }) {
+
+                WHEN( "it is coloured with " + std::to_string(colours) + " colours and advanced 30 steps"
+                        + (toroidal ? " on a torus" : "") ) {
+
+                    ColourWorld coloured(g, colours, 1, Rule::parse("B36/S23"));
+                    World w(g);
+                    w.set_rule(Rule::parse("B36/S23"));
+                    coloured.advance(30, toroidal);
+                    w.advance(30, toroidal);
+
+                    THEN( "the alive cells match the world and every alive cell has a colour" ) {
+
+                        REQUIRE(GridView(coloured.get_state()).hash() == w.get_view().hash());
+                        int total = 0;
+                        for (int c = 1; c <= colours; c++) {
+                            total += coloured.get_population(c);
+                        }
+                        REQUIRE(total == coloured.get_alive_cells());
+                        REQUIRE(total == w.get_alive_cells());
+                    }
+                }
+            }
+        }
+    }
+
+} // SCENARIO
+
+SCENARIO( "Births take the majority colour of their parents", "[colour]" ) {
+
+    GIVEN( "an Immigration blinker coloured 1, 1, 2" ) {
+
+        ColourWorld world(5, 5, 2);
+        world.set(2, 1, 1);
+        world.set(2, 2, 1);
+        world.set(2, 3, 2);
+
+        WHEN( "it is stepped" ) {
+
+            world.step();
+
+            THEN( "the centre keeps its colour and both children take colour 1" ) {
+
+                REQUIRE(world.get(1, 2) == 1);
+                REQUIRE(world.get(2, 2) == 1);
+                REQUIRE(world.get(3, 2) == 1);
+                REQUIRE(world.get(2, 1) == 0);
+                REQUIRE(world.get(2, 3) == 0);
+            }
+        }
+    }
+
+    GIVEN( "a QuadLife blinker coloured 1, 3, 3" ) {
+
+        ColourWorld world(5, 5, 4);
+        world.set(2, 1, 1);
+        world.set(2, 2, 3);
+        world.set(2, 3, 3);
+
+        WHEN( "it is stepped" ) {
+
+            world.step();
+
+            THEN( "both children take colour 3" ) {
+
+                REQUIRE(world.get(1, 2) == 3);
+                REQUIRE(world.get(3, 2) == 3);
+                REQUIRE(world.get_population(3) == 3);
+            }
+        }
+    }
+
+    GIVEN( "a QuadLife blinker coloured 1, 2, 3" ) {
+
+        ColourWorld world(5, 5, 4);
+        world.set(2, 1, 1);
+        world.set(2, 2, 2);
+        world.set(2, 3, 3);
+
+        WHEN( "it is stepped" ) {
+
+            world.step();
+
+            THEN( "both children take the fourth colour" ) {
+
+                std::ostringstream stream;
+                stream << world;
+
+                REQUIRE(world.get(1, 2) == 4);
+                REQUIRE(world.get(2, 2) == 2);
+                REQUIRE(world.get(3, 2) == 4);
+                REQUIRE(stream.str() == "+-----+\n|     |\n|     |\n| 424 |\n|     |\n|     |\n+-----+\n");
+            }
+        }
+    }
+
+    GIVEN( "a glider of colour 2 crossing a word boundary on a torus" ) {
+
+        ColourWorld wide(130, 10, 2);
+        for (int y = 0; y < 3; y++) {
+            for (int x = 0; x < 3; x++) {
+                if (Zoo::glider().get(x, y) == Cell::ALIVE) {
+                    wide.set(60 + x, y, 2);
+                }
+            }
+        }
+
+        WHEN( "it is advanced 40 steps" ) {
+
+            wide.advance(40, true);
+
+            THEN( "it is still a glider of colour 2, 10 cells along and wrapped to the top" ) {
+
+                REQUIRE(wide.get_population(2) == 5);
+                REQUIRE(wide.get_population(1) == 0);
+                for (int y = 0; y < 3; y++) {
+                    for (int x = 0; x < 3; x++) {
+                        REQUIRE((wide.get(70 + x, y) == 2) == (Zoo::glider().get(x, y) == Cell::ALIVE));
+                    }
+                }
+            }
+        }
+    }
+
+    GIVEN( "a number of colours other than 2 or 4" ) {
+
+        THEN( "a coloured world cannot be made" ) {
+
+            REQUIRE_THROWS(ColourWorld(4, 4, 3));
+            REQUIRE_THROWS(ColourWorld(4, 4, 2).set(0, 0, 3));
+        }
+    }
+
+} // SCENARIO
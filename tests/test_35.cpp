@@ -0,0 +1,149 @@
+/**
+ * @author 964379
+ * @date March, 2020
+ */
+
+// Uses Catch2 from https://github.com/catchorg/Catch2 under the BOOST license
+#include "../catch2/catch.hpp"
+
+#include <cstdlib>
+
+#include "../grid.h"
+#include "../margolus.h"
+
+SCENARIO( "Block rules map every 2x2 block to its next state", "[margolus]" ) {
+
+    GIVEN( "the named rules" ) {
+
+        THEN( "Critters and the Billiard Ball Machine are reversible, and Tron too" ) {
+
+            REQUIRE(BlockRule::critters().is_reversible());
+            REQUIRE(BlockRule::billiard_ball().is_reversible());
+            REQUIRE(BlockRule::tron().is_reversible());
+            REQUIRE_FALSE(BlockRule(std::vector<int>(16, 0)).is_reversible());
+        }
+
+        THEN( "they can be parsed by name or from a table" ) {
+
+            REQUIRE(BlockRule::parse("BBM").next(1, false) == 8);
+            REQUIRE(BlockRule::parse("critters").next(7, true) == 1);
+            REQUIRE(BlockRule::parse("15,1,2,3,4,5,6,7,8,9,10,11,12,13,14,0").next(0, false) == 15);
+            REQUIRE_THROWS(BlockRule::parse("life"));
+            REQUIRE_THROWS(BlockRule::parse("1,2,3"));
+            REQUIRE_THROWS(BlockRule({ 16, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }));
+        }
+    }
+
+} // SCENARIO
+
+SCENARIO( "Block worlds step alternating partitions of 2x2 blocks", "[margolus]" ) {
+
+    GIVEN( "a lone ball in a 32x32 Billiard Ball Machine" ) {
+
+        BlockWorld world(32, 32, BlockRule::billiard_ball());
+        world.set(4, 4, Cell::ALIVE);
+
+        WHEN( "it is advanced 10 steps" ) {
+
+            world.advance(10, true);
+
+            THEN( "it has flown 10 cells diagonally" ) {
+
+                REQUIRE(world.get_alive_cells() == 1);
+                REQUIRE(world.get(14, 14) == Cell::ALIVE);
+                REQUIRE(world.get_generation() == 10);
+            }
+        }
+
+        WHEN( "it is advanced 32 steps on a torus" ) {
+
+            world.advance(32, true);
+
+            THEN( "it has wrapped around to where it started" ) {
+
+                REQUIRE(world.get_alive_cells() == 1);
+                REQUIRE(world.get(4, 4) == Cell::ALIVE);
+            }
+        }
+    }
+
+    GIVEN( "an empty Critters world" ) {
+
+        BlockWorld world(8, 8, BlockRule::critters());
+
+        THEN( "the vacuum flickers between empty and full" ) {
+
+            world.step(true);
+            REQUIRE(world.get_alive_cells() == 64);
+            world.step(true);
+            REQUIRE(world.get_alive_cells() == 0);
+        }
+    }
+
+    GIVEN( "random grids wider than a word" ) {
+
+        std::srand(17);
+        const int sizes[][2] = { { 130, 10 }, { 64, 4 }, { 2, 2 }, { 66, 6 } };
+        std::vector<int> table(16);
+        for (int &next : table) {
+            next = std::rand() % 16;
+        }
+        const BlockRule rules[] = { BlockRule::critters(), BlockRule(table) };
+
+        for (const int *size : sizes) {
+
+            const int width = size[0], height = size[1];
+            Grid g(width, height);
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    g.set(x, y, (std::rand() % 2) ? Cell::ALIVE : Cell::DEAD);
+                }
+            }
+
+            for (const BlockRule &rule : rules) {
+
+                for (bool toroidal : { false, true }) {
+
+                    THEN( "6 steps match replacing one block at a time" + std::string(toroidal ? " on a torus" : "") ) {
+
+                        BlockWorld world(g, rule);
+                        Grid expected = g;
+                        for (int step = 0; step < 6; step++) {
+                            world.step(toroidal);
+                            const int offset = step % 2;
+                            Grid next = expected;
+                            for (int y = offset; y < height; y += 2) {
+                                for (int x = offset; x < width; x += 2) {
+                                    const int x1 = (x + 1) % width, y1 = (y + 1) % height;
+                                    if (!toroidal && (x + 1 == width || y + 1 == height)) {
+                                        continue;
+                                    }
+                                    const int block = (expected(x, y) == Cell::ALIVE) | (expected(x1, y) == Cell::ALIVE) << 1
+                                            | (expected(x, y1) == Cell::ALIVE) << 2 | (expected(x1, y1) == Cell::ALIVE) << 3;
+                                    const int result = rule.next(block, offset == 1);
+                                    next(x, y) = (result & 1) ? Cell::ALIVE : Cell::DEAD;
+                                    next(x1, y) = (result & 2) ? Cell::ALIVE : Cell::DEAD;
+                                    next(x, y1) = (result & 4) ? Cell::ALIVE : Cell::DEAD;
+                                    next(x1, y1) = (result & 8) ? Cell::ALIVE : Cell::DEAD;
+                                }
+                            }
+                            expected = next;
+
+                            REQUIRE(GridView(world.get_state()).hash() == GridView(expected).hash());
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    GIVEN( "an odd size" ) {
+
+        THEN( "a block world cannot be made" ) {
+
+            REQUIRE_THROWS(BlockWorld(5, 4, BlockRule::tron()));
+            REQUIRE_THROWS(BlockWorld(4, 3, BlockRule::tron()));
+        }
+    }
+
+} // SCENARIO
@@ -0,0 +1,150 @@
+/**
+ * @author 964379
+ * @date March, 2020
+ */
+
+// Uses Catch2 from https://github.com/catchorg/Catch2 under the BOOST license
+#include "../catch2/catch.hpp"
+
+#include "../grid.h"
+#include "../world.h"
+#include "../agar.h"
+
+SCENARIO( "Agar worlds find the period of their tile", "[agar]" ) {
+
+    GIVEN( "zebra stripes, an alive row over a dead row" ) {
+
+        Grid stripes(1, 2);
+        stripes(0, 0) = Cell::ALIVE;
+        AgarWorld agar(stripes);
+
+        THEN( "they are still, and nothing is stored" ) {
+
+            REQUIRE(agar.get_period() == 1);
+            REQUIRE(agar.get_chunks() == 0);
+            REQUIRE(agar.get(-100, 1000) == Cell::ALIVE);
+            REQUIRE(agar.get(-100, 1001) == Cell::DEAD);
+        }
+    }
+
+    GIVEN( "a lattice of blinkers, one in each 5x5 tile" ) {
+
+        Grid blinkers(5, 5);
+        blinkers.set(1, 2, Cell::ALIVE);
+        blinkers.set(2, 2, Cell::ALIVE);
+        blinkers.set(3, 2, Cell::ALIVE);
+        AgarWorld agar(blinkers);
+
+        WHEN( "it is advanced an odd number of steps" ) {
+
+            agar.advance(101);
+
+            THEN( "it has period 2, every blinker is vertical, and nothing is stored" ) {
+
+                REQUIRE(agar.get_period() == 2);
+                REQUIRE(agar.get_chunks() == 0);
+                REQUIRE(agar.get(-3, -4) == Cell::ALIVE);
+                REQUIRE(agar.get(-3, -3) == Cell::ALIVE);
+                REQUIRE(agar.get(-4, -3) == Cell::DEAD);
+            }
+        }
+    }
+
+    GIVEN( "a tile that dies out" ) {
+
+        Grid lonely(3, 3);
+        lonely.set(1, 1, Cell::ALIVE);
+
+        THEN( "it is not an agar" ) {
+
+            REQUIRE_THROWS(AgarWorld(lonely));
+            REQUIRE_THROWS(AgarWorld(Grid()));
+        }
+    }
+
+} // SCENARIO
+
+SCENARIO( "Agar worlds only store and step the perturbed region", "[agar]" ) {
+
+    GIVEN( "zebra stripes perturbed by a few cells, and the same on a large torus" ) {
+
+        Grid stripes(1, 2);
+        stripes(0, 0) = Cell::ALIVE;
+        AgarWorld agar(stripes);
+
+        const int size = 320;
+        Grid plane(size, size);
+        for (int y = 0; y < size; y += 2) {
+            for (int x = 0; x < size; x++) {
+                plane(x, y) = Cell::ALIVE;
+            }
+        }
+        const int points[][2] = { { 150, 150 }, { 151, 151 }, { 160, 151 }, { 171, 153 } };
+        for (const int *point : points) {
+            agar.set(point[0], point[1], Cell::ALIVE);
+            plane(point[0], point[1]) = Cell::ALIVE;
+        }
+        World world(plane);
+
+        THEN( "only the perturbed chunk is stored" ) {
+
+            REQUIRE(agar.get_chunks() == 1);
+            REQUIRE(agar.get_deviations() == 3);
+        }
+
+        WHEN( "both are advanced 60 steps" ) {
+
+            agar.advance(60);
+            world.advance(60, true);
+
+            THEN( "they match, away from the edges of the torus" ) {
+
+                REQUIRE(agar.get_generation() == 60);
+                Grid region = agar.get_region(0, 0, size, size);
+                for (int y = 0; y < size; y++) {
+                    for (int x = 0; x < size; x++) {
+                        REQUIRE(region(x, y) == world.get_view()(x, y));
+                    }
+                }
+                REQUIRE(agar.get_chunks() < 25);
+            }
+        }
+    }
+
+    GIVEN( "a lattice of blinkers with a blinker removed, and the same on a torus" ) {
+
+        Grid blinkers(5, 5);
+        blinkers.set(1, 2, Cell::ALIVE);
+        blinkers.set(2, 2, Cell::ALIVE);
+        blinkers.set(3, 2, Cell::ALIVE);
+        AgarWorld agar(blinkers);
+        agar.merge(Grid(5, 5), -65, -65);
+
+        const int size = 260;
+        Grid plane(size, size);
+        for (int y = 0; y < size; y += 5) {
+            for (int x = 0; x < size; x += 5) {
+                plane.merge(blinkers, x, y);
+            }
+        }
+        plane.merge(Grid(5, 5), 130 - 65, 130 - 65);
+        World world(plane);
+
+        WHEN( "both are advanced 40 steps" ) {
+
+            agar.advance(40);
+            world.advance(40, true);
+
+            THEN( "they match" ) {
+
+                Grid region = agar.get_region(-130, -130, size, size);
+                for (int y = 0; y < size; y++) {
+                    for (int x = 0; x < size; x++) {
+                        REQUIRE(region(x, y) == world.get_view()(x, y));
+                    }
+                }
+            }
+        }
+    }
+
+} // SCENARIO
@@ -0,0 +1,73 @@
+/**
+ * @author 964379
+ * @date March, 2020
+ */
+
+// Uses Catch2 from https://github.com/catchorg/Catch2 under the BOOST license
+#include "../catch2/catch.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include "../grid.h"
+#include "../zoo.h"
+#include "../snapshot.h"
+
+SCENARIO( "snapshots are written exactly as binary files are saved", "[snapshot]" ) {
+
+    auto read_file = [](const std::string &path) {
+        std::ifstream file(path, std::ifstream::binary);
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    };
+
+    GIVEN( "a writer with 4KB buffers, and random grids whose cells do and do not fill whole bytes" ) {
+
+        SnapshotWriter writer(1000);
+        std::srand(124);
+        Grid odd(301, 203), even(16, 16);
+        for (Grid *g : { &odd, &even }) {
+            for (int y = 0; y < g->get_height(); y++) {
+                for (int x = 0; x < g->get_width(); x++) {
+                    g->set(x, y, std::rand() % 3 == 0 ? Cell::ALIVE : Cell::DEAD);
+                }
+            }
+        }
+
+        WHEN( "each is written as a snapshot, spanning several buffers, and saved as a binary file" ) {
+
+            for (Grid *g : { &odd, &even }) {
+                writer.write("../test_outputs/SNAPSHOT.bgol", *g);
+                const std::string snapshot = read_file("../test_outputs/SNAPSHOT.bgol");
+                Grid loaded = Zoo::load_binary("../test_outputs/SNAPSHOT.bgol");
+                Zoo::save_binary("../test_outputs/SNAPSHOT.bgol", *g);
+
+                THEN( "the files are identical, and load back the same cells" ) {
+
+                    REQUIRE(snapshot == read_file("../test_outputs/SNAPSHOT.bgol"));
+                    REQUIRE(GridView(loaded).hash() == GridView(*g).hash());
+                }
+            }
+        }
+
+        WHEN( "a view onto part of a grid is written" ) {
+
+            writer.write("../test_outputs/SNAPSHOT.bgol", odd.crop(3, 5, 103, 55));
+
+            THEN( "only the cells of the view are written" ) {
+
+                REQUIRE(GridView(Zoo::load_binary("../test_outputs/SNAPSHOT.bgol")).hash()
+                        == odd.crop(3, 5, 103, 55).hash());
+            }
+        }
+
+        WHEN( "the file cannot be opened" ) {
+
+            THEN( "writing throws" ) {
+
+                REQUIRE_THROWS(writer.write("../test_outputs/DOES_NOT_EXIST/SNAPSHOT.bgol", odd));
+            }
+        }
+    }
+
+} // SCENARIO
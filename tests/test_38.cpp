@@ -0,0 +1,135 @@
+/**
+ * @author 964379
+ * @date March, 2020
+ */
+
+// Uses Catch2 from https://github.com/catchorg/Catch2 under the BOOST license
+#include "../catch2/catch.hpp"
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+#include "../grid.h"
+#include "../archive.h"
+
+SCENARIO( "snapshots are stored as deduplicated tiles and read back exactly", "[archive]" ) {
+
+    auto same = [](const Grid &a, const Grid &b) {
+        if (a.get_width() != b.get_width() || a.get_height() != b.get_height()) {
+            return false;
+        }
+        for (int y = 0; y < a.get_height(); y++) {
+            for (int x = 0; x < a.get_width(); x++) {
+                if (a.get(x, y) != b.get(x, y)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+
+    GIVEN( "an emptied archive, and a sparse random grid whose size is not a whole number of tiles" ) {
+
+        const std::string directory = "../test_outputs/ARCHIVE";
+        {
+            TileArchive archive(directory);
+            for (const std::string &name : archive.list()) {
+                archive.remove(name);
+            }
+            archive.compact();
+        }
+        TileArchive archive(directory);
+        std::srand(125);
+        Grid grid(300, 200);
+        for (int y = 0; y < 200; y++) {
+            for (int x = 0; x < 150; x++) {
+                grid.set(x, y, std::rand() % 3 == 0 ? Cell::ALIVE : Cell::DEAD);
+            }
+        }
+
+        THEN( "the archive starts empty" ) {
+            REQUIRE( archive.list().empty() );
+            REQUIRE( archive.get_statistics().tiles == 0 );
+            REQUIRE( archive.get_statistics().bytes == 0 );
+        }
+
+        WHEN( "the grid is stored" ) {
+
+            const std::size_t novel = archive.put("gen0", grid);
+
+            THEN( "only the tiles holding live cells are written, and it reads back exactly" ) {
+                // 5 x 4 tiles, of which the 3 left columns hold live cells
+                REQUIRE( novel == 12 );
+                REQUIRE( archive.get_statistics().tiles == 12 );
+                REQUIRE( archive.contains("gen0") );
+                REQUIRE( !archive.contains("gen1") );
+                REQUIRE( same(archive.get("gen0"), grid) );
+            }
+
+            AND_WHEN( "a grid differing in one cell is stored under another name" ) {
+
+                Grid next = grid;
+                next.set(10, 10, next.get(10, 10) == Cell::ALIVE ? Cell::DEAD : Cell::ALIVE);
+                const std::size_t changed = archive.put("gen1", next);
+
+                THEN( "only the changed tile is written, and both read back exactly" ) {
+                    REQUIRE( changed == 1 );
+                    REQUIRE( archive.get_statistics().tiles == 13 );
+                    REQUIRE( archive.list() == std::vector<std::string>({ "gen0", "gen1" }) );
+                    REQUIRE( same(archive.get("gen0"), grid) );
+                    REQUIRE( same(archive.get("gen1"), next) );
+                }
+
+                AND_WHEN( "the first is removed and the archive compacted" ) {
+
+                    archive.remove("gen0");
+                    REQUIRE( archive.get_statistics().free == 1 );
+                    const std::size_t reclaimed = archive.compact();
+
+                    THEN( "its tile is reclaimed and the second still reads back exactly, also once reopened" ) {
+                        REQUIRE( reclaimed == 1 );
+                        REQUIRE( archive.list() == std::vector<std::string>({ "gen1" }) );
+                        REQUIRE( archive.get_statistics().tiles == 12 );
+                        REQUIRE( archive.get_statistics().free == 0 );
+                        REQUIRE( archive.get_statistics().bytes == 12 * 64 * 8 );
+                        REQUIRE( same(archive.get("gen1"), next) );
+                        TileArchive reopened(directory);
+                        REQUIRE( reopened.get_statistics().tiles == 12 );
+                        REQUIRE( same(reopened.get("gen1"), next) );
+                    }
+                }
+            }
+
+            AND_WHEN( "the same name is stored again with a shifted grid" ) {
+
+                Grid shifted = grid;
+                shifted.shift(1, 0);
+                archive.put("gen0", shifted);
+
+                THEN( "the old tiles are released for reuse and the new grid reads back" ) {
+                    REQUIRE( archive.list() == std::vector<std::string>({ "gen0" }) );
+                    REQUIRE( archive.get_statistics().free > 0 );
+                    REQUIRE( same(archive.get("gen0"), shifted) );
+                }
+            }
+
+            AND_WHEN( "the archive is reopened" ) {
+
+                TileArchive reopened(directory);
+
+                THEN( "storing the grid again writes no tiles" ) {
+                    REQUIRE( reopened.put("copy", grid) == 0 );
+                    REQUIRE( same(reopened.get("copy"), grid) );
+                }
+            }
+        }
+
+        THEN( "invalid names and missing snapshots are rejected" ) {
+            REQUIRE_THROWS_AS( archive.put("../escape", grid), std::runtime_error );
+            REQUIRE_THROWS_AS( archive.put("", grid), std::runtime_error );
+            REQUIRE_THROWS_AS( archive.get("missing"), std::runtime_error );
+            REQUIRE_THROWS_AS( archive.remove("missing"), std::runtime_error );
+        }
+    }
+} // SCENARIO
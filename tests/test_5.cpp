@@ -137,4 +137,173 @@ SCENARIO( "grids can be merged from existing grids", "[grid][merge]" ) {
 
     } // GIVEN
     
-} // SCENARIO
\ No newline at end of file
+} // SCENARIO
+SCENARIO( "grids can be shifted and rolled in place", "[grid][shift]" ) {
+
+    GIVEN( "a 5x4 grid with a cell alive in each corner and one in the middle" ) {
+
+        Grid w(5, 4);
+        w.set(0, 0, Cell::ALIVE);
+        w.set(4, 0, Cell::ALIVE);
+        w.set(0, 3, Cell::ALIVE);
+        w.set(4, 3, Cell::ALIVE);
+        w.set(2, 1, Cell::ALIVE);
+
+        WHEN( "it is shifted right 1 and down 2" ) {
+
+            w.shift(1, 2);
+
+            THEN( "the cells moved past the edges are lost and the rest have moved" ) {
+
+                REQUIRE( w.get_alive_cells() == 2 );
+                REQUIRE( w.get(1, 2) == Cell::ALIVE );
+                REQUIRE( w.get(3, 3) == Cell::ALIVE );
+            }
+        }
+
+        WHEN( "it is shifted left 2 and up 1" ) {
+
+            w.shift(-2, -1);
+
+            THEN( "the cells moved past the edges are lost and the rest have moved" ) {
+
+                REQUIRE( w.get_alive_cells() == 2 );
+                REQUIRE( w.get(0, 0) == Cell::ALIVE );
+                REQUIRE( w.get(2, 2) == Cell::ALIVE );
+            }
+        }
+
+        WHEN( "it is shifted by its width" ) {
+
+            w.shift(5, 0);
+
+            THEN( "it is cleared" ) {
+
+                REQUIRE( w.get_alive_cells() == 0 );
+            }
+        }
+
+        WHEN( "it is rolled right 1 and up 1" ) {
+
+            w.roll(1, -1);
+
+            THEN( "no cells are lost, the corners wrap around" ) {
+
+                REQUIRE( w.get_alive_cells() == 5 );
+                REQUIRE( w.get(0, 3) == Cell::ALIVE );
+                REQUIRE( w.get(1, 3) == Cell::ALIVE );
+                REQUIRE( w.get(0, 2) == Cell::ALIVE );
+                REQUIRE( w.get(1, 2) == Cell::ALIVE );
+                REQUIRE( w.get(3, 0) == Cell::ALIVE );
+            }
+        }
+
+        WHEN( "it is rolled by a multiple of its size, or back and forth" ) {
+
+            Grid copy = w;
+            w.roll(-10, 8);
+            REQUIRE( GridView(w).hash() == GridView(copy).hash() );
+            w.roll(3, 1);
+            w.roll(-3, -1);
+
+            THEN( "it is unchanged" ) {
+
+                REQUIRE( GridView(w).hash() == GridView(copy).hash() );
+            }
+        }
+    }
+
+} // SCENARIO
+
+SCENARIO( "grids can be scaled up and down by whole factors", "[grid][scale]" ) {
+
+    GIVEN( "a 3x2 grid with a diagonal of alive cells" ) {
+
+        Grid w(3, 2);
+        w.set(0, 0, Cell::ALIVE);
+        w.set(1, 1, Cell::ALIVE);
+
+        WHEN( "it is scaled up by 3" ) {
+
+            Grid up = w.upscale(3);
+
+            THEN( "every cell is a 3x3 block" ) {
+
+                REQUIRE( up.get_width() == 9 );
+                REQUIRE( up.get_height() == 6 );
+                REQUIRE( up.get_alive_cells() == 18 );
+                REQUIRE( up.get(2, 2) == Cell::ALIVE );
+                REQUIRE( up.get(3, 2) == Cell::DEAD );
+                REQUIRE( up.get(5, 5) == Cell::ALIVE );
+                REQUIRE( up.get(6, 5) == Cell::DEAD );
+            }
+
+            THEN( "scaling it back down restores it in every mode" ) {
+
+                REQUIRE( GridView(up.downscale(3)).hash() == GridView(w).hash() );
+                REQUIRE( GridView(up.downscale(3, Reduce::MAJORITY)).hash() == GridView(w).hash() );
+                REQUIRE( GridView(up.downscale(3, Reduce::ALL)).hash() == GridView(w).hash() );
+            }
+        }
+
+        WHEN( "it is scaled up by 1" ) {
+
+            THEN( "it is unchanged" ) {
+
+                REQUIRE( GridView(w.upscale(1)).hash() == GridView(w).hash() );
+                REQUIRE( GridView(w.downscale(1)).hash() == GridView(w).hash() );
+            }
+        }
+
+        WHEN( "it is scaled down by 2" ) {
+
+            THEN( "the blocks are rounded up, and reduced over the cells they have" ) {
+
+                Grid any = w.downscale(2), most = w.downscale(2, Reduce::MAJORITY), all = w.downscale(2, Reduce::ALL);
+                REQUIRE( any.get_width() == 2 );
+                REQUIRE( any.get_height() == 1 );
+                REQUIRE( any.get(0, 0) == Cell::ALIVE );
+                REQUIRE( any.get(1, 0) == Cell::DEAD );
+                REQUIRE( most.get(0, 0) == Cell::DEAD );
+                REQUIRE( all.get(0, 0) == Cell::DEAD );
+            }
+        }
+
+        WHEN( "the factor is not positive" ) {
+
+            THEN( "scaling throws" ) {
+
+                REQUIRE_THROWS( w.upscale(0) );
+                REQUIRE_THROWS( w.downscale(-1) );
+            }
+        }
+    }
+
+    GIVEN( "a partial block on the edge of a grid" ) {
+
+        Grid w(5, 1);
+        w.set(4, 0, Cell::ALIVE);
+
+        THEN( "it is alive in every mode when all of its cells are" ) {
+
+            REQUIRE( w.downscale(2, Reduce::ALL).get(2, 0) == Cell::ALIVE );
+            REQUIRE( w.downscale(2, Reduce::MAJORITY).get(2, 0) == Cell::ALIVE );
+            REQUIRE( w.downscale(2, Reduce::ALL).get(1, 0) == Cell::DEAD );
+        }
+    }
+
+    GIVEN( "grids with no columns or no rows" ) {
+
+        Grid no_columns(0, 3), no_rows(4, 0);
+
+        THEN( "they scale to empty grids of the scaled size" ) {
+
+            Grid narrow = GridView(no_columns).upscale(2), flat = GridView(no_rows).upscale(2);
+            REQUIRE( narrow.get_width() == 0 );
+            REQUIRE( narrow.get_height() == 6 );
+            REQUIRE( flat.get_width() == 8 );
+            REQUIRE( flat.get_height() == 0 );
+        }
+    }
+
+} // SCENARIO
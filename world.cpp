@@ -11,18 +11,49 @@
  *      - Stepping a world forward in time applies the rules of Conway's Game of Life.
  *          - https://en.wikipedia.org/wiki/Conway%27s_Game_of_Life
  *
- *      - Worlds have a private helper function used to count the number of alive cells in a 3x3 neighbours
- *        around a given cell.
+ *      - Worlds step 64 cells at a time, bit-parallel.
+ *          - Each row is packed into words, one cell per bit, and the neighbour counts of a word of cells are
+ *            added as bit planes with Bits::neighbour_sum.
+ *          - The rule is compiled to a circuit of bitwise operations over the planes with Bits::compile,
+ *            so any rule entered at runtime steps at nearly the speed of one written out by hand.
  *
  *      - Updating the world state can conditionally be performed using a toroidal topology.
  *          - Moving off the left edge you appear on the right edge and vice versa.
  *          - Moving off the top edge you appear on the bottom edge and vice versa.
  *
+ *      - Worlds can be stepped with any B/S Rule, not only Conway's B3/S23.
+ *          - The generic step evaluates the circuit compiled from the rule.
+ *          - Optionally a kernel specialised to the rule is compiled and loaded at runtime by the Jit namespace,
+ *            falling back to the generic step if no compiler is available.
+ *
+ *      - Worlds can hold masks of cells forced dead and cells forced alive, for walls and permanent sources.
+ *          - Masks are packed like the cells, and applied to each word as it is stepped with one AND NOT
+ *            and one OR, rather than patching the grid after every step.
+ *          - Forcing alive wins over forcing dead, and masks are dropped when the world changes size.
+ *
+ *      - Worlds can keep a pyramid of the populations of square blocks, like the mipmaps of a texture,
+ *        so a viewer zoomed out over a huge world reads one count per pixel instead of counting cells.
+ *          - The finest level counts 8x8 blocks, and each level up counts blocks twice the size, until one
+ *            block covers the world.
+ *          - The step already has every word before and after, so only words that changed are counted again,
+ *            byte by byte, and only the blocks that changed are carried up the levels.
+ *          - Specialised kernels step the raw cells, so a world with a pyramid always uses the generic step.
+ *
+ *      - Worlds can be inhomogeneous, with a rule map giving each square tile of cells a rule of its own.
+ *          - Every rule of the map is compiled to its own circuit.
+ *          - Neighbour sums are computed once from the whole plane, so the halo of a tile is simply
+ *            the cells of its neighbouring tiles, whatever rule they follow.
+ *          - Each word of a row is split by the tiles it crosses when the map is set, so a word inside
+ *            a single tile evaluates one circuit, just as without a map, and a word across tiles evaluates
+ *            the circuit of each and keeps the cells each tile covers.
+ *
  * @author 964379
  * @date March, 2020
  */
 #include "world.h"
+#include <algorithm>
 #include <stdexcept>
+#include <string>
 
 // Include the minimal number of headers needed to support your implementation.
 // #include ...
@@ -85,6 +116,7 @@ World::World(int square_size) :
  */
 World::World(int width, int height) :
 		current(width, height), future(width, height) {
+	set_rule(rule);
 }
 
 /**
@@ -109,6 +141,7 @@ World::World(int width, int height) :
 World::World(Grid initial_state) :
 		future(initial_state.get_width(), initial_state.get_height()) {
 	current = initial_state;
+	set_rule(rule);
 }
 
 /**
@@ -198,6 +231,8 @@ int World::get_total_cells() const {
  *
  * Counts how many cells in the world are alive.
  * The function should be callable from a constant context.
+ * If the population pyramid is kept its coarsest level is a single block of the whole world, which is read
+ * instead of scanning every cell.
  *
  * @example
  *
@@ -217,6 +252,9 @@ int World::get_total_cells() const {
  *      The number of alive cells.
  */
 int World::get_alive_cells() const {
+	if (!pyramid.empty()) {
+		return pyramid.back().counts[0];
+	}
 	return current.get_alive_cells();
 }
 
@@ -275,6 +313,80 @@ Grid World::get_state() const {
 	return current;
 }
 
+/**
+ * World::get_view()
+ *
+ * Return a read-only view of the current state without copying it.
+ * The view is invalidated by the next call to World::step, World::resize, or World::set_state.
+ *
+ * @example
+ *
+ *      // Make a world
+ *      World world(4, 4);
+ *
+ *      // Detect a repeated state without copying the grid
+ *      unsigned long long before = world.get_view().hash();
+ *      world.step();
+ *      bool still_life = world.get_view().hash() == before;
+ *
+ * @return
+ *      A view of the current state.
+ */
+GridView World::get_view() const {
+	return current;
+}
+
+/**
+ * World::set_state(state)
+ *
+ * Replace the current state with a copy of the given cells, resizing the world to match.
+ * The rule is kept and the storage of both buffers is reused where possible, so a single world
+ * can be recycled across many unrelated patterns without reallocating.
+ * Masks are kept if the size is unchanged, and force the new cells straight away, otherwise they are cleared.
+ *
+ * @example
+ *
+ *      // Make one world and reuse it
+ *      World world;
+ *
+ *      world.set_state(Zoo::glider());
+ *      world.advance(4);
+ *
+ *      world.set_state(Zoo::r_pentomino());
+ *      world.advance(4);
+ *
+ * @param state
+ *      The cells of the new current state.
+ */
+void World::set_state(GridView state) {
+	if (state.get_width() != current.get_width() || state.get_height() != current.get_height()) {
+		clear_masks();
+	}
+	current.assign(state);
+	future.assign(state);
+	//Force the new cells just as setting a mask does, forcing alive last so it wins.
+	if (!force_dead.bits.empty() || !force_alive.bits.empty()) {
+		const int width = current.get_width();
+		for (int y = 0; y < current.get_height(); y++) {
+			Cell *row = current.data() + (std::size_t) y * width;
+			for (int k = 0; k * 64 < width; k++) {
+				const int count = std::min(64, width - k * 64);
+				Word cells = Bits::pack_row(row + k * 64, count);
+				if (!force_dead.bits.empty()) {
+					cells &= ~force_dead.row(y)[k];
+				}
+				if (!force_alive.bits.empty()) {
+					cells |= force_alive.row(y)[k];
+				}
+				Bits::unpack_row(cells, row + k * 64, count);
+			}
+		}
+	}
+	if (!pyramid.empty()) {
+		build_pyramid();
+	}
+}
+
 /**
  * World::resize(square_size)
  *
@@ -295,7 +407,7 @@ Grid World::get_state() const {
  *      The new edge size for both the width and height of the grid.
  */
 void World::resize(int square_size) {
-	current.resize(square_size);
+	resize(square_size, square_size);
 }
 
 /**
@@ -321,109 +433,481 @@ void World::resize(int square_size) {
  *      The new height for the grid.
  */
 void World::resize(int new_width, int new_height) {
+	if (new_width != current.get_width() || new_height != current.get_height()) {
+		clear_masks();
+	}
 	current.resize(new_width, new_height);
+	//Kernels write the next state straight into the future buffer, so it must always match in size.
+	future.resize(new_width, new_height);
+	if (!pyramid.empty()) {
+		build_pyramid();
+	}
 }
 
 /**
- * World::count_neighbours(x, y, toroidal)
+ * World::get_rule()
  *
- * Private helper function to count the number of alive neighbours of a cell.
- * The function should not be visible from outside the World class.
+ * Gets the rule the world is stepped with.
+ * The function should be callable from a constant context.
  *
- * Neighbours are considered within the 3x3 square centred around the cell at x,y in the current state grid.
- * Ignore the centre coordinate, a cell is not its own neighbour.
- * Attempt to keep the logic as simple, expressive, and readable as possible.
+ * @example
  *
- * If toroidal = false then skip any neighbours that would be outside of the grid,
- * this assumes the grid is Cell::DEAD outside its bounds.
+ *      // Make a world
+ *      World world(4, 4);
+ *
+ *      // Prints B3/S23
+ *      std::cout << world.get_rule().to_string() << std::endl;
+ *
+ * @return
+ *      A read-only reference to the rule.
+ */
+const Rule& World::get_rule() const {
+	return rule;
+}
+
+/**
+ * World::set_rule(new_rule, specialise)
+ *
+ * Change the rule the world is stepped with.
+ *
+ * If specialise = true then a step kernel specialised to the rule is compiled (or fetched from the on disc cache)
+ * and loaded with Jit::load_kernel. If that fails the world silently falls back to the generic step,
+ * which can be checked with World::is_specialised().
+ *
+ * @example
+ *
+ *      // Make a world
+ *      World world(64, 64);
  *
- * If toroidal = true then correctly wrap out of bounds coordinates to the opposite side of the grid.
+ *      // Step the world with HighLife using a specialised kernel if possible
+ *      world.set_rule(Rule::parse("B36/S23"), true);
  *
- * This function is in World and not Grid because the 3x3 sized neighbourhood is specific to Conway's Game of Life,
- * while Grid is more generic to any 2D grid based cellular automaton.
+ * @param new_rule
+ *      The rule to step the world with.
+ *
+ * @param specialise
+ *      Optional parameter. If true then try to compile a specialised kernel for the rule. Defaults to false.
+ */
+void World::set_rule(const Rule &new_rule, bool specialise) {
+	rule = new_rule;
+	circuits.assign(1, Bits::compile(rule));
+	map_rules.clear();
+	rule_map.clear();
+	segments.clear();
+	kernel = specialise ? Jit::load_kernel(rule) : nullptr;
+}
+
+/**
+ * World::set_rule_map(rules, map, across, size)
+ *
+ * Give square tiles of the world rules of their own, an inhomogeneous cellular automaton.
+ * Tiles run from the top left corner of the world, and cells outside the map follow the rule set with
+ * World::set_rule, so the map may be smaller than the world and survives resizing.
+ * Specialised kernels work on the whole world, so a world with a rule map always uses the compiled circuits.
+ * The map is cleared by World::set_rule.
+ *
+ * @example
+ *
+ *      // Make a world that is Life on the left and HighLife on the right, in 32x32 tiles
+ *      World world(128, 64);
+ *      world.set_rule_map({ Rule(), Rule::parse("B36/S23") }, { 0, 0, 1, 1, 0, 0, 1, 1 }, 4, 32);
+ *
+ * @param rules
+ *      The rules of the map.
+ *
+ * @param map
+ *      The index into rules of every tile, a row of tiles at a time.
+ *
+ * @param across
+ *      The number of tiles in each row of the map.
+ *
+ * @param size
+ *      The width and height of every tile, in cells.
+ *
+ * @throws
+ *      Throws std::runtime_error if the map is not a whole number of rows, or a tile has no rule.
+ */
+void World::set_rule_map(const std::vector<Rule> &rules, const std::vector<int> &map, int across, int size) {
+	if (size <= 0 || across <= 0 || map.size() % across != 0) {
+		throw std::runtime_error("A rule map must be a whole number of rows of tiles of a positive size.");
+	}
+	for (int index : map) {
+		if (index < 0 || index >= (int) rules.size()) {
+			throw std::runtime_error("A tile of the rule map has no rule.");
+		}
+	}
+	circuits.resize(1);
+	for (const Rule &tile_rule : rules) {
+		circuits.push_back(Bits::compile(tile_rule));
+	}
+	map_rules = rules;
+	rule_map.clear();
+	for (int index : map) {
+		rule_map.push_back(index + 1);
+	}
+	tiles_across = across;
+	tiles_down = map.size() / across;
+	tile_size = size;
+	segments_width = segments_height = -1;
+	kernel = nullptr;
+}
+
+/**
+ * World::has_rule_map()
+ *
+ * Checks if tiles of the world follow rules of their own.
+ */
+bool World::has_rule_map() const {
+	return !rule_map.empty();
+}
+
+/**
+ * World::get_rule(x, y)
+ *
+ * Gets the rule a cell follows, from the rule map if it is covered by one.
  *
  * @param x
- *      The x coordinate of the centre of the neighbourhood.
+ *      The x coordinate of the cell.
  *
  * @param y
- *      The y coordinate of the centre of the neighbourhood.
- *
- * @param toroidal
- *      If true then the step will consider the grid as a torus, where the left edge
- *      wraps to the right edge and the top to the bottom.
+ *      The y coordinate of the cell.
  *
  * @return
- *      Returns the number of alive neighbours.
- */
-int World::count_neighbours(int x, int y, bool toroidal) {
-	int count = 0;
-	//If it is not toroidal check the ALIVE cells(neightbours) around the required cell,
-	//only if they are innside the bounds of the grid.
-	if (!toroidal) {
-		for (int i = -1; i < 2; ++i) {
-			for (int j = -1; j < 2; ++j) {
-				//Ignore the cell in the middle.
-				if ((i != 0) || (j != 0)) {
-					if (x + i >= 0 && x + i < current.get_height() && y + j >= 0
-							&& y + j < current.get_width()) {
-						if (current.get(x + i, y + j) == Cell::ALIVE) {
-							count++;
-						}
-					}
-				}
+ *      A read-only reference to the rule.
+ */
+const Rule& World::get_rule(int x, int y) const {
+	const int index = get_rule_index(x, y);
+	return index == 0 ? rule : map_rules[index - 1];
+}
+
+/**
+ * World::set_force_dead(mask)
+ *
+ * Force cells dead after every step, such as the cells of a wall. The cells are killed straight away too.
+ *
+ * @example
+ *
+ *      // Wall off the middle column of a world
+ *      World world(64, 64);
+ *      Grid wall(64, 64);
+ *      for (int y = 0; y < 64; y++) {
+ *          wall(32, y) = Cell::ALIVE;
+ *      }
+ *      world.set_force_dead(wall);
+ *
+ * @param mask
+ *      The cells to force dead are Cell::ALIVE in the mask, or an empty view to stop forcing cells dead.
+ *
+ * @throws
+ *      Throws std::runtime_error if the mask is not empty and not the size of the world.
+ */
+void World::set_force_dead(GridView mask) {
+	set_mask(force_dead, mask, Cell::DEAD);
+}
+
+/**
+ * World::set_force_alive(mask)
+ *
+ * Force cells alive after every step, such as permanent sources. The cells are made alive straight away too.
+ * Forcing a cell alive wins over forcing it dead.
+ *
+ * @example
+ *
+ *      // Keep a block alive in the corner of a world
+ *      World world(64, 64);
+ *      Grid source(64, 64);
+ *      source(0, 0) = source(1, 0) = source(0, 1) = source(1, 1) = Cell::ALIVE;
+ *      world.set_force_alive(source);
+ *
+ * @param mask
+ *      The cells to force alive are Cell::ALIVE in the mask, or an empty view to stop forcing cells alive.
+ *
+ * @throws
+ *      Throws std::runtime_error if the mask is not empty and not the size of the world.
+ */
+void World::set_force_alive(GridView mask) {
+	set_mask(force_alive, mask, Cell::ALIVE);
+}
+
+/**
+ * World::clear_masks()
+ *
+ * Stop forcing any cells dead or alive.
+ */
+void World::clear_masks() {
+	force_dead = Bits::Plane();
+	force_alive = Bits::Plane();
+}
+
+/**
+ * World::set_mask(mask, cells, forced)
+ *
+ * Private helper to pack a mask, and force its cells in the current state.
+ */
+void World::set_mask(Bits::Plane &mask, GridView cells, Cell forced) {
+	const int width = current.get_width(), height = current.get_height();
+	if (cells.get_width() == 0 && cells.get_height() == 0) {
+		mask = Bits::Plane();
+		return;
+	}
+	if (cells.get_width() != width || cells.get_height() != height) {
+		throw std::runtime_error("A mask must be the same size as the world.");
+	}
+	mask = Bits::Plane(width, height);
+	for (int y = 0; y < height; y++) {
+		for (int k = 0; k < mask.words; k++) {
+			mask.row(y)[k] = Bits::pack_row(cells.row(y) + k * 64, std::min(64, width - k * 64));
+		}
+		for (int x = 0; x < width; x++) {
+			if (cells(x, y) == Cell::ALIVE) {
+				current(x, y) = forced;
 			}
 		}
-	} else {
-		//If it is toroidal for neightbours inside the bounds of the grid repeat the process above.
-		//Othewise, reset the neighbour width or height coordinates dependign on which of those 2
-		//exit the bounds and on which side. Having 2 variables (width and height) and 2 directions
-		//for each where they can have indexes out of bounds (left,right,up,down), results in 4 cases
-		//the 4 if instruction from bellow and a check in the end for the correct neighbour cell.
-		for (int i = -1; i < 2; ++i) {
-			for (int j = -1; j < 2; ++j) {
-				//Ignore the cell in the middle.
-				if ((i != 0) || (j != 0)) {
-					if (x + i >= 0 && x + i < current.get_height() && y + j >= 0
-							&& y + j < current.get_width()) {
-						if (current.get(x + i, y + j) == Cell::ALIVE) {
-							count++;
-						}
-					} else {
-						int tempWidth = 0, tempHeight = 0;
-						if (x + i < 0) {
-							tempWidth = current.get_width();
-						}
-						if (x + i >= current.get_width()) {
-							tempWidth = -current.get_width();
-						}
-						if (y + j < 0) {
-							tempHeight = current.get_height();
-						}
-						if (y + j >= current.get_height()) {
-							tempHeight = -current.get_height();
-						}
-						if (current.get(x + i + tempWidth, y + j + tempHeight)
-								== Cell::ALIVE) {
-							count++;
-						}
-					}
+	}
+	//Forcing alive wins, so forcing cells dead must not kill cells that are forced alive.
+	if (forced == Cell::DEAD && !force_alive.bits.empty()) {
+		for (int y = 0; y < height; y++) {
+			for (int x = 0; x < width; x++) {
+				if ((force_alive.row(y)[x / 64] >> (x % 64)) & 1) {
+					current(x, y) = Cell::ALIVE;
 				}
 			}
 		}
 	}
-	return count;
+	if (!pyramid.empty()) {
+		build_pyramid();
+	}
+}
+
+/**
+ * World::get_rule_index(x, y)
+ *
+ * Private helper to get the index into circuits of the rule a cell follows.
+ */
+int World::get_rule_index(int x, int y) const {
+	if (rule_map.empty() || x < 0 || y < 0) {
+		return 0;
+	}
+	const int tile_x = x / tile_size, tile_y = y / tile_size;
+	return tile_x < tiles_across && tile_y < tiles_down ? rule_map[tile_y * tiles_across + tile_x] : 0;
+}
+
+/**
+ * World::build_segments()
+ *
+ * Private helper to split every word of every row of tiles by the rules of the tiles it crosses.
+ */
+void World::build_segments() {
+	const int width = current.get_width(), height = current.get_height();
+	const int words = (width + 63) / 64, rows = (height + tile_size - 1) / tile_size;
+	segments.assign((std::size_t) rows * words, std::vector<std::pair<int, Word>>());
+	for (int row = 0; row < rows; row++) {
+		for (int x = 0; x < width; x++) {
+			std::vector<std::pair<int, Word>> &parts = segments[(std::size_t) row * words + x / 64];
+			const int index = get_rule_index(x, row * tile_size);
+			const Word bit = 1ull << (x % 64);
+			if (!parts.empty() && parts.back().first == index) {
+				parts.back().second |= bit;
+				continue;
+			}
+			auto found = std::find_if(parts.begin(), parts.end(), [index](const std::pair<int, Word> &part) {
+				return part.first == index;
+			});
+			if (found != parts.end()) {
+				found->second |= bit;
+			} else {
+				parts.push_back(std::make_pair(index, bit));
+			}
+		}
+	}
+	segments_width = width;
+	segments_height = height;
+}
 
+/**
+ * World::is_specialised()
+ *
+ * Checks if the world is stepped by a specialised kernel rather than the generic step.
+ * Kernels step the raw cells with nothing fused in, so a world with masks always uses the generic step.
+ *
+ * @return
+ *      Returns true if a specialised kernel is in use.
+ */
+bool World::is_specialised() const {
+	return kernel != nullptr && force_dead.bits.empty() && force_alive.bits.empty() && pyramid.empty();
+}
+
+/**
+ * World::set_pyramid(enabled)
+ *
+ * Start or stop keeping a pyramid of block populations up to date.
+ * Starting counts every block once, after that each step only counts the words that changed.
+ *
+ * @example
+ *
+ *      // Keep a pyramid of a large world
+ *      World world(4096, 4096);
+ *      world.set_pyramid(true);
+ *      world.step();
+ *
+ *      // Draw one pixel per 64x64 block
+ *      const World::Level &level = world.get_pyramid_level(3);
+ *      for (int y = 0; y < level.down; y++) {
+ *          for (int x = 0; x < level.across; x++) {
+ *              draw(x, y, level.counts[y * level.across + x] / (64.0 * 64.0));
+ *          }
+ *      }
+ *
+ * @param enabled
+ *      True to keep a pyramid, false to drop it.
+ */
+void World::set_pyramid(bool enabled) {
+	if (!enabled) {
+		pyramid.clear();
+		pending.clear();
+		changed.clear();
+	} else if (pyramid.empty()) {
+		build_pyramid();
+	}
+}
+
+/**
+ * World::has_pyramid()
+ *
+ * Checks if a pyramid of block populations is being kept.
+ */
+bool World::has_pyramid() const {
+	return !pyramid.empty();
+}
+
+/**
+ * World::get_pyramid_levels()
+ *
+ * Gets the number of levels of the pyramid, the last being a single block covering the world, or 0 if none is kept.
+ */
+int World::get_pyramid_levels() const {
+	return pyramid.size();
+}
+
+/**
+ * World::get_pyramid_level(level)
+ *
+ * Gets a level of the pyramid of block populations.
+ *
+ * @param level
+ *      The level, 0 for blocks of PYRAMID_BLOCK x PYRAMID_BLOCK cells, each level up doubling the block.
+ *
+ * @return
+ *      A read-only reference to the level, valid until the pyramid is dropped or the world changes size.
+ *
+ * @throws
+ *      Throws std::runtime_error if no pyramid is kept or the level does not exist.
+ */
+const World::Level& World::get_pyramid_level(int level) const {
+	if (level < 0 || level >= (int) pyramid.size()) {
+		throw std::runtime_error("The population pyramid has no level " + std::to_string(level) + ".");
+	}
+	return pyramid[level];
+}
+
+/**
+ * World::build_pyramid()
+ *
+ * Private helper to size the pyramid to the world and count every block from scratch.
+ */
+void World::build_pyramid() {
+	const int width = current.get_width(), height = current.get_height();
+	pyramid.clear();
+	int block = PYRAMID_BLOCK;
+	do {
+		Level level;
+		level.block = block;
+		level.across = std::max(1, (width + block - 1) / block);
+		level.down = std::max(1, (height + block - 1) / block);
+		level.counts.assign((std::size_t) level.across * level.down, 0);
+		pyramid.push_back(level);
+		block *= 2;
+	} while (pyramid.back().across > 1 || pyramid.back().down > 1);
+	Level &finest = pyramid[0];
+	for (int y = 0; y < height; y++) {
+		const Cell *row = current.data() + (std::size_t) y * width;
+		for (int x = 0; x < width; x++) {
+			finest.counts[(y / PYRAMID_BLOCK) * finest.across + x / PYRAMID_BLOCK] += row[x] == Cell::ALIVE;
+		}
+	}
+	for (std::size_t l = 1; l < pyramid.size(); l++) {
+		const Level &child = pyramid[l - 1];
+		Level &parent = pyramid[l];
+		for (int y = 0; y < child.down; y++) {
+			for (int x = 0; x < child.across; x++) {
+				parent.counts[(y / 2) * parent.across + x / 2] += child.counts[y * child.across + x];
+			}
+		}
+	}
+	pending.assign(finest.counts.size(), 0);
+	changed.clear();
+}
+
+/**
+ * World::update_pyramid(y, k, before, after)
+ *
+ * Private helper to count a word of row y that changed into the finest level, byte by byte,
+ * noting the blocks that changed so their change can be carried up by World::propagate_pyramid.
+ */
+void World::update_pyramid(int y, int k, Word before, Word after) {
+	Level &finest = pyramid[0];
+	const Word different = before ^ after;
+	for (int byte = 0; byte < 8; byte++) {
+		if ((different >> (byte * 8)) & 0xFF) {
+			const int delta = __builtin_popcount((after >> (byte * 8)) & 0xFF)
+					- __builtin_popcount((before >> (byte * 8)) & 0xFF);
+			const int index = (y / PYRAMID_BLOCK) * finest.across + k * 8 + byte;
+			finest.counts[index] += delta;
+			if (pending[index] == 0 && delta != 0) {
+				changed.push_back(index);
+			}
+			pending[index] += delta;
+		}
+	}
+}
+
+/**
+ * World::propagate_pyramid()
+ *
+ * Private helper to carry the change of every block of the finest level that changed this step up the levels.
+ * A block may be noted twice if its change came back to 0 and moved again, which is harmless as its change
+ * is cleared once carried.
+ */
+void World::propagate_pyramid() {
+	for (int index : changed) {
+		const int delta = pending[index];
+		if (delta == 0) {
+			continue;
+		}
+		pending[index] = 0;
+		int x = index % pyramid[0].across, y = index / pyramid[0].across;
+		for (std::size_t l = 1; l < pyramid.size(); l++) {
+			x /= 2;
+			y /= 2;
+			pyramid[l].counts[y * pyramid[l].across + x] += delta;
+		}
+	}
+	changed.clear();
 }
 
 /**
  * World::step(toroidal)
  *
- * Take one step in Conway's Game of Life.
+ * Take one step in Conway's Game of Life, or in the rule set with World::set_rule.
  *
  * Reads from the current state grid and writes to the next state grid. Then swaps the grids.
- * Should be implemented by invoking World::count_neighbours(x, y, toroidal).
  * Swapping the grids should be done in O(1) constant time, and should not invoke a copy.
- * Try and boil the logic down to the fewest and most simple conditional statements.
+ * Rows are packed into words and stepped 64 cells at a time by the circuit compiled from the rule,
+ * or by the circuits of the tiles a word crosses if a rule map is set.
+ * Cells forced dead are then cleared from each word and cells forced alive set, before it is unpacked.
+ * If a specialised kernel has been loaded it is invoked on the raw cells instead.
+ *
+ * If toroidal = false then neighbours outside of the grid are Cell::DEAD, otherwise they wrap to the opposite side.
  *
  * Rules: https://en.wikipedia.org/wiki/Conway%27s_Game_of_Life
  *      - Any live cell with fewer than two live neighbours dies, as if by underpopulation.
@@ -436,22 +920,62 @@ int World::count_neighbours(int x, int y, bool toroidal) {
  *      wraps to the right edge and the top to the bottom. Defaults to false.
  */
 void World::step(bool toroidal) {
-	//Depending of the number of cells neighbours, apply the rules of the game
-	//in the future grid, then swap the current and future grid.
-	for (int i = 0; i < current.get_width(); i++) {
-		for (int j = 0; j < current.get_height(); j++) {
-			int neighbours = count_neighbours(i, j, toroidal);
-			if (neighbours < 2 || neighbours > 3) {
-				future(i, j) = Cell::DEAD;
-			} else if (current(i, j) == Cell::DEAD && neighbours == 3) {
-				future(i, j) = Cell::ALIVE;
-			} else if (current(i, j) == Cell::ALIVE
-					&& (neighbours == 3 || neighbours == 2)) {
-				future(i, j) = Cell::ALIVE;
-			} else {
-				future(i, j) = Cell::DEAD;
+	const int width = current.get_width(), height = current.get_height();
+	if (is_specialised()) {
+		kernel(reinterpret_cast<const char*>(current.data()), reinterpret_cast<char*>(future.data()), width, height,
+				toroidal);
+	} else if (width > 0 && height > 0) {
+		//Pack cell x of each row into bit x % 64 of word x / 64, then step a word of cells at a time.
+		const Cell *cells = current.data();
+		Cell *next = future.data();
+		if (packed.width != width || packed.height != height) {
+			packed = Bits::Plane(width, height);
+		}
+		for (int j = 0; j < height; j++) {
+			for (int k = 0; k < packed.words; k++) {
+				packed.row(j)[k] = Bits::pack_row(cells + j * width + k * 64, std::min(64, width - k * 64));
 			}
 		}
+		if (!rule_map.empty() && (segments_width != width || segments_height != height)) {
+			build_segments();
+		}
+		for (int j = 0; j < height; j++) {
+			const std::vector<std::pair<int, Word>> *parts =
+					rule_map.empty() ? nullptr : &segments[(std::size_t) (j / tile_size) * packed.words];
+			for (int k = 0; k < packed.words; k++) {
+				const Word cells = packed.row(j)[k];
+				const Bits::Sum sum = packed.sum(j, k, toroidal);
+				Word next_cells;
+				if (parts == nullptr) {
+					next_cells = Bits::evaluate(circuits[0], cells, sum);
+				} else if (parts[k].size() == 1) {
+					next_cells = Bits::evaluate(circuits[parts[k][0].first], cells, sum);
+				} else {
+					//The word crosses tiles of different rules, keep the cells of each from its own circuit.
+					next_cells = 0;
+					for (const std::pair<int, Word> &part : parts[k]) {
+						next_cells |= Bits::evaluate(circuits[part.first], cells, sum) & part.second;
+					}
+				}
+				if (!force_dead.bits.empty()) {
+					next_cells &= ~force_dead.row(j)[k];
+				}
+				if (!force_alive.bits.empty()) {
+					next_cells |= force_alive.row(j)[k];
+				}
+				if (!pyramid.empty()) {
+					//The circuit also sets bits past the width, which are never unpacked and must not be counted.
+					const Word kept = next_cells & Bits::width_mask(width - k * 64);
+					if (kept != cells) {
+						update_pyramid(j, k, cells, kept);
+					}
+				}
+				Bits::unpack_row(next_cells, next + j * width + k * 64, std::min(64, width - k * 64));
+			}
+		}
+		if (!pyramid.empty()) {
+			propagate_pyramid();
+		}
 	}
 	std::swap(current, future);
 }
@@ -12,20 +12,68 @@
 
 // Add the minimal number of includes you need in order to declare the class.
 // #include ...
+#include <utility>
+#include <vector>
 #include "grid.h"
+#include "rule.h"
+#include "jit.h"
+#include "bits.h"
 
 /**
  * Declare the structure of the World class for representing a 2d grid world.
  *
  * A World holds two equally sized Grid objects for the current state and next state.
  *      - These buffers should be swapped using std::swap after each update step.
+ *
+ * A World steps its cells with a Rule, Conway's B3/S23 unless another rule is set.
+ *      - The generic step packs rows into words and evaluates a circuit compiled from the rule, 64 cells at a time.
+ *      - Optionally a kernel specialised to the rule is compiled at runtime and used instead.
+ *      - Optionally square tiles of cells follow rules of their own, given by a rule map.
+ *      - Optionally cells can be forced dead, as walls, or forced alive, as sources, by masks.
+ *      - Optionally a pyramid of block populations is kept up to date as the world steps, for zoomed out views.
  */
 class World {
+public:
+	/**
+	 * A Level of the population pyramid counts the alive cells in each block of block x block cells,
+	 * across x down blocks in row major order. Blocks on the right and bottom edges may be partial.
+	 */
+	struct Level {
+		int block { }, across { }, down { };
+		std::vector<int> counts;
+	};
+	//The edge of the blocks of the finest level of the pyramid, each level up doubles it.
+	static const int PYRAMID_BLOCK = 8;
+private:
 	// How to draw an owl:
 	//      Step 1. Draw a circle.
 	//      Step 2. Draw the rest of the owl.
 	Grid current, future;
-	int count_neighbours(int x, int y, bool toroidal);
+	Rule rule;
+	Bits::Plane packed;
+	StepKernel kernel { };
+	//circuits[0] is compiled from the rule, then one circuit per rule of the rule map.
+	std::vector<Bits::Circuit> circuits;
+	std::vector<Rule> map_rules;
+	//The rule of each tile as an index into circuits, or empty if every cell follows the rule.
+	std::vector<int> rule_map;
+	int tiles_across { }, tiles_down { }, tile_size { };
+	//For each row of tiles and word of a row, the circuits covering the word and the cells each covers.
+	std::vector<std::vector<std::pair<int, Word>>> segments;
+	int segments_width { -1 }, segments_height { -1 };
+	//Cells forced dead and then forced alive after every step, empty if not set.
+	Bits::Plane force_dead, force_alive;
+	//The population pyramid, finest level first, or empty if not kept.
+	std::vector<Level> pyramid;
+	//The change in population of each block of the finest level this step, and the blocks that changed.
+	std::vector<int> pending;
+	std::vector<int> changed;
+	int get_rule_index(int x, int y) const;
+	void set_mask(Bits::Plane &mask, GridView cells, Cell forced);
+	void build_segments();
+	void build_pyramid();
+	void update_pyramid(int y, int k, Word before, Word after);
+	void propagate_pyramid();
 public:
 	World();
 	~World();
@@ -38,8 +86,23 @@ public:
 	int get_alive_cells() const;
 	int get_dead_cells() const;
 	Grid get_state() const;
+	GridView get_view() const;
+	void set_state(GridView state);
 	void resize(int square_size);
 	void resize(int new_width, int new_height);
+	const Rule& get_rule() const;
+	void set_rule(const Rule &new_rule, bool specialise = false);
+	void set_rule_map(const std::vector<Rule> &rules, const std::vector<int> &map, int across, int size);
+	bool has_rule_map() const;
+	void set_force_dead(GridView mask);
+	void set_force_alive(GridView mask);
+	void clear_masks();
+	const Rule& get_rule(int x, int y) const;
+	bool is_specialised() const;
+	void set_pyramid(bool enabled);
+	bool has_pyramid() const;
+	int get_pyramid_levels() const;
+	const Level& get_pyramid_level(int level) const;
 	void step(bool toroidal = false);
 	void advance(int steps, bool toroidal = false);
 };
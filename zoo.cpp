@@ -9,6 +9,10 @@
  *              - followed by (height) number of lines, each containing (width) number of characters,
  *                terminated by a newline character.
  *              - (space) ' ' is Cell::DEAD, (hash) '#' is Cell::ALIVE.
+ *          - Ascii files may be gzip compressed, as .gol.gz archives are.
+ *              - Compressed files are recognised by their magic number and inflated as they are read,
+ *                straight into the rows of the grid, without a decompressed copy on disc or in memory.
+ *              - Saving to a path ending in .gz compresses the file as it is written.
  *
  *      - Grids can be loaded from and saved to an binary file format.
  *          - Binary files are composed of:
@@ -18,6 +22,30 @@
  *                padded with zero or more 0 bits.
  *              - a 0 bit should be considered Cell::DEAD, a 1 bit should be considered Cell::ALIVE.
  *
+ *      - Grids can be loaded from and saved to NumPy .npy files, so they can be read with numpy.load.
+ *          - Npy files are composed of:
+ *              - the magic string "\x93NUMPY", the version 1.0, and a 2 byte little endian header length.
+ *              - a header holding a python dict literal with the dtype '|u1', C order, and the shape, padded
+ *                with spaces so the data starts at a multiple of 64 bytes and can be memory mapped.
+ *              - followed by the array data in C order.
+ *          - Unpacked arrays have the shape (height, width), with one byte per cell, 0 is Cell::DEAD
+ *            and anything else is Cell::ALIVE.
+ *          - Packed arrays have the shape (height, (width + 7) / 8), with the bits of each row packed
+ *            most significant bit first as numpy.packbits does, so numpy.unpackbits(array, axis=1, count=width)
+ *            restores the cells. The width is not stored, so it must be given when loading.
+ *          - Both are read and written a row at a time, so large grids are never buffered whole.
+ *
+ *      - Grids can be loaded from Netpbm bitmap (.pbm) and greymap (.pgm) images, so seeds can be drawn.
+ *          - Images are composed of:
+ *              - a magic number, P1 or P4 for bitmaps and P2 or P5 for greymaps.
+ *              - the width and height, and the maximum grey value for greymaps, separated by whitespace
+ *                and '#' comments running to the end of the line.
+ *              - followed by the pixels in row major order, as ascii numbers for P1 and P2, as rows packed
+ *                8 pixels per byte most significant bit first for P4, and as 1 or 2 byte big endian values for P5.
+ *          - A 1 (black) pixel in a bitmap is Cell::ALIVE, a 0 (white) pixel is Cell::DEAD.
+ *          - A grey pixel darker than the threshold is Cell::ALIVE, otherwise it is Cell::DEAD.
+ *          - Binary images are read a row at a time straight into the storage of the grid.
+ *
  * @author 964379
  * @date March, 2020
  */
@@ -25,6 +53,168 @@
 #include <fstream>
 // Include the minimal number of headers needed to support your implementation.
 // #include ...
+#include <cctype>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <vector>
+#include "gzip.h"
+
+namespace {
+
+//The magic string every .npy file starts with.
+const char NPY_MAGIC[] = "\x93NUMPY";
+//The length of the magic string, version, and header length fields.
+const int NPY_PREAMBLE = 10;
+//The alignment of the array data, so it can be memory mapped.
+const int NPY_ALIGNMENT = 64;
+
+/**
+ * Private helper to find the value after a key in a .npy header dict, e.g. find_key(header, "'shape'").
+ */
+std::string find_key(const std::string &header, const std::string &key) {
+	std::size_t start = header.find(key);
+	if (start == std::string::npos || (start = header.find(':', start)) == std::string::npos) {
+		throw std::runtime_error("The npy header is missing the key " + key + ".");
+	}
+	start = header.find_first_not_of(' ', start + 1);
+	//A value runs to the end of its tuple, or to the next key or the end of the dict.
+	std::size_t end = start == std::string::npos ? start
+			: header[start] == '(' ? header.find(')', start) : header.find_first_of(",}", start);
+	if (end == std::string::npos) {
+		throw std::runtime_error("The npy header is missing the key " + key + ".");
+	}
+	if (header[start] == '(') {
+		end++;
+	}
+	return header.substr(start, end - start);
+}
+
+/**
+ * Private helper to read the next number of a Netpbm header or ascii raster, skipping whitespace and comments.
+ * Ascii bitmaps may run their pixels together, so digits can be read one at a time.
+ */
+int read_pnm_int(std::istream &stream, bool single_digit = false) {
+	int next;
+	while ((next = stream.peek()) != EOF && (std::isspace(next) || next == '#')) {
+		if (next == '#') {
+			stream.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+		} else {
+			stream.get();
+		}
+	}
+	if (next == EOF || !std::isdigit(next)) {
+		throw std::runtime_error(next == EOF ? "File ended unexpectedly." : "The image contains an invalid number.");
+	}
+	int value = 0;
+	do {
+		value = value * 10 + (stream.get() - '0');
+	} while (!single_digit && std::isdigit(stream.peek()) && value < 100000000);
+	return value;
+}
+
+/**
+ * Private helper to open a Netpbm image and read its header, leaving the stream at the first pixel.
+ *
+ * @return
+ *      Returns the digit of the magic number, e.g. 4 for a P4 image.
+ */
+int open_pnm(const std::string &path, std::ifstream &inFile, int &width, int &height, int &maximum,
+		const char *kinds) {
+	inFile.open(path.c_str(), std::ifstream::in | std::ifstream::binary);
+	if (!inFile) {
+		throw std::runtime_error("Unable to open the specified file.");
+	}
+	char magic[2] = { };
+	inFile.read(magic, 2);
+	if (magic[0] != 'P' || std::strchr(kinds, magic[1]) == nullptr || magic[1] == '\0') {
+		throw std::runtime_error("The file is not a supported Netpbm image.");
+	}
+	width = read_pnm_int(inFile);
+	height = read_pnm_int(inFile);
+	maximum = (magic[1] == '2' || magic[1] == '5') ? read_pnm_int(inFile) : 1;
+	if (maximum < 1 || maximum > 65535) {
+		throw std::runtime_error("The image has an invalid maximum grey value.");
+	}
+	//Binary rasters start after exactly one whitespace character.
+	if (magic[1] == '4' || magic[1] == '5') {
+		if (!std::isspace(inFile.get())) {
+			throw std::runtime_error("The image header is malformed.");
+		}
+	}
+	return magic[1] - '0';
+}
+
+/**
+ * reshape(grid, width, height)
+ *
+ * Private helper to make a grid width x height and all dead, reusing its storage rather than reallocating it.
+ */
+void reshape(Grid &grid, int width, int height) {
+	//Every row of the view is the same row of dead cells.
+	const std::vector<Cell> dead(width, Cell::DEAD);
+	grid.assign(GridView(dead.data(), 0, 0, width, height));
+}
+
+/**
+ * read_ascii(inFile, gridReturned)
+ *
+ * Private helper to parse an ascii grid from a stream, a whole row at a time straight into the grid.
+ */
+void read_ascii(std::istream &inFile, Grid &gridReturned) {
+	int width, height;
+	//Read directly the width and height.
+	inFile >> width >> height;
+	if (!inFile || width < 0 || height < 0) {
+		throw std::runtime_error(
+				"The parsed width or height is not a positive integer.");
+	}
+	char x;
+	//Read the newline character between height and grid.
+	inFile.get(x);
+	reshape(gridReturned, width, height);
+	for (int i = 0; i < height; i++) {
+		char *row = reinterpret_cast<char*>(gridReturned.data()) + (std::size_t) i * width;
+		inFile.read(row, width);
+		if (inFile.gcount() == width) {
+			for (int j = 0; j < width; j++) {
+				if (row[j] != ' ' && row[j] != '#') {
+					throw std::runtime_error(
+							"The character for a cell is not the ALIVE or DEAD character.");
+				}
+			}
+		}
+		inFile.get(x);
+		if (inFile && x != '\n') {
+			throw std::runtime_error(
+					"Newline characters are not found when expected during parsing.");
+		}
+	}
+	//If errors occured.
+	if (!inFile.good()) {
+		if (inFile.eof()) {
+			throw std::runtime_error("File ended unexpectedly.");
+		} else {
+			throw std::runtime_error("An error occured.");
+		}
+	}
+}
+
+/**
+ * write_ascii(outFile, grid)
+ *
+ * Private helper to write a grid to a stream in the ascii format.
+ */
+void write_ascii(std::ostream &outFile, GridView grid) {
+	outFile << grid.get_width() << ' ' << grid.get_height() << '\n';
+	//Cells are stored as their ascii characters, so whole rows can be written at once.
+	for (int i = 0; i < grid.get_height(); i++) {
+		outFile.write(reinterpret_cast<const char*>(grid.row(i)), grid.get_width());
+		outFile << '\n';
+	}
+}
+
+}
 
 /**
  * Zoo::glider()
@@ -126,12 +316,16 @@ Grid Zoo::light_weight_spaceship() {
  *
  * Load an ascii file and parse it as a grid of cells.
  * Should be implemented using std::ifstream.
+ * Gzip compressed files are inflated as they are parsed, whatever their name.
  *
  * @example
  *
  *      // Load an ascii file from a directory
  *      Grid grid = Zoo::load_ascii("path/to/file.gol");
  *
+ *      // Load a compressed ascii file just the same
+ *      Grid archived = Zoo::load_ascii("path/to/file.gol.gz");
+ *
  * @param path
  *      The std::string path to the file to read in.
  *
@@ -144,50 +338,47 @@ Grid Zoo::light_weight_spaceship() {
  *          - The parsed width or height is not a positive integer.
  *          - Newline characters are not found when expected during parsing.
  *          - The character for a cell is not the ALIVE or DEAD character.
+ *          - The file is gzip compressed and the compressed data is corrupt.
  */
 Grid Zoo::load_ascii(std::string path) {
-	//Convert path from string to char* to satisfy the constructor of ifstream.
-	char *pathChar = const_cast<char*>(path.c_str());
-	std::ifstream inFile(pathChar, std::ifstream::in);
+	Grid grid;
+	load_ascii(path, grid);
+	return grid;
+}
+
+/**
+ * Zoo::load_ascii(path, grid)
+ *
+ * Load an ascii file into an existing grid, reusing its storage whenever it is large enough.
+ * Lets long running callers load many files into one grid without reallocating.
+ *
+ * @example
+ *
+ *      // Load every file into the same grid
+ *      Grid grid;
+ *      Zoo::load_ascii("path/to/first.gol", grid);
+ *      Zoo::load_ascii("path/to/second.gol", grid);
+ *
+ * @param path
+ *      The std::string path to the file to read in.
+ *
+ * @param grid
+ *      The grid to parse the file into. Its contents are unspecified if loading throws.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class on the same errors as Zoo::load_ascii(path).
+ */
+void Zoo::load_ascii(std::string path, Grid &grid) {
+	std::ifstream inFile(path.c_str(), std::ifstream::in | std::ifstream::binary);
 	if (!inFile) {
 		throw std::runtime_error("Unable to open the specified file.");
 	}
-	int width, height;
-	//Read directly the width and height.
-	inFile >> width >> height;
-	if (width < 0 || height < 0) {
-		throw std::runtime_error(
-				"The parsed width or height is not a positive integer.");
+	if (Gzip::is_gzip(inFile)) {
+		Gzip::InflateStream inflated(inFile);
+		read_ascii(inflated, grid);
+	} else {
+		read_ascii(inFile, grid);
 	}
-	char x;
-	//Read the newline character between height and grid.
-	inFile.get(x);
-	Grid gridReturned(width, height);
-	for (int i = 0; i < height; i++) {
-		for (int j = 0; j < width; j++) {
-			inFile.get(x);
-			if (x != ' ' && x != '#') {
-				throw std::runtime_error(
-						"The character for a cell is not the ALIVE or DEAD character.");
-			}
-			gridReturned.set(j, i, (Cell) x);
-		}
-		inFile.get(x);
-		if (x != '\n') {
-			throw std::runtime_error(
-					"Newline characters are not found when expected during parsing.");
-		}
-	}
-	//If errors occured.
-	if (!inFile.good()) {
-		if (inFile.eof()) {
-			throw std::runtime_error("File ended unexpectedly.");
-		} else {
-			throw std::runtime_error("An error occured.");
-		}
-	}
-	inFile.close();
-	return gridReturned;
 }
 
 /**
@@ -195,6 +386,7 @@ Grid Zoo::load_ascii(std::string path) {
  *
  * Save a grid as an ascii .gol file according to the specified file format.
  * Should be implemented using std::ofstream.
+ * If the path ends in .gz the file is gzip compressed as it is written.
  *
  * @example
  *
@@ -213,26 +405,27 @@ Grid Zoo::load_ascii(std::string path) {
  *      The std::string path to the file to write to.
  *
  * @param grid
- *      The grid to be written out to file.
+ *      The grid, or a view onto a region of a grid, to be written out to file.
  *
  * @throws
- *      Throws std::runtime_error or sub-class if the file cannot be opened.
+ *      Throws std::runtime_error or sub-class if the file cannot be opened or written.
  */
-void Zoo::save_ascii(std::string path, Grid grid) {
-	//Convert path from string to char* to satisfy the constructor of ifstream.
-	char *pathChar = const_cast<char*>(path.c_str());
-	std::ofstream outFile(pathChar, std::ofstream::out);
+void Zoo::save_ascii(std::string path, GridView grid) {
+	std::ofstream outFile(path.c_str(), std::ofstream::out | std::ofstream::binary);
 	if (!outFile) {
 		throw std::runtime_error("Unable to open the specified file.");
 	}
-	outFile << grid.get_width() << ' ' << grid.get_height() << '\n';
-	for (int i = 0; i < grid.get_height(); i++) {
-		for (int j = 0; j < grid.get_width(); j++) {
-			outFile << (char) grid(j, i);
-		}
-		outFile << '\n';
+	if (path.size() > 3 && path.compare(path.size() - 3, 3, ".gz") == 0) {
+		Gzip::DeflateStream deflated(outFile);
+		write_ascii(deflated, grid);
+		deflated.finish();
+	} else {
+		write_ascii(outFile, grid);
 	}
 	outFile.close();
+	if (!outFile) {
+		throw std::runtime_error("Unable to write the specified file.");
+	}
 }
 
 /**
@@ -258,6 +451,33 @@ void Zoo::save_ascii(std::string path, Grid grid) {
  *          - The file ends unexpectedly.
  */
 Grid Zoo::load_binary(std::string path) {
+	Grid grid;
+	load_binary(path, grid);
+	return grid;
+}
+
+/**
+ * Zoo::load_binary(path, grid)
+ *
+ * Load a binary file into an existing grid, reusing its storage whenever it is large enough.
+ *
+ * @example
+ *
+ *      // Load every file into the same grid
+ *      Grid grid;
+ *      Zoo::load_binary("path/to/first.bgol", grid);
+ *      Zoo::load_binary("path/to/second.bgol", grid);
+ *
+ * @param path
+ *      The std::string path to the file to read in.
+ *
+ * @param grid
+ *      The grid to parse the file into. Its contents are unspecified if loading throws.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class on the same errors as Zoo::load_binary(path).
+ */
+void Zoo::load_binary(std::string path, Grid &grid) {
 	//Convert path from string to char* to satisfy the constructor of ifstream.
 	char *pathChar = const_cast<char*>(path.c_str());
 	std::ifstream inFile(pathChar, std::ifstream::in | std::ifstream::binary);
@@ -271,7 +491,7 @@ Grid Zoo::load_binary(std::string path) {
 	inFile.read((char*) &realHeight, sizeof(int));
 	//Read byte by byte.
 	char buffer[1];
-	Grid gridReturned(realWidth, realHeight);
+	reshape(grid, realWidth, realHeight);
 	int column = 0, row = 0;
 	//Depending on the size of the matrix read enough bytes to complete the grid.
 	for (int k = 0; k < realWidth * realHeight / 8 + 1; k++) {
@@ -284,7 +504,7 @@ Grid Zoo::load_binary(std::string path) {
 				i++) {
 			//Get the bits out of the byte by using shifting and AND on bits operations.
 			if (((buffer[0] >> i) & 1) == 1) {
-				gridReturned.set(column, row, Cell::ALIVE);
+				grid.set(column, row, Cell::ALIVE);
 			}
 			//Logic to assign the correct cell value in the grid at correct column,row.
 			if (column + 1 == realWidth) {
@@ -305,7 +525,6 @@ Grid Zoo::load_binary(std::string path) {
 		}
 	}
 	inFile.close();
-	return gridReturned;
 }
 
 /**
@@ -331,12 +550,12 @@ Grid Zoo::load_binary(std::string path) {
  *      The std::string path to the file to write to.
  *
  * @param grid
- *      The grid to be written out to file.
+ *      The grid, or a view onto a region of a grid, to be written out to file.
  *
  * @throws
  *      Throws std::runtime_error or sub-class if the file cannot be opened.
  */
-void Zoo::save_binary(std::string path, Grid grid) {
+void Zoo::save_binary(std::string path, GridView grid) {
 	//Convert path from string to char* to satisfy the constructor of ifstream.
 	char *pathChar = const_cast<char*>(path.c_str());
 	std::ofstream outFile(pathChar, std::ofstream::out | std::ofstream::binary);
@@ -349,7 +568,7 @@ void Zoo::save_binary(std::string path, Grid grid) {
 	outFile.write((char*) &realWidth, sizeof(int));
 	outFile.write((char*) &realHeight, sizeof(int));
 	//Write byte by byte.
-	char buffer[1];
+	char buffer[1] = { 0 };
 	int column = 0, row = 0;
 	//Depending on the size of the matrix write enough bytes to complete the grid.
 	for (int k = 0; k < realWidth * realHeight / 8 + 1; k++) {
@@ -380,3 +599,262 @@ void Zoo::save_binary(std::string path, Grid grid) {
 	}
 	outFile.close();
 }
+
+/**
+ * Zoo::load_npy(path, width)
+ *
+ * Load a 2 dimensional NumPy .npy file of unsigned bytes, either one byte per cell or packed 8 cells per byte.
+ * Rows are read straight into the storage of the grid.
+ *
+ * @example
+ *
+ *      // Load an unpacked array saved with numpy.save("file.npy", cells.astype(numpy.uint8))
+ *      Grid grid = Zoo::load_npy("path/to/file.npy");
+ *
+ *      // Load a 100 cell wide array saved with numpy.save("packed.npy", numpy.packbits(cells, axis=1))
+ *      Grid packed = Zoo::load_npy("path/to/packed.npy", 100);
+ *
+ * @param path
+ *      The std::string path to the file to read in.
+ *
+ * @param width
+ *      Optional parameter. If 0 the array is one byte per cell. Otherwise the array is packed and this is
+ *      the width of the grid, which must need exactly the number of bytes in each row. Defaults to 0.
+ *
+ * @return
+ *      Returns the parsed grid.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class if:
+ *          - The file cannot be opened.
+ *          - The file is not a version 1.0 .npy file of a 2 dimensional C order array of bytes.
+ *          - The width does not match the packed rows.
+ *          - The file ends unexpectedly.
+ */
+Grid Zoo::load_npy(std::string path, int width) {
+	std::ifstream inFile(path.c_str(), std::ifstream::in | std::ifstream::binary);
+	if (!inFile) {
+		throw std::runtime_error("Unable to open the specified file.");
+	}
+	unsigned char preamble[NPY_PREAMBLE];
+	if (!inFile.read(reinterpret_cast<char*>(preamble), NPY_PREAMBLE)
+			|| std::memcmp(preamble, NPY_MAGIC, 6) != 0 || preamble[6] != 1) {
+		throw std::runtime_error("The file is not a version 1.0 npy file.");
+	}
+	std::string header(preamble[8] | (preamble[9] << 8), ' ');
+	if (!inFile.read(&header[0], header.size())) {
+		throw std::runtime_error("File ended unexpectedly.");
+	}
+	const std::string descr = find_key(header, "'descr'");
+	if ((descr != "'|u1'" && descr != "'<u1'" && descr != "'|b1'") || find_key(header, "'fortran_order'") != "False") {
+		throw std::runtime_error("The npy array must be C order unsigned bytes.");
+	}
+	int rows = 0, columns = 0;
+	char open, comma, close;
+	std::istringstream shape(find_key(header, "'shape'"));
+	if (!(shape >> open >> rows >> comma >> columns >> close) || close != ')' || rows < 0 || columns < 0) {
+		throw std::runtime_error("The npy array must be 2 dimensional.");
+	}
+	if (width != 0 && (width < 0 || (width + 7) / 8 != columns)) {
+		throw std::runtime_error("The width does not match the packed rows of the npy array.");
+	}
+	Grid gridReturned(width == 0 ? columns : width, rows);
+	std::vector<unsigned char> packed(width == 0 ? 0 : columns);
+	for (int y = 0; y < rows; y++) {
+		Cell *row = gridReturned.data() + y * gridReturned.get_width();
+		if (width == 0) {
+			//Read the bytes straight into the row, then turn each byte into a cell in place.
+			inFile.read(reinterpret_cast<char*>(row), columns);
+			for (int x = 0; x < columns; x++) {
+				row[x] = reinterpret_cast<unsigned char&>(row[x]) != 0 ? Cell::ALIVE : Cell::DEAD;
+			}
+		} else {
+			inFile.read(reinterpret_cast<char*>(packed.data()), columns);
+			for (int x = 0; x < width; x++) {
+				row[x] = (packed[x >> 3] >> (7 - (x & 7))) & 1 ? Cell::ALIVE : Cell::DEAD;
+			}
+		}
+		if (!inFile) {
+			throw std::runtime_error("File ended unexpectedly.");
+		}
+	}
+	inFile.close();
+	return gridReturned;
+}
+
+/**
+ * Zoo::save_npy(path, grid, packed)
+ *
+ * Save a grid as a 2 dimensional NumPy .npy file of unsigned bytes, written a row at a time.
+ * The data is 64 byte aligned, so the file can be opened with numpy.load(path, mmap_mode='r').
+ *
+ * @example
+ *
+ *      // Save a grid with one byte per cell, 0 for dead and 1 for alive
+ *      Zoo::save_npy("path/to/file.npy", grid);
+ *
+ *      // Save a grid packed 8 cells per byte, unpack it with numpy.unpackbits(array, axis=1, count=width)
+ *      Zoo::save_npy("path/to/packed.npy", grid, true);
+ *
+ * @param path
+ *      The std::string path to the file to write to.
+ *
+ * @param grid
+ *      The grid, or a view onto a region of a grid, to be written out to file.
+ *
+ * @param packed
+ *      Optional parameter. If true then pack 8 cells into each byte. Defaults to false.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class if the file cannot be opened or written.
+ */
+void Zoo::save_npy(std::string path, GridView grid, bool packed) {
+	std::ofstream outFile(path.c_str(), std::ofstream::out | std::ofstream::binary);
+	if (!outFile) {
+		throw std::runtime_error("Unable to open the specified file.");
+	}
+	const int width = grid.get_width(), height = grid.get_height();
+	const int columns = packed ? (width + 7) / 8 : width;
+	std::ostringstream dict;
+	dict << "{'descr': '|u1', 'fortran_order': False, 'shape': (" << height << ", " << columns << "), }";
+	//Pad the header with spaces and a newline so the data starts on an aligned offset.
+	std::string header = dict.str();
+	const int total = NPY_PREAMBLE + header.size() + 1;
+	header.append((NPY_ALIGNMENT - total % NPY_ALIGNMENT) % NPY_ALIGNMENT, ' ');
+	header += '\n';
+	outFile.write(NPY_MAGIC, 6);
+	const char version_and_length[4] = { 1, 0, static_cast<char>(header.size() & 0xff),
+			static_cast<char>(header.size() >> 8) };
+	outFile.write(version_and_length, 4);
+	outFile << header;
+
+	std::vector<unsigned char> buffer(columns);
+	for (int y = 0; y < height; y++) {
+		const Cell *row = grid.row(y);
+		if (packed) {
+			std::fill(buffer.begin(), buffer.end(), 0);
+			for (int x = 0; x < width; x++) {
+				buffer[x >> 3] |= (row[x] == Cell::ALIVE) << (7 - (x & 7));
+			}
+		} else {
+			for (int x = 0; x < width; x++) {
+				buffer[x] = row[x] == Cell::ALIVE;
+			}
+		}
+		outFile.write(reinterpret_cast<const char*>(buffer.data()), columns);
+	}
+	if (!outFile) {
+		throw std::runtime_error("Unable to write the specified file.");
+	}
+	outFile.close();
+}
+
+/**
+ * Zoo::load_pbm(path)
+ *
+ * Load a Netpbm bitmap, either ascii (P1) or packed binary (P4), with black pixels as alive cells.
+ *
+ * @example
+ *
+ *      // Load a seed drawn in an image editor and exported as a bitmap
+ *      Grid grid = Zoo::load_pbm("path/to/seed.pbm");
+ *
+ * @param path
+ *      The std::string path to the file to read in.
+ *
+ * @return
+ *      Returns the parsed grid.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class if:
+ *          - The file cannot be opened.
+ *          - The file is not a P1 or P4 image, or its header is malformed.
+ *          - The file ends unexpectedly.
+ */
+Grid Zoo::load_pbm(std::string path) {
+	std::ifstream inFile;
+	int width, height, maximum;
+	const int kind = open_pnm(path, inFile, width, height, maximum, "14");
+	Grid gridReturned(width, height);
+	std::vector<unsigned char> packed((width + 7) / 8);
+	for (int y = 0; y < height; y++) {
+		Cell *row = gridReturned.data() + y * width;
+		if (kind == 4) {
+			if (!inFile.read(reinterpret_cast<char*>(packed.data()), packed.size())) {
+				throw std::runtime_error("File ended unexpectedly.");
+			}
+			for (int x = 0; x < width; x++) {
+				row[x] = (packed[x >> 3] >> (7 - (x & 7))) & 1 ? Cell::ALIVE : Cell::DEAD;
+			}
+		} else {
+			for (int x = 0; x < width; x++) {
+				const int pixel = read_pnm_int(inFile, true);
+				if (pixel > 1) {
+					throw std::runtime_error("The image contains an invalid pixel.");
+				}
+				row[x] = pixel == 1 ? Cell::ALIVE : Cell::DEAD;
+			}
+		}
+	}
+	inFile.close();
+	return gridReturned;
+}
+
+/**
+ * Zoo::load_pgm(path, threshold)
+ *
+ * Load a Netpbm greymap, either ascii (P2) or binary (P5), with pixels darker than a threshold as alive cells.
+ *
+ * @example
+ *
+ *      // Load a photograph as a seed, with pixels darker than mid grey alive
+ *      Grid grid = Zoo::load_pgm("path/to/photo.pgm");
+ *
+ *      // Load only the darkest pixels of an 8 bit greymap
+ *      Grid dark = Zoo::load_pgm("path/to/photo.pgm", 32);
+ *
+ * @param path
+ *      The std::string path to the file to read in.
+ *
+ * @param threshold
+ *      Optional parameter. Pixels with a grey value below the threshold are alive. If negative then
+ *      half of the maximum grey value of the image, rounded up. Defaults to -1.
+ *
+ * @return
+ *      Returns the parsed grid.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class if:
+ *          - The file cannot be opened.
+ *          - The file is not a P2 or P5 image, or its header is malformed.
+ *          - The file ends unexpectedly.
+ */
+Grid Zoo::load_pgm(std::string path, int threshold) {
+	std::ifstream inFile;
+	int width, height, maximum;
+	const int kind = open_pnm(path, inFile, width, height, maximum, "25");
+	if (threshold < 0) {
+		threshold = (maximum + 1) / 2;
+	}
+	const int bytes = maximum < 256 ? 1 : 2;
+	Grid gridReturned(width, height);
+	std::vector<unsigned char> buffer(width * bytes);
+	for (int y = 0; y < height; y++) {
+		Cell *row = gridReturned.data() + y * width;
+		if (kind == 5) {
+			if (!inFile.read(reinterpret_cast<char*>(buffer.data()), buffer.size())) {
+				throw std::runtime_error("File ended unexpectedly.");
+			}
+			for (int x = 0; x < width; x++) {
+				const int grey = bytes == 1 ? buffer[x] : (buffer[2 * x] << 8 | buffer[2 * x + 1]);
+				row[x] = grey < threshold ? Cell::ALIVE : Cell::DEAD;
+			}
+		} else {
+			for (int x = 0; x < width; x++) {
+				row[x] = read_pnm_int(inFile) < threshold ? Cell::ALIVE : Cell::DEAD;
+			}
+		}
+	}
+	inFile.close();
+	return gridReturned;
+}
@@ -25,8 +25,14 @@ Grid glider();
 Grid r_pentomino();
 Grid light_weight_spaceship();
 Grid load_ascii(std::string path);
-void save_ascii(std::string path, Grid grid);
+void load_ascii(std::string path, Grid &grid);
+void save_ascii(std::string path, GridView grid);
 Grid load_binary(std::string path);
-void save_binary(std::string path, Grid grid);
+void load_binary(std::string path, Grid &grid);
+void save_binary(std::string path, GridView grid);
+Grid load_npy(std::string path, int width = 0);
+void save_npy(std::string path, GridView grid, bool packed = false);
+Grid load_pbm(std::string path);
+Grid load_pgm(std::string path, int threshold = -1);
 }
 ;